@@ -439,8 +439,9 @@ void AssetManager::makePrefab(const QString &source, const QFileInfo &target) {
         QString path = target.absoluteFilePath() + "/" + name + ".fab";
         QFile file(path);
         if(file.open(QIODevice::WriteOnly)) {
-            string str = Json::save(Engine::toVariant(actor), 0);
-            file.write(static_cast<const char *>(&str[0]), str.size());
+            Json::save(Engine::toVariant(actor), [&file](const char *data, uint32_t size) {
+                file.write(data, size);
+            }, 0);
             file.close();
 
             IConverterSettings *settings = fetchSettings(path);
@@ -619,8 +620,9 @@ void AssetManager::dumpBundle() {
 
     QFile file(m_pProjectManager->importPath() + "/" + gIndex);
     if(file.open(QIODevice::WriteOnly)) {
-        string data = Json::save(root, 0);
-        file.write(&data[0], data.size());
+        Json::save(root, [&file](const char *data, uint32_t size) {
+            file.write(data, size);
+        }, 0);
         file.close();
         Engine::reloadBundle();
     }
@@ -33,7 +33,7 @@
 #define HEADER  "Header"
 #define DATA    "Data"
 
-#define FORMAT_VERSION 3
+#define FORMAT_VERSION 4
 
 int32_t indexOf(const aiBone *item, const BonesList &list) {
     int i = 0;
@@ -65,6 +65,7 @@ AssimpImportSettings::AssimpImportSettings() :
         m_Scale(1.0f),
         m_Colors(true),
         m_Normals(true),
+        m_Quantize(true),
         m_Animation(true),
         m_Filter(Keyframe_Reduction),
         m_PositionError(0.5f),
@@ -95,6 +96,16 @@ void AssimpImportSettings::setNormals(bool value) {
     }
 }
 
+bool AssimpImportSettings::quantize() const {
+    return m_Quantize;
+}
+void AssimpImportSettings::setQuantize(bool value) {
+    if(m_Quantize != value) {
+        m_Quantize = value;
+        emit updated();
+    }
+}
+
 bool AssimpImportSettings::animation() const {
     return m_Animation;
 }
@@ -499,6 +510,7 @@ Mesh *AssimpConverter::importMesh(const aiScene *scene, const aiNode *element, A
         }
 
         mesh->addLod(&l);
+        mesh->pack(fbxSettings->quantize());
 
         return mesh;
     }
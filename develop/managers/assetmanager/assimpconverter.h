@@ -24,6 +24,7 @@ class AssimpImportSettings : public IConverterSettings {
     Q_PROPERTY(float Custom_Scale READ customScale WRITE setCustomScale DESIGNABLE true USER true)
     Q_PROPERTY(bool Import_Color READ colors WRITE setColors DESIGNABLE true USER true)
     Q_PROPERTY(bool Import_Normals READ normals WRITE setNormals DESIGNABLE true USER true)
+    Q_PROPERTY(bool Quantize_Vertices READ quantize WRITE setQuantize DESIGNABLE true USER true)
 
     Q_PROPERTY(bool Import_Animation READ animation WRITE setAnimation DESIGNABLE true USER true)
     Q_PROPERTY(Compression Compress_Animation READ filter WRITE setFilter DESIGNABLE true USER true)
@@ -47,6 +48,9 @@ public:
     bool normals() const;
     void setNormals(bool value);
 
+    bool quantize() const;
+    void setQuantize(bool value);
+
     bool animation() const;
     void setAnimation(bool value);
 
@@ -87,6 +91,7 @@ protected:
 
     bool m_Colors;
     bool m_Normals;
+    bool m_Quantize;
 
     bool m_Animation;
     Compression m_Filter;
@@ -2,12 +2,12 @@
 
 #include <QFile>
 
-#include <bson.h>
 #include <json.h>
+#include <objectpack.h>
 #include <map.h>
 #include <components/actor.h>
 
-#define FORMAT_VERSION 2
+#define FORMAT_VERSION 3
 
 MapConverterSettings::MapConverterSettings() {
     setType(MetaType::type<Actor *>());
@@ -29,7 +29,7 @@ uint8_t MapConverter::convertFile(IConverterSettings *settings) {
 
         QFile file(settings->absoluteDestination());
         if(file.open(QIODevice::WriteOnly)) {
-            ByteArray data = Bson::save(actor);
+            ByteArray data = ObjectPack::save(actor);
             file.write((const char *)&data[0], data.size());
             file.close();
 
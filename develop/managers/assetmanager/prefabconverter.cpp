@@ -5,10 +5,10 @@
 #include <QFile>
 #include <QDebug>
 
-#include <bson.h>
 #include <json.h>
+#include <objectpack.h>
 
-#define FORMAT_VERSION 2
+#define FORMAT_VERSION 3
 
 PrefabConverterSettings::PrefabConverterSettings() {
     setType(MetaType::type<Prefab *>());
@@ -42,7 +42,7 @@ uint8_t PrefabConverter::convertFile(IConverterSettings *settings) {
 
         QFile file(settings->absoluteDestination());
         if(file.open(QIODevice::WriteOnly)) {
-            ByteArray data = Bson::save(actor);
+            ByteArray data = ObjectPack::save(actor);
             file.write((const char *)&data[0], data.size());
             file.close();
 
@@ -89,7 +89,7 @@ void PrefabConverter::injectResource(Variant &origin, Resource *resource) {
     i++; // parent
     *i = resource->uuid();
 
-    objects.push_front(Engine::toVariant(resource).toList().front());
+    objects.insert(objects.begin(), Engine::toVariant(resource).toList().front());
 }
 
 void PrefabConverter::toVersion1(Variant &variant) {
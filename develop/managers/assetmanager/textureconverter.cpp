@@ -16,7 +16,7 @@
 #include <resources/resource.h>
 #include <resources/material.h>
 
-#define FORMAT_VERSION 3
+#define FORMAT_VERSION 4
 
 static hash<string> hash_str;
 
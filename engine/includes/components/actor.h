@@ -42,6 +42,15 @@ public:
     Component *component(const string type);
     Component *componentInChild(const string type);
 
+    Component *findComponent(uint32_t type) const;
+
+    template<typename T>
+    T *findComponent() const {
+        return static_cast<T *>(findComponent(T::metaClass()->typeId()));
+    }
+
+    const vector<Component *> &components() const;
+
     Component *addComponent(const string type);
 
     bool isEnabled() const;
@@ -62,6 +71,7 @@ public:
     void setPrefab(Prefab *prefab);
 
     Object *clone(Object *parent = nullptr) override;
+    ObjectList cloneBatch(uint32_t count, Object *parent = nullptr) override;
 
 private:
     void loadObjectData(const VariantMap &data) override;
@@ -74,9 +84,15 @@ private:
 
     void setHierarchyEnabled(bool enabled);
 
+    void setScene(Scene *scene);
+
+    void addChild(Object *child, int32_t position = -1) override;
+    void removeChild(Object *child) override;
+
 private:
     friend class ActorPrivate;
     friend class ActorTest;
+    friend class Scene;
 
     ActorPrivate *p_ptr;
 
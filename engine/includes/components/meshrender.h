@@ -29,6 +29,8 @@ public:
 private:
     AABBox bound() const override;
 
+    void fillSnapshot(RenderSnapshot &snapshot) const override;
+
     void draw(CommandBuffer &buffer, uint32_t layer) override;
 
     void loadUserData(const VariantMap &data) override;
@@ -11,11 +11,25 @@ class NEXT_LIBRARY_EXPORT NativeBehaviour : public Component {
 
 public:
     NativeBehaviour();
+    ~NativeBehaviour() override;
 
     virtual void start();
 
     virtual void update();
 
+    virtual void lateUpdate();
+
+    virtual void fixedUpdate();
+
+    virtual bool isParallelSafe() const;
+
+    void setEnabled(bool enable) override;
+
+private:
+    friend class EnginePrivate;
+
+    int32_t m_Index;
+
 };
 
 #endif // NATIVEBEHAVIOUR_H
@@ -48,6 +48,8 @@ private:
 
     bool isPostProcessVolume() const override;
 
+    uint32_t registryType() const override;
+
 #ifdef NEXT_SHARED
     bool drawHandles(ObjectList &selected) override;
 #endif
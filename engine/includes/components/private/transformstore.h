@@ -0,0 +1,84 @@
+#ifndef TRANSFORMSTORE_H
+#define TRANSFORMSTORE_H
+
+#include <list>
+#include <mutex>
+#include <atomic>
+
+#include <global.h>
+#include <amath.h>
+
+using namespace std;
+
+#define TRANSFORM_CHUNK 64
+
+class Transform;
+class ThreadPool;
+class TransformPrivate;
+
+struct TransformChunk {
+    mutex m_Mutex;
+
+    TransformPrivate *m_pOwner[TRANSFORM_CHUNK];
+    int32_t m_Parent[TRANSFORM_CHUNK];
+    atomic<uint8_t> m_Dirty[TRANSFORM_CHUNK];
+
+    Vector3 m_Position[TRANSFORM_CHUNK];
+    Vector3 m_Rotation[TRANSFORM_CHUNK];
+    Vector3 m_Scale[TRANSFORM_CHUNK];
+    Quaternion m_Quaternion[TRANSFORM_CHUNK];
+
+    Matrix4 m_Transform[TRANSFORM_CHUNK];
+    Matrix4 m_WorldTransform[TRANSFORM_CHUNK];
+
+    Vector3 m_WorldPosition[TRANSFORM_CHUNK];
+    Vector3 m_WorldRotation[TRANSFORM_CHUNK];
+    Vector3 m_WorldScale[TRANSFORM_CHUNK];
+    Quaternion m_WorldQuaternion[TRANSFORM_CHUNK];
+
+    Vector3 m_FixedPosition[2][TRANSFORM_CHUNK];
+    Quaternion m_FixedQuaternion[2][TRANSFORM_CHUNK];
+    Vector3 m_FixedScale[2][TRANSFORM_CHUNK];
+    uint8_t m_Fixed[TRANSFORM_CHUNK];
+};
+
+class TransformPrivate {
+public:
+    explicit TransformPrivate(Transform *transform);
+
+    Transform *m_pTransform;
+
+    Transform *m_pParent;
+
+    list<Transform *> m_Children;
+
+    TransformChunk *m_pChunk;
+
+    uint32_t m_Slot;
+
+    uint32_t m_Depth;
+
+    uint32_t m_Index;
+};
+
+class NEXT_LIBRARY_EXPORT TransformStore {
+public:
+    static void add(TransformPrivate *transform);
+
+    static void remove(TransformPrivate *transform);
+
+    static void setParent(TransformPrivate *transform, TransformPrivate *parent);
+
+    static void setDirty(TransformPrivate *transform);
+
+    static bool isDirty(const TransformPrivate *transform);
+
+    static void clean(TransformPrivate *transform);
+
+    static void update(ThreadPool *pool);
+
+    static void storeFixedStep();
+
+};
+
+#endif // TRANSFORMSTORE_H
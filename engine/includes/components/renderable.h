@@ -4,9 +4,26 @@
 #include "nativebehaviour.h"
 
 #include <amath.h>
+#include <framearena.h>
 
 class RenderablePrivate;
 class CommandBuffer;
+class Mesh;
+class MaterialInstance;
+
+struct RenderSnapshot {
+    Matrix4 m_Transform;
+
+    Vector3 m_Rotation;
+
+    AABBox m_Bound;
+
+    Mesh *m_pMesh;
+
+    MaterialInstance *m_pMaterial;
+
+    int32_t m_Layers;
+};
 
 class NEXT_LIBRARY_EXPORT Renderable : public NativeBehaviour {
     A_REGISTER(Renderable, NativeBehaviour, General)
@@ -27,11 +44,30 @@ public:
 
     virtual void composeComponent();
 
+    const RenderSnapshot &snapshot() const;
+
+    bool hasSnapshot() const;
+
+    void extractSnapshot();
+
+protected:
+    virtual void fillSnapshot(RenderSnapshot &snapshot) const;
+
 private:
     bool isRenderable() const override;
 
+    uint32_t registryType() const override;
+
+private:
+    RenderSnapshot m_Snapshots[2];
+
+    uint32_t m_Front;
+
+    bool m_Extracted;
+
 };
 
-typedef list<Renderable *> RenderList;
+typedef vector<Renderable *> RenderList;
+typedef FrameVector<Renderable *> RenderFrameList;
 
 #endif // RENDERABLE_H
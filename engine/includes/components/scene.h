@@ -7,6 +7,8 @@ class ScenePrivate;
 
 class PostProcessSettings;
 
+class Component;
+
 class NEXT_LIBRARY_EXPORT Scene : public Object {
     A_REGISTER(Scene, Object, General)
 
@@ -25,7 +27,16 @@ public:
 
     PostProcessSettings &finalPostProcessSettings();
 
+    const vector<Component *> &components(uint32_t type);
+
 private:
+    void addComponent(Component *component);
+    void removeComponent(Component *component);
+
+private:
+    friend class Actor;
+    friend class ActorPrivate;
+
     ScenePrivate *p_ptr;
 
 };
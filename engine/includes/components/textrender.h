@@ -71,6 +71,8 @@ public:
 private:
     void draw(CommandBuffer &buffer, uint32_t layer) override;
 
+    void fillSnapshot(RenderSnapshot &snapshot) const override;
+
     AABBox bound() const override;
 
 #ifdef NEXT_SHARED
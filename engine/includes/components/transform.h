@@ -52,6 +52,10 @@ public:
     Quaternion &worldQuaternion() const;
     Vector3 &worldScale() const;
 
+    Vector3 interpolatedPosition(float alpha) const;
+    Quaternion interpolatedQuaternion(float alpha) const;
+    Matrix4 interpolatedTransform(float alpha) const;
+
     void setParent(Object *parent, int32_t position = -1, bool force = false) override;
 
 protected:
@@ -61,7 +65,8 @@ private:
     void setDirty();
 
 private:
-    friend class TransformPrivate;
+    friend class TransformStore;
+    friend class TransformStorePrivate;
 
     TransformPrivate *p_ptr;
 
@@ -17,6 +17,8 @@ class Actor;
 class Scene;
 class System;
 class PlatformAdaptor;
+class ThreadPool;
+class NativeBehaviour;
 
 class NEXT_LIBRARY_EXPORT Engine : public ObjectSystem {
 public:
@@ -62,6 +64,8 @@ public:
 
     static System              *resourceSystem              ();
 
+    static ThreadPool          *threadPool                  ();
+
 /*
     Misc
 */
@@ -94,10 +98,16 @@ public:
     static Actor               *composeActor                (const string &component, const string &name, Object *parent = nullptr);
 
 private:
+    friend class NativeBehaviour;
+
     bool                        event                       (Event *event) override;
 
     void                        processEvents               () override;
 
+    static void                 addNativeBehaviour          (NativeBehaviour *behaviour);
+
+    static void                 removeNativeBehaviour       (NativeBehaviour *behaviour);
+
 private:
     EnginePrivate              *p_ptr;
 
@@ -10,6 +10,22 @@ class MeshPrivate;
 
 typedef vector<uint32_t> IndexVector;
 
+struct NEXT_LIBRARY_EXPORT VertexLayout {
+    VertexLayout(int flags, bool quantized);
+
+    uint32_t stride;
+
+    uint32_t normals;
+    uint32_t tangents;
+    uint32_t uv0;
+    uint32_t uv1;
+    uint32_t colors;
+    uint32_t weights;
+    uint32_t bones;
+
+    bool quantized;
+};
+
 class NEXT_LIBRARY_EXPORT Lod {
     A_PROPERTIES(
         A_PROPERTY(Material *, material, Lod::material, Lod::setMaterial)
@@ -25,53 +41,93 @@ public:
     void setMaterial(Material *material);
 
     IndexVector &indices();
+    const IndexVector &indices() const;
     void setIndices(const IndexVector &indices);
 
     Vector4Vector &colors();
+    const Vector4Vector &colors() const;
     void setColors(const Vector4Vector &colors);
 
     Vector4Vector &weights();
+    const Vector4Vector &weights() const;
     void setWeights(const Vector4Vector &weights);
 
     Vector4Vector &bones();
+    const Vector4Vector &bones() const;
     void setBones(const Vector4Vector &bones);
 
     Vector3Vector &vertices();
+    const Vector3Vector &vertices() const;
     void setVertices(const Vector3Vector &vertices);
 
     Vector3Vector &normals();
+    const Vector3Vector &normals() const;
     void setNormals(const Vector3Vector &normals);
 
     Vector3Vector &tangents();
+    const Vector3Vector &tangents() const;
     void setTangents(const Vector3Vector &tangents);
 
     Vector2Vector &uv0();
+    const Vector2Vector &uv0() const;
     void setUv0(const Vector2Vector &uv0);
 
     Vector2Vector &uv1();
+    const Vector2Vector &uv1() const;
     void setUv1(const Vector2Vector &uv1);
 
+    uint32_t vertexCount() const;
+    uint32_t indexCount() const;
+
+    bool isPacked() const;
+    bool isQuantized() const;
+
+    uint32_t indexSize() const;
+
+    const ByteBuffer &packedVertices() const;
+    const ByteBuffer &packedIndices() const;
+
+private:
+    void pack(int flags, bool quantize);
+    void unpack();
+    void decode() const;
+
 private:
     friend class Mesh;
 
 private:
-    Vector4Vector m_Colors;
+    // Separate attributes, for the packed Lod they are the decoded cache of streams
+    mutable Vector4Vector m_Colors;
+
+    mutable Vector4Vector m_Weights;
+
+    mutable Vector4Vector m_Bones;
+
+    mutable Vector3Vector m_Normals;
+
+    mutable Vector3Vector m_Tangents;
 
-    Vector4Vector m_Weights;
+    mutable Vector3Vector m_Vertices;
 
-    Vector4Vector m_Bones;
+    mutable Vector2Vector m_Uv0;
 
-    Vector3Vector m_Normals;
+    mutable Vector2Vector m_Uv1;
 
-    Vector3Vector m_Tangents;
+    mutable IndexVector m_Indices;
 
-    Vector3Vector m_Vertices;
+    ByteBuffer m_PackedVertices;
 
-    Vector2Vector m_Uv0;
+    ByteBuffer m_PackedIndices;
 
-    Vector2Vector m_Uv1;
+    uint32_t m_VertexCount;
 
-    IndexVector m_Indices;
+    uint32_t m_IndexCount;
+
+    int m_PackedFlags;
+
+    bool m_Quantized;
+
+    mutable bool m_Decoded;
 
     Material *m_Material;
 };
@@ -156,6 +212,9 @@ public:
 
     void batchMesh(Mesh *mesh, Matrix4 *transform = nullptr);
 
+    bool isPacked() const;
+    void pack(bool quantize);
+
     void recalcBounds();
 
     static void registerSuper(ObjectSystem *system);
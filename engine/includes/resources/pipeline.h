@@ -8,6 +8,8 @@
 
 #include "resource.h"
 
+#include "components/renderable.h"
+
 class RenderSystem;
 class CommandBuffer;
 
@@ -24,8 +26,6 @@ class PostProcessVolume;
 
 class AtlasNode;
 
-class Renderable;
-
 class NEXT_LIBRARY_EXPORT Pipeline : public Resource {
     A_REGISTER(Pipeline, Resource, Resources)
 
@@ -59,16 +59,16 @@ public:
 protected:
     void cameraReset(Camera &camera);
 
-    void drawComponents(uint32_t layer, list<Renderable *> &list);
+    void drawComponents(uint32_t layer, const RenderList &list);
 
     void postProcess(RenderTarget *source, uint32_t layer);
 
-    void sortByDistance(list<Renderable *> &in, const Vector3 &origin);
+    void sortByDistance(RenderList &in, const Vector3 &origin);
 
     void cleanShadowCache();
     void updateShadows(Camera &camera);
 
-    void combineComponents(Object *object, bool update);
+    void combineComponents(Scene *scene, bool update);
 
 protected:
     typedef map<string, Texture *> BuffersMap;
@@ -76,12 +76,12 @@ protected:
 
     CommandBuffer *m_Buffer;
 
-    list<Renderable *> m_SceneComponents;
-    list<Renderable *> m_SceneLights;
-    list<Renderable *> m_UiComponents;
-    list<Renderable *> m_Filter;
+    RenderList m_SceneComponents;
+    RenderList m_SceneLights;
+    RenderList m_UiComponents;
+    RenderList m_Filter;
 
-    list<PostProcessVolume *> m_postProcessVolume;
+    vector<PostProcessVolume *> m_postProcessVolume;
 
     BuffersMap m_textureBuffers;
     TargetsMap m_renderTargets;
@@ -102,6 +102,11 @@ public:
     Surface &surface(int face);
     void addSurface(const Surface &surface);
 
+    bool isPacked() const;
+
+    int mipCount() const;
+    ByteBuffer level(int face, int lod) const;
+
     void setDirty();
 
     void resize(int width, int height);
@@ -137,6 +142,10 @@ protected:
     int32_t dwordAlignedLineSize(int32_t width, int32_t bpp);
 
     uint8_t components() const;
+
+private:
+    ByteArray pack() const;
+    void unpack();
 };
 
 #endif // TEXTURE_H
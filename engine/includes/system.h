@@ -2,6 +2,7 @@
 #define SYSTEM_H
 
 #include <string>
+#include <atomic>
 #include <stdint.h>
 
 #include <objectsystem.h>
@@ -16,6 +17,22 @@ public:
         Pool
     };
 
+    enum Phase {
+        PreUpdate = 0,
+        Update,
+        PostUpdate,
+        Render,
+        FixedUpdate
+    };
+
+    enum Access {
+        Nothing     = 0,
+        Transforms  = (1<<0),
+        Components  = (1<<1),
+        Resources   = (1<<2),
+        Everything  = (Transforms | Components | Resources)
+    };
+
 public:
     System();
 
@@ -27,6 +44,12 @@ public:
 
     virtual int threadPolicy() const = 0;
 
+    virtual int phase() const;
+
+    virtual int reads() const;
+
+    virtual int writes() const;
+
     virtual void syncSettings() const;
 
     virtual void composeComponent(Component *component) const;
@@ -35,9 +58,19 @@ public:
 
     void processEvents() override;
 
+    uint32_t updateTime() const;
+
+    uint32_t updateOffset() const;
+
 protected:
+    friend class EnginePrivate;
+
     Scene *m_pScene;
 
+    atomic<uint32_t> m_UpdateTime;
+
+    atomic<uint32_t> m_UpdateOffset;
+
 };
 
 #endif // SYSTEM_H
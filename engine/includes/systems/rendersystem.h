@@ -21,6 +21,12 @@ public:
 
     int threadPolicy() const override;
 
+    int phase() const override;
+
+    int reads() const override;
+
+    int writes() const override;
+
     const char *name() const override;
 
     void composeComponent(Component *component) const override;
@@ -31,6 +37,9 @@ public:
 
     static void atlasPageSize(int32_t &width, int32_t &height);
 
+    bool isSnapshotsExtracted() const;
+    void setSnapshotsExtracted(bool extracted);
+
 protected:
     void processEvents() override;
 
@@ -40,6 +40,12 @@ private:
 
     int threadPolicy() const override;
 
+    int phase() const override;
+
+    int reads() const override;
+
+    int writes() const override;
+
     void deleteFromCahe(Resource *resource);
 
     void processState(Resource *resource);
@@ -22,6 +22,18 @@ public:
     static void                 setScale                    (float scale);
 
     static float                time                        ();
+
+    static float                fixedDeltaTime              ();
+
+    static void                 setFixedDeltaTime           (float delta);
+
+    static uint32_t             maxFixedSteps               ();
+
+    static void                 setMaxFixedSteps            (uint32_t steps);
+
+    static float                interpolation               ();
+
+    static uint32_t             consumeFixedSteps           ();
 };
 
 #endif // TIMER
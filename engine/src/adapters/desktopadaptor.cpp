@@ -159,7 +159,7 @@ bool DesktopAdaptor::start() {
         g_pFile->fread(&data[0], data.size(), 1, fp);
         g_pFile->fclose(fp);
 
-        Variant var = Json::load(string(data.begin(), data.end()));
+        Variant var = Json::load(reinterpret_cast<const char *>(data.data()), data.size());
         if(var.isValid()) {
             for(auto &it : var.toMap()) {
                 Engine::setValue(it.first, it.second);
@@ -376,8 +376,9 @@ void DesktopAdaptor::syncConfiguration(VariantMap &map) const {
 
     _FILE *fp = g_pFile->fopen(CONFIG_NAME, "w");
     if(fp) {
-        string data = Json::save(map, 0);
-        g_pFile->fwrite(&data[0], data.size(), 1, fp);
+        Json::save(map, [fp](const char *data, uint32_t size) {
+            g_pFile->fwrite(data, size, 1, fp);
+        }, 0);
         g_pFile->fclose(fp);
     }
 }
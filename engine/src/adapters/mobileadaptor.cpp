@@ -7,6 +7,7 @@
 
 #include "engine.h"
 #include "input.h"
+#include "timer.h"
 
 #ifdef GLFM_PLATFORM_ANDROID
 #include "androidfile.h"
@@ -65,6 +66,7 @@ static TouchMap s_Touches;
 
 void onFrame(GLFMDisplay *, const double) {
     if(g_pEngine) {
+        Timer::update();
         g_pEngine->update(g_pEngine->scene());
     }
 }
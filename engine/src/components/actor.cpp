@@ -9,6 +9,7 @@
 #include "commandbuffer.h"
 
 #include <cstring>
+#include <algorithm>
 
 const char *PREFAB  ("Prefab");
 const char *DATA    ("PrefabData");
@@ -151,11 +152,11 @@ public:
         }
     }
 
-    static Component *componentInChildHelper(const string &type, Object *parent) {
+    static Component *componentInChildHelper(uint32_t type, Object *parent) {
         PROFILE_FUNCTION();
         for(auto it : parent->getChildren()) {
             const MetaObject *meta = it->metaObject();
-            if(meta->canCastTo(type.c_str())) {
+            if(meta->canCastTo(type)) {
                 return static_cast<Component *>(it);
             } else {
                 Component *result = componentInChildHelper(type, it);
@@ -167,10 +168,45 @@ public:
         return nullptr;
     }
 
+    void updateComponents() {
+        m_components.clear();
+        for(auto it : m_actor->getChildren()) {
+            Component *component = dynamic_cast<Component *>(it);
+            if(component) {
+                m_components.push_back(component);
+            }
+        }
+    }
+
+    void setScene(Scene *scene) {
+        PROFILE_FUNCTION();
+        if(m_scene == scene) {
+            return;
+        }
+        for(auto it : m_components) {
+            if(m_scene) {
+                m_scene->removeComponent(it);
+            }
+            if(scene) {
+                scene->addComponent(it);
+            }
+        }
+        m_scene = scene;
+
+        for(auto it : m_actor->getChildren()) {
+            Actor *actor = dynamic_cast<Actor *>(it);
+            if(actor) {
+                actor->p_ptr->setScene(scene);
+            }
+        }
+    }
+
     string m_prefabRef;
 
     VariantMap m_data;
 
+    vector<Component *> m_components;
+
     Transform *m_transform;
 
     Prefab *m_prefab;
@@ -200,12 +236,14 @@ public:
 */
 
 Actor::Actor() :
-        p_ptr(new ActorPrivate(this)) {
+        p_ptr(createPrivate<ActorPrivate>(this)) {
 
 }
 
 Actor::~Actor() {
-    delete p_ptr;
+    p_ptr->setScene(nullptr);
+
+    destroyPrivate(p_ptr);
 }
 /*!
     Returns true in case of Actor is enabled; otherwise returns false.
@@ -243,6 +281,13 @@ void Actor::setHierarchyEnabled(bool enabled) {
         }
     }
 }
+/*!
+    \internal
+    Moves the components of this actor and all descendants to the registries of \a scene.
+*/
+void Actor::setScene(Scene *scene) {
+    p_ptr->setScene(scene);
+}
 /*!
     Returns true if this actor will not be moved during the game; otherwise returns false.
 */
@@ -277,7 +322,7 @@ void Actor::setLayers(const int layers) {
 Transform *Actor::transform() {
     PROFILE_FUNCTION();
     if(p_ptr->m_transform == nullptr) {
-        p_ptr->m_transform = static_cast<Transform *>(component(TRANSFORM));
+        p_ptr->m_transform = findComponent<Transform>();
     }
     return p_ptr->m_transform;
 }
@@ -286,15 +331,6 @@ Transform *Actor::transform() {
 */
 Scene *Actor::scene() {
     PROFILE_FUNCTION();
-    if(p_ptr->m_scene == nullptr) {
-        Object *scene = parent();
-        if(scene) {
-            while(scene->parent() != nullptr) {
-                scene = scene->parent();
-            }
-            p_ptr->m_scene = dynamic_cast<Scene *>(scene);
-        }
-    }
     return p_ptr->m_scene;
 }
 /*!
@@ -302,22 +338,41 @@ Scene *Actor::scene() {
 */
 Component *Actor::component(const string type) {
     PROFILE_FUNCTION();
-    for(auto it : getChildren()) {
-        const MetaObject *meta = it->metaObject();
-        if(meta->canCastTo(type.c_str())) {
-            return static_cast<Component *>(it);
+    return findComponent(MetaObject::typeId(type.c_str()));
+}
+/*!
+    Returns the component which can be cast to the \a type if one is attached to this Actor; otherwise returns nullptr.
+    The \a type is a compact type identifier returned by MetaObject::typeId().
+    This method doesn't compare the type names and should be preferred for the frequent lookups.
+
+    \sa component()
+*/
+Component *Actor::findComponent(uint32_t type) const {
+    PROFILE_FUNCTION();
+    for(auto it : p_ptr->m_components) {
+        if(it->metaObject()->canCastTo(type)) {
+            return it;
         }
     }
     return nullptr;
 }
+/*!
+    Returns all components attached to this Actor in the order of children.
+    The returned container is owned by the Actor and must not be stored, it changes when components are added or removed.
+*/
+const vector<Component *> &Actor::components() const {
+    PROFILE_FUNCTION();
+    return p_ptr->m_components;
+}
 /*!
     Returns the component with \a type in the Actor's children using depth search.
     A component is returned only if it's found on a current Actor; otherwise returns nullptr.
 */
 Component *Actor::componentInChild(const string type) {
     PROFILE_FUNCTION();
+    uint32_t id = MetaObject::typeId(type.c_str());
     for(auto it : getChildren()) {
-        Component *result = ActorPrivate::componentInChildHelper(type, it);
+        Component *result = ActorPrivate::componentInChildHelper(id, it);
         if(result) {
             return static_cast<Component *>(result);
         }
@@ -358,6 +413,21 @@ Object *Actor::clone(Object *parent) {
 /*!
     \internal
 */
+Object::ObjectList Actor::cloneBatch(uint32_t count, Object *parent) {
+    PROFILE_FUNCTION();
+    ObjectList result = Object::cloneBatch(count, parent);
+    Prefab *prefab = dynamic_cast<Prefab *>(Object::parent());
+    if(prefab == nullptr) {
+        prefab = p_ptr->m_prefab;
+    }
+    for(auto it : result) {
+        static_cast<Actor *>(it)->setPrefab(prefab);
+    }
+    return result;
+}
+/*!
+    \internal
+*/
 void Actor::clearCloneRef() {
     PROFILE_FUNCTION();
     if(p_ptr->m_prefab == nullptr) {
@@ -385,6 +455,12 @@ void Actor::setParent(Object *parent, int32_t position, bool force) {
         Object::setParent(parent, position);
     }
 
+    Object *root = parent;
+    while(root && root->parent()) {
+        root = root->parent();
+    }
+    p_ptr->setScene(dynamic_cast<Scene *>(root));
+
     for(auto it : getChildren()) {
         Component *component = dynamic_cast<Component *>(it);
         if(component) {
@@ -392,6 +468,43 @@ void Actor::setParent(Object *parent, int32_t position, bool force) {
         }
     }
 }
+/*!
+    \internal
+*/
+void Actor::addChild(Object *child, int32_t position) {
+    PROFILE_FUNCTION();
+    Object::addChild(child, position);
+
+    Component *component = dynamic_cast<Component *>(child);
+    if(component) {
+        if(position == -1) {
+            p_ptr->m_components.push_back(component);
+        } else {
+            p_ptr->updateComponents();
+        }
+        if(p_ptr->m_scene) {
+            p_ptr->m_scene->addComponent(component);
+        }
+    }
+}
+/*!
+    \internal
+*/
+void Actor::removeChild(Object *child) {
+    PROFILE_FUNCTION();
+    Object::removeChild(child);
+    // The child can be partially destroyed at this moment, so the pointer is only compared
+    auto it = std::find(p_ptr->m_components.begin(), p_ptr->m_components.end(), child);
+    if(it != p_ptr->m_components.end()) {
+        if(p_ptr->m_scene) {
+            p_ptr->m_scene->removeComponent(*it);
+        }
+        p_ptr->m_components.erase(it);
+    }
+    if(child == p_ptr->m_transform) {
+        p_ptr->m_transform = nullptr;
+    }
+}
 /*!
     Returns true in case the current object is an instance of the serialized prefab structure; otherwise returns false.
 */
@@ -502,9 +615,8 @@ void Actor::loadUserData(const VariantMap &data) {
                 if(object != cacheMap.end()) {
                     const MetaObject *meta = (*object).second->metaObject();
                     for(auto &property : fields.back().toMap()) {
-                        int32_t index = meta->indexOfProperty(property.first.c_str());
-                        if(index > -1) {
-                            MetaProperty prop = meta->property(index);
+                        MetaProperty prop = meta->findProperty(property.first.c_str());
+                        if(prop.isValid()) {
                             Variant var = property.second;
                             if(prop.type().flags() & MetaType::BASE_OBJECT) {
                                 if(var.type() == MetaType::STRING) { // Asset
@@ -173,12 +173,12 @@ public:
 */
 
 AnimationController::AnimationController() :
-        p_ptr(new AnimationControllerPrivate(this)) {
+        p_ptr(createPrivate<AnimationControllerPrivate>(this)) {
 
 }
 
 AnimationController::~AnimationController() {
-    delete p_ptr;
+    destroyPrivate(p_ptr);
 }
 /*!
     \internal
@@ -53,7 +53,7 @@ public:
 */
 
 AreaLight::AreaLight() :
-        p_ptr(new AreaLightPrivate) {
+        p_ptr(createPrivate<AreaLightPrivate>()) {
     setShape(Engine::loadResource<Mesh>(".embedded/cube.fbx/Box001"));
 
     Material *material = Engine::loadResource<Material>(".embedded/AreaLight.mtl");
@@ -75,7 +75,7 @@ AreaLight::AreaLight() :
 }
 
 AreaLight::~AreaLight() {
-    delete p_ptr;
+    destroyPrivate(p_ptr);
 }
 /*!
     \internal
@@ -85,7 +85,7 @@ void AreaLight::draw(CommandBuffer &buffer, uint32_t layer) {
     MaterialInstance *instance = material();
     if(mesh && instance && (layer & CommandBuffer::LIGHT)) {
 
-        Matrix4 m = actor()->transform()->worldTransform();
+        Matrix4 m = snapshot().m_Transform;
         p_ptr->m_position = Vector3(m[12], m[13], m[14]);
 
         float r = radius();
@@ -116,8 +116,8 @@ void AreaLight::shadowsUpdate(const Camera &camera, Pipeline *pipeline, RenderLi
 
     CommandBuffer *buffer = pipeline->buffer();
 
-    Transform *t = actor()->transform();
-    Vector3 pos = t->worldPosition();
+    const Matrix4 &wt = snapshot().m_Transform;
+    Vector3 pos(wt[12], wt[13], wt[14]);
 
     Matrix4 scale;
     scale[0]  = 0.5f;
@@ -137,8 +137,6 @@ void AreaLight::shadowsUpdate(const Camera &camera, Pipeline *pipeline, RenderLi
     float zFar = radius();
     Matrix4 crop = Matrix4::perspective(90.0f, 1.0f, p_ptr->m_near, zFar);
 
-    Matrix4 wt = t->worldTransform();
-
     Matrix4 wp;
     wp.translate(Vector3(wt[12], wt[13], wt[14]));
 
@@ -159,8 +157,8 @@ void AreaLight::shadowsUpdate(const Camera &camera, Pipeline *pipeline, RenderLi
         buffer->setViewProjection(mat, crop);
         buffer->setViewport(x[i], y[i], w[i], h[i]);
 
-        RenderList filter = Camera::frustumCulling(components,
-                                                   Camera::frustumCorners(false, 90.0f, 1.0f, pos, rot[i], p_ptr->m_near, zFar));
+        RenderFrameList filter = Camera::frustumCulling(components,
+                                                        Camera::frustumCorners(false, 90.0f, 1.0f, pos, rot[i], p_ptr->m_near, zFar));
         // Draw in the depth buffer from position of the light source
         for(auto it : filter) {
             static_cast<Renderable *>(it)->draw(*buffer, CommandBuffer::SHADOWCAST);
@@ -54,8 +54,6 @@ public:
 
     void cleanDirty(Actor *actor) {
         if(m_pBindPose) {
-            list<Actor *> bones = actor->findChildren<Actor *>();
-
             uint32_t count = m_pBindPose->boneCount();
             m_Bones.resize(count);
             m_InvertTransform.resize(count);
@@ -63,13 +61,10 @@ public:
 
             for(uint32_t c = 0; c < count; c++) {
                 const Bone *b = m_pBindPose->bone(c);
-                for(auto it : bones) {
-                    Transform *t = it->transform();
-                    if(t->clonedFrom() == b->index()) {
-                        m_Bones[c] = t;
-                        m_InvertTransform[c] = Matrix4(b->position(), b->rotation(), b->scale());
-                        break;
-                    }
+                Transform *t = dynamic_cast<Transform *>(Engine::findObject(b->index(), actor));
+                if(t && t != actor->transform() && t->clonedFrom() == b->index()) {
+                    m_Bones[c] = t;
+                    m_InvertTransform[c] = Matrix4(b->position(), b->rotation(), b->scale());
                 }
             }
         } else {
@@ -97,12 +92,12 @@ public:
 */
 
 Armature::Armature() :
-        p_ptr(new ArmaturePrivate) {
+        p_ptr(createPrivate<ArmaturePrivate>()) {
 
 }
 
 Armature::~Armature() {
-    delete p_ptr;
+    destroyPrivate(p_ptr);
 }
 /*!
     \internal
@@ -39,12 +39,12 @@ public:
 */
 
 BaseLight::BaseLight() :
-        p_ptr(new BaseLightPrivate) {
+        p_ptr(createPrivate<BaseLightPrivate>()) {
 
 }
 
 BaseLight::~BaseLight() {
-    delete p_ptr;
+    destroyPrivate(p_ptr);
 }
 
 /*!
@@ -90,12 +90,12 @@ Camera *CameraPrivate::s_pCurrent  = nullptr;
 */
 
 Camera::Camera() :
-    p_ptr(new CameraPrivate) {
+    p_ptr(createPrivate<CameraPrivate>()) {
 
 }
 
 Camera::~Camera() {
-    delete p_ptr;
+    destroyPrivate(p_ptr);
 }
 /*!
     Returns render pipline which attached to the camera.
@@ -363,9 +363,9 @@ array<Vector3, 8> Camera::frustumCorners(bool ortho, float sigma, float ratio, c
 }
 /*!
     Filters out an incoming \a list which are not in the \a frustum.
-    Returns filtered list.
+    Returns filtered list, allocated in the FrameArena of the current thread, so it must not be kept after the frame.
 */
-RenderList Camera::frustumCulling(RenderList &list, const array<Vector3, 8> &frustum) {
+RenderFrameList Camera::frustumCulling(const RenderList &list, const array<Vector3, 8> &frustum) {
     Plane pl[6];
     pl[0] = Plane(frustum[1], frustum[0], frustum[4]); // top
     pl[1] = Plane(frustum[7], frustum[3], frustum[2]); // bottom
@@ -374,9 +374,10 @@ RenderList Camera::frustumCulling(RenderList &list, const array<Vector3, 8> &fru
     pl[4] = Plane(frustum[0], frustum[1], frustum[3]); // near
     pl[5] = Plane(frustum[5], frustum[4], frustum[6]); // far
 
-    RenderList result;
+    RenderFrameList result;
+    result.reserve(list.size());
     for(auto it : list) {
-        AABBox box = it->bound();
+        AABBox box = it->snapshot().m_Bound;
         if(box.extent.x < 0.0f || box.intersect(pl, 6)) {
             result.push_back(it);
         }
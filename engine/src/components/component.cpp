@@ -23,11 +23,11 @@ public:
     \note This class must be a superclass only and shouldn't be created manually.
 */
 Component::Component() :
-        p_ptr(new ComponentPrivate) {
+        p_ptr(createPrivate<ComponentPrivate>()) {
 
 }
 Component::~Component() {
-    delete p_ptr;
+    destroyPrivate(p_ptr);
 }
 /*!
     Returns a pointer to the actor to which the component is attached.
@@ -91,6 +91,13 @@ bool Component::isRenderable() const {
 bool Component::isPostProcessVolume() const {
     return false;
 }
+/*!
+    Returns the type identifier of the Scene registry where this component must be registered or 0 if it doesn't need to be registered.
+    Systems can enumerate the registered components of the scene using Scene::components().
+*/
+uint32_t Component::registryType() const {
+    return 0;
+}
 /*!
     \internal
 */
@@ -39,7 +39,7 @@ public:
 */
 
 DirectLight::DirectLight() :
-        p_ptr(new DirectLightPrivate) {
+        p_ptr(createPrivate<DirectLightPrivate>()) {
     setShape(Engine::loadResource<Mesh>(".embedded/plane.fbx/Plane001"));
 
     Material *material  = Engine::loadResource<Material>(".embedded/DirectLight.mtl");
@@ -57,7 +57,7 @@ DirectLight::DirectLight() :
 }
 
 DirectLight::~DirectLight() {
-    delete p_ptr;
+    destroyPrivate(p_ptr);
 }
 /*!
     \internal
@@ -66,7 +66,7 @@ void DirectLight::draw(CommandBuffer &buffer, uint32_t layer) {
     Mesh *mesh = shape();
     MaterialInstance *instance = material();
     if(mesh && instance && (layer & CommandBuffer::LIGHT)) {
-        Quaternion q = actor()->transform()->worldRotation();
+        Quaternion q = snapshot().m_Rotation;
 
         p_ptr->m_direction = q * Vector3(0.0f, 0.0f, 1.0f);
 
@@ -109,7 +109,7 @@ void DirectLight::shadowsUpdate(const Camera &camera, Pipeline *pipeline, Render
         }
     }
 
-    Quaternion q = actor()->transform()->worldRotation();
+    Quaternion q = snapshot().m_Rotation;
     Matrix4 rot = Matrix4(q.toMatrix()).inverse();
 
     Matrix4 scale;
@@ -194,8 +194,8 @@ void DirectLight::shadowsUpdate(const Camera &camera, Pipeline *pipeline, Render
         Vector3 size = max - min;
         Vector3 pos(min + size * 0.5f);
 
-        RenderList filter = Camera::frustumCulling(components,
-                                                   Camera::frustumCorners(true, max.y - min.y, 1.0f, pos, q, min.z, max.z));
+        RenderFrameList filter = Camera::frustumCulling(components,
+                                                        Camera::frustumCorners(true, max.y - min.y, 1.0f, pos, q, min.z, max.z));
 
         // Draw in the depth buffer from position of the light source
         for(auto it : filter) {
@@ -32,24 +32,24 @@ public:
 */
 
 MeshRender::MeshRender() :
-        p_ptr(new MeshRenderPrivate) {
+        p_ptr(createPrivate<MeshRenderPrivate>()) {
 
 }
 
 MeshRender::~MeshRender() {
-    delete p_ptr;
+    destroyPrivate(p_ptr);
 }
 /*!
     \internal
 */
 void MeshRender::draw(CommandBuffer &buffer, uint32_t layer) {
-    Actor *a = actor();
-    if(p_ptr->m_pMesh && layer & a->layers() && a->transform()) {
+    const RenderSnapshot &s = snapshot();
+    if(s.m_pMesh && layer & s.m_Layers) {
         if(layer & CommandBuffer::RAYCAST) {
-            buffer.setColor(CommandBuffer::idToColor(a->uuid()));
+            buffer.setColor(CommandBuffer::idToColor(actor()->uuid()));
         }
 
-        buffer.drawMesh(a->transform()->worldTransform(), p_ptr->m_pMesh, 0, layer, p_ptr->m_pMaterial);
+        buffer.drawMesh(s.m_Transform, s.m_pMesh, 0, layer, s.m_pMaterial);
         buffer.setColor(Vector4(1.0f));
     }
 }
@@ -63,6 +63,15 @@ AABBox MeshRender::bound() const {
     }
     return Renderable::bound();
 }
+/*!
+    \internal
+*/
+void MeshRender::fillSnapshot(RenderSnapshot &snapshot) const {
+    Renderable::fillSnapshot(snapshot);
+
+    snapshot.m_pMesh = p_ptr->m_pMesh;
+    snapshot.m_pMaterial = p_ptr->m_pMaterial;
+}
 /*!
     Returns a Mesh assigned to this component.
 */
@@ -7,6 +7,9 @@
 
     All programmable game logic must be derived from NativeBehaviour class.
 
+    Enabled behaviours are registered in the Engine and executed each frame in the following order: fixedUpdate(), update() and lateUpdate().
+    Behaviours which return true from isParallelSafe() are executed in batches by the Engine thread pool, all other behaviours are executed one by one in the main thread.
+
     Example:
     \code
         class ExampleBehaviour : public NativeBehaviour {
@@ -27,12 +30,18 @@
     \endcode
 */
 
-NativeBehaviour::NativeBehaviour() {
+NativeBehaviour::NativeBehaviour() :
+        m_Index(-1) {
 
+    Engine::addNativeBehaviour(this);
 }
 
+NativeBehaviour::~NativeBehaviour() {
+    Engine::removeNativeBehaviour(this);
+}
 /*!
     Start is called on the same frame when a script is enabled just before the update method will be called the first time.
+    \note This method is always called in the main thread.
 */
 void NativeBehaviour::start() {
 
@@ -43,3 +52,39 @@ void NativeBehaviour::start() {
 void NativeBehaviour::update() {
 
 }
+/*!
+    LateUpdate is called every frame after all systems of System::Update phase are finished, if the NativeBehaviour is enabled.
+    It can be used to react on the results of physics or animation before the frame will be presented.
+*/
+void NativeBehaviour::lateUpdate() {
+
+}
+/*!
+    FixedUpdate is called before the update method, if the NativeBehaviour is enabled.
+    It should be used for the logic which depends on the simulation step.
+*/
+void NativeBehaviour::fixedUpdate() {
+
+}
+/*!
+    Returns true if the behaviour can be executed in parallel with other parallel-safe behaviours; otherwise returns false.
+    Parallel-safe behaviours may modify only own data and the data of own actor; they must not create or delete objects and must not access other behaviours.
+    Default is false.
+*/
+bool NativeBehaviour::isParallelSafe() const {
+    return false;
+}
+/*!
+    \overload
+    Sets current state of behaviour to \a enable or disabled.
+    Disabled behaviours are removed from the execution list of the Engine.
+*/
+void NativeBehaviour::setEnabled(bool enable) {
+    Component::setEnabled(enable);
+
+    if(enable) {
+        Engine::addNativeBehaviour(this);
+    } else {
+        Engine::removeNativeBehaviour(this);
+    }
+}
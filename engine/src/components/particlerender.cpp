@@ -90,12 +90,12 @@ public:
 */
 
 ParticleRender::ParticleRender() :
-        p_ptr(new ParticleRenderPrivate) {
+        p_ptr(createPrivate<ParticleRenderPrivate>()) {
 
 }
 
 ParticleRender::~ParticleRender() {
-    delete p_ptr;
+    destroyPrivate(p_ptr);
 }
 /*!
     \internal
@@ -192,7 +192,7 @@ void ParticleRender::update() {
 */
 void ParticleRender::draw(CommandBuffer &buffer, uint32_t layer) {
     Actor *a = actor();
-    if(layer & a->layers()) {
+    if(layer & snapshot().m_Layers) {
         if(layer & CommandBuffer::RAYCAST) {
             buffer.setColor(CommandBuffer::idToColor(a->uuid()));
         }
@@ -51,7 +51,7 @@ public:
 */
 
 PointLight::PointLight() :
-        p_ptr(new PointLightPrivate) {
+        p_ptr(createPrivate<PointLightPrivate>()) {
     setShape(Engine::loadResource<Mesh>(".embedded/cube.fbx/Box001"));
 
     Material *material = Engine::loadResource<Material>(".embedded/PointLight.mtl");
@@ -71,7 +71,7 @@ PointLight::PointLight() :
 }
 
 PointLight::~PointLight() {
-    delete p_ptr;
+    destroyPrivate(p_ptr);
 }
 /*!
     \internal
@@ -81,7 +81,7 @@ void PointLight::draw(CommandBuffer &buffer, uint32_t layer) {
     MaterialInstance *instance = material();
     if(mesh && instance && (layer & CommandBuffer::LIGHT)) {
 
-        Matrix4 m = actor()->transform()->worldTransform();
+        Matrix4 m = snapshot().m_Transform;
         p_ptr->m_position = Vector3(m[12], m[13], m[14]);
 
         float r = attenuationRadius();
@@ -110,8 +110,8 @@ void PointLight::shadowsUpdate(const Camera &camera, Pipeline *pipeline, RenderL
 
     CommandBuffer *buffer = pipeline->buffer();
 
-    Transform *t = actor()->transform();
-    Vector3 pos = t->worldPosition();
+    const Matrix4 &wt = snapshot().m_Transform;
+    Vector3 pos(wt[12], wt[13], wt[14]);
 
     Matrix4 scale;
     scale[0]  = 0.5f;
@@ -131,8 +131,6 @@ void PointLight::shadowsUpdate(const Camera &camera, Pipeline *pipeline, RenderL
     float zFar = attenuationRadius();
     Matrix4 crop = Matrix4::perspective(90.0f, 1.0f, p_ptr->m_near, zFar);
 
-    Matrix4 wt = t->worldTransform();
-
     Matrix4 wp;
     wp.translate(Vector3(wt[12], wt[13], wt[14]));
 
@@ -153,8 +151,8 @@ void PointLight::shadowsUpdate(const Camera &camera, Pipeline *pipeline, RenderL
         buffer->setViewProjection(mat, crop);
         buffer->setViewport(x[i], y[i], w[i], h[i]);
 
-        RenderList filter = Camera::frustumCulling(components,
-                                                   Camera::frustumCorners(false, 90.0f, 1.0f, pos, rot[i], p_ptr->m_near, zFar));
+        RenderFrameList filter = Camera::frustumCulling(components,
+                                                        Camera::frustumCorners(false, 90.0f, 1.0f, pos, rot[i], p_ptr->m_near, zFar));
         // Draw in the depth buffer from position of the light source
         for(auto it : filter) {
             static_cast<Renderable *>(it)->draw(*buffer, CommandBuffer::SHADOWCAST);
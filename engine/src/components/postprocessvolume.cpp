@@ -43,7 +43,7 @@ public:
 */
 
 PostProcessVolume::PostProcessVolume() :
-    p_ptr(new PostProcessVolumePrivate()) {
+    p_ptr(createPrivate<PostProcessVolumePrivate>()) {
 
     p_ptr->m_propertyTable.clear();
     for(auto &it : PostProcessSettings::settings()) {
@@ -52,12 +52,12 @@ PostProcessVolume::PostProcessVolume() :
         if(table) {
             p_ptr->m_propertyTable.push_back({it.first.c_str(), table, nullptr, nullptr, nullptr, nullptr, nullptr,
                                               &Reader<decltype(&PostProcessVolume::readProperty), &PostProcessVolume::readProperty>::read,
-                                              &Writer<decltype(&PostProcessVolume::writeProperty), &PostProcessVolume::writeProperty>::write});
+                                              &Writer<decltype(&PostProcessVolume::writeProperty), &PostProcessVolume::writeProperty>::write, nullptr});
         }
 
         p_ptr->m_settings.writeValue(it.first.c_str(), defaultValue);
     }
-    p_ptr->m_propertyTable.push_back({nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr});
+    p_ptr->m_propertyTable.push_back({nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr});
 
     p_ptr->m_metaObject = new MetaObject(VOLUME,
                                           PostProcessVolume::metaClass(), &PostProcessVolume::construct,
@@ -65,7 +65,7 @@ PostProcessVolume::PostProcessVolume() :
 }
 
 PostProcessVolume::~PostProcessVolume() {
-    delete p_ptr;
+    destroyPrivate(p_ptr);
     p_ptr = nullptr;
 }
 /*!
@@ -185,6 +185,12 @@ void PostProcessVolume::writeProperty(const MetaProperty &property, const Varian
 bool PostProcessVolume::isPostProcessVolume() const {
     return true;
 }
+/*!
+    \internal
+*/
+uint32_t PostProcessVolume::registryType() const {
+    return PostProcessVolume::metaClass()->typeId();
+}
 
 #ifdef NEXT_SHARED
 #include "handles.h"
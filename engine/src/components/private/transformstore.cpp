@@ -0,0 +1,410 @@
+#include "components/private/transformstore.h"
+
+#include "components/transform.h"
+
+#include <vector>
+#include <mutex>
+#include <algorithm>
+
+#include <threadpool.h>
+
+#define TRANSFORM_PARALLEL 1024
+
+struct TransformData {
+    Vector3 m_Position;
+    Vector3 m_Rotation;
+    Vector3 m_Scale;
+    Quaternion m_Quaternion;
+
+    Matrix4 m_Transform;
+    Matrix4 m_WorldTransform;
+
+    Vector3 m_WorldPosition;
+    Vector3 m_WorldRotation;
+    Vector3 m_WorldScale;
+    Quaternion m_WorldQuaternion;
+
+    Vector3 m_FixedPosition[2];
+    Quaternion m_FixedQuaternion[2];
+    Vector3 m_FixedScale[2];
+    uint8_t m_Fixed;
+
+    uint8_t m_Dirty;
+};
+
+class TransformLevel {
+public:
+    TransformLevel() :
+        m_Count(0) {
+
+    }
+
+    vector<TransformChunk *> m_Chunks;
+
+    uint32_t m_Count;
+};
+
+class TransformStorePrivate {
+public:
+    static TransformStorePrivate *instance() {
+        // Intentionally never destroyed, transforms can be deleted during static destruction
+        static TransformStorePrivate *store = new TransformStorePrivate;
+        return store;
+    }
+
+    void insert(TransformPrivate *transform, uint32_t depth, int32_t parent) {
+        if(depth >= m_Levels.size()) {
+            m_Levels.resize(depth + 1);
+        }
+        TransformLevel &level = m_Levels[depth];
+        uint32_t index = level.m_Count++;
+        uint32_t chunk = index / TRANSFORM_CHUNK;
+        if(chunk >= level.m_Chunks.size()) {
+            level.m_Chunks.push_back(new TransformChunk);
+        }
+        bind(transform, level.m_Chunks[chunk], depth, index);
+        transform->m_pChunk->m_Parent[transform->m_Slot] = parent;
+    }
+
+    void erase(TransformPrivate *transform) {
+        TransformLevel &level = m_Levels[transform->m_Depth];
+        uint32_t last = --level.m_Count;
+        if(transform->m_Index != last) {
+            // Fill the hole with the last element to keep the level dense
+            TransformChunk *chunk = level.m_Chunks[last / TRANSFORM_CHUNK];
+            TransformPrivate *moved = chunk->m_pOwner[last % TRANSFORM_CHUNK];
+            int32_t parent = chunk->m_Parent[last % TRANSFORM_CHUNK];
+
+            TransformData data;
+            read(moved, data);
+            bind(moved, transform->m_pChunk, transform->m_Depth, transform->m_Index);
+            write(moved, data);
+            moved->m_pChunk->m_Parent[moved->m_Slot] = parent;
+
+            for(auto it : moved->m_Children) {
+                TransformPrivate *child = it->p_ptr;
+                if(child->m_pChunk) {
+                    child->m_pChunk->m_Parent[child->m_Slot] = static_cast<int32_t>(moved->m_Index);
+                }
+            }
+        }
+        transform->m_pChunk = nullptr;
+    }
+
+    void relocate(TransformPrivate *transform, TransformPrivate *parent) {
+        uint32_t depth = parent ? parent->m_Depth + 1 : 0;
+        if(transform->m_Depth == depth) {
+            transform->m_pChunk->m_Parent[transform->m_Slot] = parent ? static_cast<int32_t>(parent->m_Index) : -1;
+            return;
+        }
+        // The subtree is removed completely before the insertion, levels of the parent and children can overlap during the move
+        m_Relocation.clear();
+        collect(transform);
+        for(auto &it : m_Relocation) {
+            erase(it.first);
+        }
+        for(auto &it : m_Relocation) {
+            TransformPrivate *p = (it.first == transform) ? parent : it.first->m_pParent->p_ptr;
+            if(p) {
+                insert(it.first, p->m_Depth + 1, static_cast<int32_t>(p->m_Index));
+            } else {
+                insert(it.first, 0, -1);
+            }
+            write(it.first, it.second);
+        }
+    }
+
+    void collect(TransformPrivate *transform) {
+        m_Relocation.push_back(make_pair(transform, TransformData()));
+        read(transform, m_Relocation.back().second);
+        for(auto it : transform->m_Children) {
+            collect(it->p_ptr);
+        }
+    }
+
+    static void cleanChain(TransformPrivate *transform) {
+        TransformChunk *chunk = transform->m_pChunk;
+        uint32_t slot = transform->m_Slot;
+        if(!chunk->m_Dirty[slot].load(memory_order_acquire)) {
+            return;
+        }
+        if(transform->m_pParent) {
+            TransformPrivate *parent = transform->m_pParent->p_ptr;
+            cleanChain(parent);
+            // Parents are always located on the previous level, so the chunks are locked in the order of depth
+            unique_lock<mutex> parentLocker(parent->m_pChunk->m_Mutex);
+            unique_lock<mutex> locker(chunk->m_Mutex);
+            if(chunk->m_Dirty[slot].load(memory_order_relaxed)) {
+                compute(chunk, slot, parent->m_pChunk, parent->m_Slot);
+            }
+        } else {
+            unique_lock<mutex> locker(chunk->m_Mutex);
+            if(chunk->m_Dirty[slot].load(memory_order_relaxed)) {
+                compute(chunk, slot, nullptr, 0);
+            }
+        }
+    }
+
+    void updateLevel(uint32_t depth, uint32_t begin, uint32_t end) {
+        TransformLevel &level = m_Levels[depth];
+        TransformLevel *parent = (depth > 0) ? &m_Levels[depth - 1] : nullptr;
+
+        for(uint32_t c = begin; c < end; c++) {
+            TransformChunk *chunk = level.m_Chunks[c];
+            uint32_t count = min(static_cast<uint32_t>(TRANSFORM_CHUNK), level.m_Count - c * TRANSFORM_CHUNK);
+            for(uint32_t slot = 0; slot < count; slot++) {
+                if(!chunk->m_Dirty[slot].load(memory_order_relaxed)) {
+                    continue;
+                }
+                if(parent) {
+                    uint32_t index = static_cast<uint32_t>(chunk->m_Parent[slot]);
+                    compute(chunk, slot, parent->m_Chunks[index / TRANSFORM_CHUNK], index % TRANSFORM_CHUNK);
+                } else {
+                    compute(chunk, slot, nullptr, 0);
+                }
+            }
+        }
+    }
+
+    static void bind(TransformPrivate *transform, TransformChunk *chunk, uint32_t depth, uint32_t index) {
+        transform->m_pChunk = chunk;
+        transform->m_Slot = index % TRANSFORM_CHUNK;
+        transform->m_Depth = depth;
+        transform->m_Index = index;
+        chunk->m_pOwner[transform->m_Slot] = transform;
+    }
+
+    static void compute(TransformChunk *chunk, uint32_t slot, const TransformChunk *parent, uint32_t parentSlot) {
+        Matrix4 &local = chunk->m_Transform[slot];
+        local = Matrix4(chunk->m_Position[slot], chunk->m_Quaternion[slot], chunk->m_Scale[slot]);
+        if(parent) {
+            const Matrix4 &world = parent->m_WorldTransform[parentSlot];
+            chunk->m_WorldPosition[slot] = world * chunk->m_Position[slot];
+            chunk->m_WorldScale[slot] = parent->m_WorldScale[parentSlot] * chunk->m_Scale[slot];
+            chunk->m_WorldRotation[slot] = parent->m_WorldRotation[parentSlot] + chunk->m_Rotation[slot];
+            chunk->m_WorldQuaternion[slot] = parent->m_WorldQuaternion[parentSlot] * chunk->m_Quaternion[slot];
+            chunk->m_WorldTransform[slot] = world * local;
+        } else {
+            chunk->m_WorldPosition[slot] = chunk->m_Position[slot];
+            chunk->m_WorldScale[slot] = chunk->m_Scale[slot];
+            chunk->m_WorldRotation[slot] = chunk->m_Rotation[slot];
+            chunk->m_WorldQuaternion[slot] = chunk->m_Quaternion[slot];
+            chunk->m_WorldTransform[slot] = local;
+        }
+        chunk->m_Dirty[slot].store(0, memory_order_release);
+    }
+
+    static void read(const TransformPrivate *transform, TransformData &data) {
+        const TransformChunk *chunk = transform->m_pChunk;
+        uint32_t slot = transform->m_Slot;
+        data.m_Position = chunk->m_Position[slot];
+        data.m_Rotation = chunk->m_Rotation[slot];
+        data.m_Scale = chunk->m_Scale[slot];
+        data.m_Quaternion = chunk->m_Quaternion[slot];
+        data.m_Transform = chunk->m_Transform[slot];
+        data.m_WorldTransform = chunk->m_WorldTransform[slot];
+        data.m_WorldPosition = chunk->m_WorldPosition[slot];
+        data.m_WorldRotation = chunk->m_WorldRotation[slot];
+        data.m_WorldScale = chunk->m_WorldScale[slot];
+        data.m_WorldQuaternion = chunk->m_WorldQuaternion[slot];
+        for(int i = 0; i < 2; i++) {
+            data.m_FixedPosition[i] = chunk->m_FixedPosition[i][slot];
+            data.m_FixedQuaternion[i] = chunk->m_FixedQuaternion[i][slot];
+            data.m_FixedScale[i] = chunk->m_FixedScale[i][slot];
+        }
+        data.m_Fixed = chunk->m_Fixed[slot];
+        data.m_Dirty = chunk->m_Dirty[slot].load(memory_order_relaxed);
+    }
+
+    static void write(TransformPrivate *transform, const TransformData &data) {
+        TransformChunk *chunk = transform->m_pChunk;
+        uint32_t slot = transform->m_Slot;
+        chunk->m_Position[slot] = data.m_Position;
+        chunk->m_Rotation[slot] = data.m_Rotation;
+        chunk->m_Scale[slot] = data.m_Scale;
+        chunk->m_Quaternion[slot] = data.m_Quaternion;
+        chunk->m_Transform[slot] = data.m_Transform;
+        chunk->m_WorldTransform[slot] = data.m_WorldTransform;
+        chunk->m_WorldPosition[slot] = data.m_WorldPosition;
+        chunk->m_WorldRotation[slot] = data.m_WorldRotation;
+        chunk->m_WorldScale[slot] = data.m_WorldScale;
+        chunk->m_WorldQuaternion[slot] = data.m_WorldQuaternion;
+        for(int i = 0; i < 2; i++) {
+            chunk->m_FixedPosition[i][slot] = data.m_FixedPosition[i];
+            chunk->m_FixedQuaternion[i][slot] = data.m_FixedQuaternion[i];
+            chunk->m_FixedScale[i][slot] = data.m_FixedScale[i];
+        }
+        chunk->m_Fixed[slot] = data.m_Fixed;
+        chunk->m_Dirty[slot].store(data.m_Dirty, memory_order_relaxed);
+    }
+
+    vector<TransformLevel> m_Levels;
+
+    vector<pair<TransformPrivate *, TransformData>> m_Relocation;
+
+    mutex m_Mutex;
+};
+
+TransformPrivate::TransformPrivate(Transform *transform) :
+        m_pTransform(transform),
+        m_pParent(nullptr),
+        m_pChunk(nullptr),
+        m_Slot(0),
+        m_Depth(0),
+        m_Index(0) {
+
+}
+/*!
+    \class TransformStore
+    \brief The TransformStore keeps the local and world space data of all Transform components.
+    \internal
+
+    The data are stored as structure of arrays split to the chunks of TRANSFORM_CHUNK elements.
+    Transforms are grouped into the levels by the depth in the hierarchy, so parents are always located on the previous level.
+    This allows to recalculate the whole hierarchy by the one pass per level without the recursion, all elements on the same level are independent and can be processed in parallel.
+    Chunks are never moved in memory, but the slot of a removed or moved transform is filled with the last element of its level.
+    So the references which returned by Transform must not be kept after any transform is created, deleted or reparented.
+
+    Besides the current state, the world position, rotation and scale of the two last fixed simulation steps are kept by storeFixedStep().
+    They are used to blend the state of the simulated objects between the fixed steps, see Transform::interpolatedTransform().
+
+    Each modification of the Transform marks it and all descendants as dirty.
+    The dirty elements are recalculated by update() once per frame, reading of a dirty transform between the updates calculates its parents chain on demand.
+    Local values and dirty flags are guarded by the mutex of their chunk, so transforms can be modified and read from the parallel behaviours.
+    The store mutex protects only the layout, the hierarchy must not be changed in parallel with the access to the affected transforms.
+*/
+/*!
+    Registers a new root \a transform in the store.
+*/
+void TransformStore::add(TransformPrivate *transform) {
+    TransformStorePrivate *store = TransformStorePrivate::instance();
+    unique_lock<mutex> locker(store->m_Mutex);
+
+    store->insert(transform, 0, -1);
+
+    TransformChunk *chunk = transform->m_pChunk;
+    uint32_t slot = transform->m_Slot;
+    chunk->m_Position[slot] = Vector3();
+    chunk->m_Rotation[slot] = Vector3();
+    chunk->m_Scale[slot] = Vector3(1.0f);
+    chunk->m_Quaternion[slot] = Quaternion();
+    chunk->m_Transform[slot] = Matrix4();
+    chunk->m_WorldTransform[slot] = Matrix4();
+    chunk->m_WorldPosition[slot] = Vector3();
+    chunk->m_WorldRotation[slot] = Vector3();
+    chunk->m_WorldScale[slot] = Vector3(1.0f);
+    chunk->m_WorldQuaternion[slot] = Quaternion();
+    chunk->m_Fixed[slot] = 0;
+    chunk->m_Dirty[slot].store(1, memory_order_release);
+}
+/*!
+    Unregisters the \a transform from the store.
+    \note The transform must be detached from the hierarchy before.
+*/
+void TransformStore::remove(TransformPrivate *transform) {
+    TransformStorePrivate *store = TransformStorePrivate::instance();
+    unique_lock<mutex> locker(store->m_Mutex);
+
+    store->erase(transform);
+}
+/*!
+    Moves the \a transform with all descendants under the \a parent in the store.
+    The \a transform is moved to the top level in case of \a parent is nullptr.
+    \note The lists of children must be updated before.
+*/
+void TransformStore::setParent(TransformPrivate *transform, TransformPrivate *parent) {
+    TransformStorePrivate *store = TransformStorePrivate::instance();
+    unique_lock<mutex> locker(store->m_Mutex);
+
+    store->relocate(transform, parent);
+}
+/*!
+    Marks the \a transform and all descendants as dirty.
+    Descendants of a dirty transform are always dirty, so the propagation stops on the already dirty elements.
+    Only one chunk is locked at a time, so it can be called in parallel with clean().
+*/
+void TransformStore::setDirty(TransformPrivate *transform) {
+    TransformChunk *chunk = transform->m_pChunk;
+    {
+        unique_lock<mutex> locker(chunk->m_Mutex);
+        atomic<uint8_t> &dirty = chunk->m_Dirty[transform->m_Slot];
+        if(dirty.load(memory_order_relaxed)) {
+            return;
+        }
+        dirty.store(1, memory_order_release);
+    }
+    for(auto it : transform->m_Children) {
+        setDirty(it->p_ptr);
+    }
+}
+/*!
+    Recalculates the dirty \a transform and its dirty parents.
+    It's a slow path for the transforms which are read between the updates.
+    Locks only the chunks of the chain, so the independent transforms are cleaned in parallel.
+*/
+void TransformStore::clean(TransformPrivate *transform) {
+    TransformStorePrivate::cleanChain(transform);
+}
+/*!
+    Returns true in case of the \a transform must be recalculated before reading of its world space values; otherwise returns false.
+*/
+bool TransformStore::isDirty(const TransformPrivate *transform) {
+    return transform->m_pChunk->m_Dirty[transform->m_Slot].load(memory_order_acquire) != 0;
+}
+/*!
+    Recalculates all dirty transforms level by level starting from the roots.
+    Large levels are split between the threads of the \a pool, it can be nullptr to update on the current thread only.
+    \note Transforms must not be created, deleted or reparented during the update.
+*/
+void TransformStore::update(ThreadPool *pool) {
+    TransformStorePrivate *store = TransformStorePrivate::instance();
+    unique_lock<mutex> locker(store->m_Mutex);
+
+    for(uint32_t depth = 0; depth < store->m_Levels.size(); depth++) {
+        uint32_t count = store->m_Levels[depth].m_Count;
+        if(count == 0) {
+            continue;
+        }
+        uint32_t chunks = (count + TRANSFORM_CHUNK - 1) / TRANSFORM_CHUNK;
+        if(pool && count >= TRANSFORM_PARALLEL) {
+            Job job = pool->parallelFor(chunks, 1, [store, depth](uint32_t begin, uint32_t end) {
+                store->updateLevel(depth, begin, end);
+            });
+            pool->wait(job);
+        } else {
+            store->updateLevel(depth, 0, chunks);
+        }
+    }
+}
+/*!
+    Stores the world state of all transforms as the result of the fixed simulation step, the state of the previous step is kept for the interpolation.
+    The transforms which are stored for the first time get the same previous and current states.
+    \note The transforms must be updated before, see update().
+*/
+void TransformStore::storeFixedStep() {
+    TransformStorePrivate *store = TransformStorePrivate::instance();
+    unique_lock<mutex> locker(store->m_Mutex);
+
+    for(auto &level : store->m_Levels) {
+        uint32_t chunks = (level.m_Count + TRANSFORM_CHUNK - 1) / TRANSFORM_CHUNK;
+        for(uint32_t c = 0; c < chunks; c++) {
+            TransformChunk *chunk = level.m_Chunks[c];
+            uint32_t count = min(static_cast<uint32_t>(TRANSFORM_CHUNK), level.m_Count - c * TRANSFORM_CHUNK);
+            for(uint32_t slot = 0; slot < count; slot++) {
+                if(chunk->m_Fixed[slot]) {
+                    chunk->m_FixedPosition[0][slot] = chunk->m_FixedPosition[1][slot];
+                    chunk->m_FixedQuaternion[0][slot] = chunk->m_FixedQuaternion[1][slot];
+                    chunk->m_FixedScale[0][slot] = chunk->m_FixedScale[1][slot];
+                } else {
+                    chunk->m_FixedPosition[0][slot] = chunk->m_WorldPosition[slot];
+                    chunk->m_FixedQuaternion[0][slot] = chunk->m_WorldQuaternion[slot];
+                    chunk->m_FixedScale[0][slot] = chunk->m_WorldScale[slot];
+                    chunk->m_Fixed[slot] = 1;
+                }
+                chunk->m_FixedPosition[1][slot] = chunk->m_WorldPosition[slot];
+                chunk->m_FixedQuaternion[1][slot] = chunk->m_WorldQuaternion[slot];
+                chunk->m_FixedScale[1][slot] = chunk->m_WorldScale[slot];
+            }
+        }
+    }
+}
@@ -1,15 +1,31 @@
 #include "components/renderable.h"
 
+#include "components/actor.h"
+#include "components/transform.h"
+
 /*!
     \class Renderable
     \brief Base class for every object which can be drawn on the screen.
     \inmodule Engine
 
+    Drawing code doesn't read the components directly, instead it uses the snapshot of render relevant state: world transform, bound, layers and resources.
+    The snapshot is extracted by the Engine once per frame after the LateUpdate phase, so the systems of the later phases and the parallel jobs can modify the components without affecting the upcoming render.
+    The render itself is executed at the end of the same frame, it doesn't overlap with the simulation of the next one.
+    Only the renderables are taken from the snapshots, the state of the camera and the enabled flags of components are read at the moment of the render.
+    Each renderable keeps two snapshots, a new one is written to the back buffer and published by swapping the buffers.
+
     \note This class must be a superclass only and shouldn't be created manually.
 */
 
-Renderable::Renderable() {
+Renderable::Renderable() :
+        m_Front(0),
+        m_Extracted(false) {
 
+    for(auto &it : m_Snapshots) {
+        it.m_pMesh = nullptr;
+        it.m_pMaterial = nullptr;
+        it.m_Layers = 0;
+    }
 }
 /*!
     \internal
@@ -40,6 +56,57 @@ bool Renderable::isRenderable() const {
 /*!
     \internal
 */
+uint32_t Renderable::registryType() const {
+    return Renderable::metaClass()->typeId();
+}
+/*!
+    \internal
+*/
 void Renderable::composeComponent() {
 
 }
+/*!
+    Returns the last published snapshot of the renderable state.
+    \note Drawing code must use the snapshot instead of the state of components.
+*/
+const RenderSnapshot &Renderable::snapshot() const {
+    return m_Snapshots[m_Front];
+}
+/*!
+    Returns true in case of the snapshot was extracted at least once; otherwise returns false.
+*/
+bool Renderable::hasSnapshot() const {
+    return m_Extracted;
+}
+/*!
+    Fills the back snapshot with the current state and publishes it.
+    The previous snapshot stays untouched, so it can be read until the publishing.
+*/
+void Renderable::extractSnapshot() {
+    uint32_t back = m_Front ^ 1;
+    fillSnapshot(m_Snapshots[back]);
+    m_Front = back;
+    m_Extracted = true;
+}
+/*!
+    Fills the \a snapshot with the current state of component.
+    Reimplement this method to add the resources which are used by draw().
+*/
+void Renderable::fillSnapshot(RenderSnapshot &snapshot) const {
+    snapshot.m_pMesh = nullptr;
+    snapshot.m_pMaterial = nullptr;
+
+    Actor *a = actor();
+    Transform *t = (a) ? a->transform() : nullptr;
+    if(t) {
+        snapshot.m_Transform = t->worldTransform();
+        snapshot.m_Rotation = t->worldRotation();
+        snapshot.m_Bound = bound();
+        snapshot.m_Layers = a->layers();
+    } else {
+        snapshot.m_Transform = Matrix4();
+        snapshot.m_Rotation = Vector3();
+        snapshot.m_Bound = AABBox();
+        snapshot.m_Layers = 0;
+    }
+}
@@ -13,10 +13,34 @@ public:
 
     }
 
+    struct Registry {
+        vector<Component *> m_Components;
+
+        uint32_t m_Holes = 0;
+    };
+
+    void compact(Registry &registry) {
+        // Removed components leave holes to keep the order of registration, the holes are collapsed on access
+        uint32_t slot = 0;
+        for(auto it : registry.m_Components) {
+            if(it) {
+                m_Indices[it].second = slot;
+                registry.m_Components[slot] = it;
+                slot++;
+            }
+        }
+        registry.m_Components.resize(slot);
+        registry.m_Holes = 0;
+    }
+
     bool m_Dirty;
     bool m_Update;
 
     PostProcessSettings m_FinalPostProcessSettings;
+
+    unordered_map<uint32_t, Registry> m_Registries;
+
+    unordered_map<Component *, pair<uint32_t, uint32_t>> m_Indices;
 };
 
 /*!
@@ -31,12 +55,19 @@ public:
 */
 
 Scene::Scene() :
-    p_ptr(new ScenePrivate) {
+    p_ptr(createPrivate<ScenePrivate>()) {
 
 }
 
 Scene::~Scene() {
-    delete p_ptr;
+    // Components are unregistered before the registries are gone, the actors are deleted by the Object destructor
+    for(auto it : getChildren()) {
+        Actor *actor = dynamic_cast<Actor *>(it);
+        if(actor) {
+            actor->setScene(nullptr);
+        }
+    }
+    destroyPrivate(p_ptr);
 }
 /*!
     Returns in case of scene must be updated in the current frame; otherwise returns false.
@@ -69,3 +100,51 @@ void Scene::setDirty(bool flag) {
 PostProcessSettings &Scene::finalPostProcessSettings() {
     return p_ptr->m_FinalPostProcessSettings;
 }
+/*!
+    Returns the list of enabled and disabled components attached to this scene which registered with \a type.
+    The components are registered by the type returned by Component::registryType(), for example, all Renderable components are registered with Renderable type.
+    This method allows the systems to enumerate their components without walking through the scene hierarchy.
+
+    \note The returned list is owned by the Scene and changes when components are attached or detached.
+*/
+const vector<Component *> &Scene::components(uint32_t type) {
+    PROFILE_FUNCTION();
+    static const vector<Component *> empty;
+
+    auto it = p_ptr->m_Registries.find(type);
+    if(it == p_ptr->m_Registries.end()) {
+        return empty;
+    }
+    if(it->second.m_Holes > 0) {
+        p_ptr->compact(it->second);
+    }
+    return it->second.m_Components;
+}
+/*!
+    \internal
+    Registers the \a component in the registry of the scene.
+*/
+void Scene::addComponent(Component *component) {
+    PROFILE_FUNCTION();
+    uint32_t type = component->registryType();
+    if(type != 0 && p_ptr->m_Indices.find(component) == p_ptr->m_Indices.end()) {
+        ScenePrivate::Registry &registry = p_ptr->m_Registries[type];
+        p_ptr->m_Indices[component] = make_pair(type, static_cast<uint32_t>(registry.m_Components.size()));
+        registry.m_Components.push_back(component);
+    }
+}
+/*!
+    \internal
+    Unregisters the \a component from the registry of the scene.
+    \note The \a component can be partially destroyed at this moment, so only its address is used.
+*/
+void Scene::removeComponent(Component *component) {
+    PROFILE_FUNCTION();
+    auto it = p_ptr->m_Indices.find(component);
+    if(it != p_ptr->m_Indices.end()) {
+        ScenePrivate::Registry &registry = p_ptr->m_Registries[it->second.first];
+        registry.m_Components[it->second.second] = nullptr;
+        registry.m_Holes++;
+        p_ptr->m_Indices.erase(it);
+    }
+}
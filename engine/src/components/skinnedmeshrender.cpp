@@ -41,24 +41,24 @@ public:
 */
 
 SkinnedMeshRender::SkinnedMeshRender() :
-        p_ptr(new SkinnedMeshRenderPrivate) {
+        p_ptr(createPrivate<SkinnedMeshRenderPrivate>()) {
 
 }
 
 SkinnedMeshRender::~SkinnedMeshRender() {
-    delete p_ptr;
+    destroyPrivate(p_ptr);
 }
 /*!
     \internal
 */
 void SkinnedMeshRender::draw(CommandBuffer &buffer, uint32_t layer) {
-    Actor *a = actor();
-    if(p_ptr->m_pMesh && layer & a->layers()) {
+    const RenderSnapshot &s = snapshot();
+    if(s.m_pMesh && layer & s.m_Layers) {
         if(layer & CommandBuffer::RAYCAST) {
-            buffer.setColor(CommandBuffer::idToColor(a->uuid()));
+            buffer.setColor(CommandBuffer::idToColor(actor()->uuid()));
         }
 
-        buffer.drawMesh(a->transform()->worldTransform(), p_ptr->m_pMesh, 0, layer, p_ptr->m_pMaterial);
+        buffer.drawMesh(s.m_Transform, s.m_pMesh, 0, layer, s.m_pMaterial);
         buffer.setColor(Vector4(1.0f));
     }
 }
@@ -75,6 +75,15 @@ AABBox SkinnedMeshRender::bound() const {
     }
     return result;
 }
+/*!
+    \internal
+*/
+void SkinnedMeshRender::fillSnapshot(RenderSnapshot &snapshot) const {
+    Renderable::fillSnapshot(snapshot);
+
+    snapshot.m_pMesh = p_ptr->m_pMesh;
+    snapshot.m_pMaterial = p_ptr->m_pMaterial;
+}
 /*!
     Returns a Mesh assigned to this component.
 */
@@ -44,7 +44,7 @@ public:
 */
 
 SpotLight::SpotLight() :
-        p_ptr(new SpotLightPrivate) {
+        p_ptr(createPrivate<SpotLightPrivate>()) {
 
     setOuterAngle(45.0f);
 
@@ -65,7 +65,7 @@ SpotLight::SpotLight() :
 }
 
 SpotLight::~SpotLight() {
-    delete p_ptr;
+    destroyPrivate(p_ptr);
 }
 /*!
     \internal
@@ -74,9 +74,10 @@ void SpotLight::draw(CommandBuffer &buffer, uint32_t layer) {
     Mesh *mesh = shape();
     MaterialInstance *instance = material();
     if(mesh && instance && (layer & CommandBuffer::LIGHT)) {
-        Quaternion q = actor()->transform()->worldRotation();
+        const RenderSnapshot &s = snapshot();
+        Quaternion q = s.m_Rotation;
 
-        p_ptr->m_position = actor()->transform()->worldPosition();
+        p_ptr->m_position = Vector3(s.m_Transform[12], s.m_Transform[13], s.m_Transform[14]);
         p_ptr->m_direction = q * Vector3(0.0f, 0.0f, 1.0f);
 
         float d = attenuationDistance();
@@ -101,10 +102,10 @@ void SpotLight::shadowsUpdate(const Camera &camera, Pipeline *pipeline, RenderLi
     }
     CommandBuffer *buffer = pipeline->buffer();
 
-    Transform *t = actor()->transform();
-    Vector3 pos = t->worldPosition();
-    Quaternion q = t->worldRotation();
-    Matrix4 rot = t->worldTransform().inverse();
+    const RenderSnapshot &s = snapshot();
+    Vector3 pos(s.m_Transform[12], s.m_Transform[13], s.m_Transform[14]);
+    Quaternion q = s.m_Rotation;
+    Matrix4 rot = s.m_Transform.inverse();
 
     Matrix4 scale;
     scale[0]  = 0.5f;
@@ -138,8 +139,8 @@ void SpotLight::shadowsUpdate(const Camera &camera, Pipeline *pipeline, RenderLi
     buffer->setViewProjection(rot, crop);
     buffer->setViewport(x, y, w, h);
 
-    RenderList filter = Camera::frustumCulling(components,
-                                               Camera::frustumCorners(false, p_ptr->m_angle * 2.0f, 1.0f, pos, q, p_ptr->m_near, zFar));
+    RenderFrameList filter = Camera::frustumCulling(components,
+                                                    Camera::frustumCorners(false, p_ptr->m_angle * 2.0f, 1.0f, pos, q, p_ptr->m_near, zFar));
     // Draw in the depth buffer from position of the light source
     for(auto it : filter) {
         it->draw(*buffer, CommandBuffer::SHADOWCAST);
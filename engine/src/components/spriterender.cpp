@@ -106,32 +106,41 @@ public:
 */
 
 SpriteRender::SpriteRender() :
-        p_ptr(new SpriteRenderPrivate) {
+        p_ptr(createPrivate<SpriteRenderPrivate>()) {
 
 }
 
 SpriteRender::~SpriteRender() {
-    delete p_ptr;
+    destroyPrivate(p_ptr);
 }
 /*!
     \internal
 */
 void SpriteRender::draw(CommandBuffer &buffer, uint32_t layer) {
-    Actor *a = actor();
-    if(p_ptr->m_pMesh && layer & a->layers()) {
+    const RenderSnapshot &s = snapshot();
+    if(s.m_pMesh && layer & s.m_Layers) {
         if(layer & CommandBuffer::RAYCAST) {
-            buffer.setColor(CommandBuffer::idToColor(a->uuid()));
+            buffer.setColor(CommandBuffer::idToColor(actor()->uuid()));
         }
 
-        buffer.drawMesh(a->transform()->worldTransform(),
-                        (p_ptr->m_pCustomMesh) ? p_ptr->m_pCustomMesh : p_ptr->m_pMesh,
-                        0, layer, p_ptr->m_pMaterial);
+        buffer.drawMesh(s.m_Transform, s.m_pMesh, 0, layer, s.m_pMaterial);
         buffer.setColor(Vector4(1.0f));
     }
 }
 /*!
     \internal
 */
+void SpriteRender::fillSnapshot(RenderSnapshot &snapshot) const {
+    Renderable::fillSnapshot(snapshot);
+
+    if(p_ptr->m_pMesh) {
+        snapshot.m_pMesh = (p_ptr->m_pCustomMesh) ? p_ptr->m_pCustomMesh : p_ptr->m_pMesh;
+    }
+    snapshot.m_pMaterial = p_ptr->m_pMaterial;
+}
+/*!
+    \internal
+*/
 AABBox SpriteRender::bound() const {
     AABBox result = Renderable::bound();
     if(p_ptr->m_pCustomMesh) {
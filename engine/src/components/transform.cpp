@@ -1,68 +1,10 @@
 #include "components/transform.h"
 
 #include "components/actor.h"
+#include "components/private/transformstore.h"
 
 #include <algorithm>
-#include <mutex>
 
-class TransformPrivate {
-public:
-    TransformPrivate() :
-        m_Position(Vector3()),
-        m_Rotation(Vector3()),
-        m_Scale(Vector3(1.0f)),
-        m_WorldPosition(Vector3()),
-        m_WorldRotation(Vector3()),
-        m_WorldScale(Vector3(1.0f)),
-        m_Quaternion(Quaternion()),
-        m_WorldQuaternion(Quaternion()),
-        m_Transform(Matrix4()),
-        m_WorldTransform(Matrix4()),
-        m_pParent(nullptr),
-        m_Dirty(true) {
-
-    }
-
-    void cleanDirty() {
-        unique_lock<mutex> locker(m_Mutex);
-        m_Transform = Matrix4(m_Position, m_Quaternion, m_Scale);
-        m_WorldTransform = m_Transform;
-        m_WorldRotation = m_Rotation;
-        m_WorldPosition = m_Position;
-        m_WorldQuaternion = m_Quaternion;
-        m_WorldScale = m_Scale;
-        if(m_pParent) {
-            m_WorldPosition = m_pParent->worldTransform() * m_WorldPosition;
-            m_WorldScale = m_pParent->worldScale() * m_WorldScale;
-            m_WorldRotation = m_pParent->worldRotation() + m_WorldRotation;
-            m_WorldQuaternion = m_pParent->worldQuaternion() * m_WorldQuaternion;
-            m_WorldTransform = m_pParent->worldTransform() * m_WorldTransform;
-        }
-        m_Dirty = false;
-    }
-
-    Vector3 m_Position;
-    Vector3 m_Rotation;
-    Vector3 m_Scale;
-
-    Vector3 m_WorldPosition;
-    Vector3 m_WorldRotation;
-    Vector3 m_WorldScale;
-
-    Quaternion m_Quaternion;
-    Quaternion m_WorldQuaternion;
-
-    Matrix4 m_Transform;
-    Matrix4 m_WorldTransform;
-
-    list<Transform *> m_Children;
-
-    Transform *m_pParent;
-
-    mutex m_Mutex;
-
-    bool m_Dirty;
-};
 /*!
     \class Transform
     \brief Position, rotation and scale of an Actor.
@@ -71,10 +13,15 @@ public:
     Every Actor in a Scene has a Transform.
     It's used to store and manipulate the position, rotation and scale of the object.
     Every Transform can have a parent, which allows you to apply position, rotation and scale hierarchically.
+
+    World space values of all transforms are recalculated together once per frame after the LateUpdate phase.
+    Reading of a modified transform before that calculates its values on demand.
+    Setters and getters can be called from the parallel behaviours, but the hierarchy must be changed on the main thread only.
 */
 
 Transform::Transform() :
-        p_ptr(new TransformPrivate) {
+        p_ptr(createPrivate<TransformPrivate>(this)) {
+    TransformStore::add(p_ptr);
 }
 
 Transform::~Transform() {
@@ -85,49 +32,58 @@ Transform::~Transform() {
         it->setParentTransform(nullptr, true);
     }
 
-    delete p_ptr;
+    TransformStore::remove(p_ptr);
+
+    destroyPrivate(p_ptr);
 }
 /*!
     Returns current position of the Transform in local space.
 */
 Vector3 &Transform::position() const {
-    return p_ptr->m_Position;
+    return p_ptr->m_pChunk->m_Position[p_ptr->m_Slot];
 }
 /*!
     Changes \a position of the Transform in local space.
 */
 void Transform::setPosition(const Vector3 &position) {
-    unique_lock<mutex> locker(p_ptr->m_Mutex);
-    p_ptr->m_Position = position;
+    {
+        unique_lock<mutex> locker(p_ptr->m_pChunk->m_Mutex);
+        p_ptr->m_pChunk->m_Position[p_ptr->m_Slot] = position;
+    }
     setDirty();
 }
 /*!
     Returns current rotation of the Transform in local space as Euler angles in degrees.
 */
 Vector3 &Transform::rotation() const {
-    return p_ptr->m_Rotation;
+    return p_ptr->m_pChunk->m_Rotation[p_ptr->m_Slot];
 }
 /*!
     Changes the rotation of the Transform in local space by provided Euler \a angles in degrees.
 */
 void Transform::setRotation(const Vector3 &angles) {
-    unique_lock<mutex> locker(p_ptr->m_Mutex);
-    p_ptr->m_Rotation = angles;
-    p_ptr->m_Quaternion = Quaternion(p_ptr->m_Rotation);
+    Quaternion quaternion(angles);
+    {
+        unique_lock<mutex> locker(p_ptr->m_pChunk->m_Mutex);
+        p_ptr->m_pChunk->m_Rotation[p_ptr->m_Slot] = angles;
+        p_ptr->m_pChunk->m_Quaternion[p_ptr->m_Slot] = quaternion;
+    }
     setDirty();
 }
 /*!
     Returns current rotation of the Transform in local space as Quaternion.
 */
 Quaternion &Transform::quaternion() const {
-    return p_ptr->m_Quaternion;
+    return p_ptr->m_pChunk->m_Quaternion[p_ptr->m_Slot];
 }
 /*!
     Changes the rotation \a quaternion of the Transform in local space by provided Quaternion.
 */
 void Transform::setQuaternion(const Quaternion &quaternion) {
-    unique_lock<mutex> locker(p_ptr->m_Mutex);
-    p_ptr->m_Quaternion = quaternion;
+    {
+        unique_lock<mutex> locker(p_ptr->m_pChunk->m_Mutex);
+        p_ptr->m_pChunk->m_Quaternion[p_ptr->m_Slot] = quaternion;
+    }
 #ifdef NEXT_SHARED
     //p_ptr->m_Rotation = p_ptr->m_Quaternion.euler();
 #endif
@@ -137,14 +93,16 @@ void Transform::setQuaternion(const Quaternion &quaternion) {
     Returns current scale of the Transform in local space.
 */
 Vector3 &Transform::scale() const {
-    return p_ptr->m_Scale;
+    return p_ptr->m_pChunk->m_Scale[p_ptr->m_Slot];
 }
 /*!
     Changes the \a scale of the Transform in local space.
 */
 void Transform::setScale(const Vector3 &scale) {
-    unique_lock<mutex> locker(p_ptr->m_Mutex);
-    p_ptr->m_Scale = scale;
+    {
+        unique_lock<mutex> locker(p_ptr->m_pChunk->m_Mutex);
+        p_ptr->m_pChunk->m_Scale[p_ptr->m_Slot] = scale;
+    }
     setDirty();
 }
 /*!
@@ -180,71 +138,118 @@ void Transform::setParentTransform(Transform *parent, bool force) {
     p_ptr->m_pParent = parent;
     if(p_ptr->m_pParent) {
         p_ptr->m_pParent->p_ptr->m_Children.push_back(this);
+    }
+    TransformStore::setParent(p_ptr, parent ? parent->p_ptr : nullptr);
+
+    if(p_ptr->m_pParent) {
         if(!force) {
             Vector3 scale = p_ptr->m_pParent->worldScale();
             scale = Vector3(1.0f / scale.x, 1.0f / scale.y, 1.0f / scale.z);
 
-            p_ptr->m_Position = p_ptr->m_pParent->worldQuaternion().inverse() * ((p - p_ptr->m_pParent->worldPosition()) * scale);
-            p_ptr->m_Scale = s * scale;
+            setPosition(p_ptr->m_pParent->worldQuaternion().inverse() * ((p - p_ptr->m_pParent->worldPosition()) * scale));
+            setScale(s * scale);
             setRotation(e - p_ptr->m_pParent->worldRotation());
         } else {
             setDirty();
         }
+    } else {
+        setDirty();
     }
 }
 /*!
     Returns current transform matrix in local space.
 */
 Matrix4 &Transform::localTransform() const {
-    if(p_ptr->m_Dirty) {
-        p_ptr->cleanDirty();
+    if(TransformStore::isDirty(p_ptr)) {
+        TransformStore::clean(p_ptr);
     }
-    return p_ptr->m_Transform;
+    return p_ptr->m_pChunk->m_Transform[p_ptr->m_Slot];
 }
 /*!
     Returns current transform matrix in world space.
 */
 Matrix4 &Transform::worldTransform() const {
-    if(p_ptr->m_Dirty) {
-        p_ptr->cleanDirty();
+    if(TransformStore::isDirty(p_ptr)) {
+        TransformStore::clean(p_ptr);
     }
-    return p_ptr->m_WorldTransform;
+    return p_ptr->m_pChunk->m_WorldTransform[p_ptr->m_Slot];
 }
 /*!
     Returns current position of the transform in world space.
 */
 Vector3 &Transform::worldPosition() const {
-    if(p_ptr->m_Dirty) {
-        p_ptr->cleanDirty();
+    if(TransformStore::isDirty(p_ptr)) {
+        TransformStore::clean(p_ptr);
     }
-    return p_ptr->m_WorldPosition;
+    return p_ptr->m_pChunk->m_WorldPosition[p_ptr->m_Slot];
 }
 /*!
     Returns current rotation of the transform in world space as Euler angles in degrees.
 */
 Vector3 &Transform::worldRotation() const {
-    if(p_ptr->m_Dirty) {
-        p_ptr->cleanDirty();
+    if(TransformStore::isDirty(p_ptr)) {
+        TransformStore::clean(p_ptr);
     }
-    return p_ptr->m_WorldRotation;
+    return p_ptr->m_pChunk->m_WorldRotation[p_ptr->m_Slot];
 }
 /*!
     Returns current rotation of the transform in world space as Quaternion.
 */
 Quaternion &Transform::worldQuaternion() const {
-    if(p_ptr->m_Dirty) {
-        p_ptr->cleanDirty();
+    if(TransformStore::isDirty(p_ptr)) {
+        TransformStore::clean(p_ptr);
     }
-    return p_ptr->m_WorldQuaternion;
+    return p_ptr->m_pChunk->m_WorldQuaternion[p_ptr->m_Slot];
 }
 /*!
     Returns current scale of the transform in world space.
 */
 Vector3 &Transform::worldScale() const {
-    if(p_ptr->m_Dirty) {
-        p_ptr->cleanDirty();
+    if(TransformStore::isDirty(p_ptr)) {
+        TransformStore::clean(p_ptr);
     }
-    return p_ptr->m_WorldScale;
+    return p_ptr->m_pChunk->m_WorldScale[p_ptr->m_Slot];
+}
+/*!
+    Returns the world position blended between the two last fixed simulation steps by the \a alpha factor.
+    Usually, the factor is provided by Timer::interpolation().
+    Returns the current world position in case of no fixed step was stored for the transform.
+*/
+Vector3 Transform::interpolatedPosition(float alpha) const {
+    const TransformChunk *chunk = p_ptr->m_pChunk;
+    uint32_t slot = p_ptr->m_Slot;
+    if(!chunk->m_Fixed[slot]) {
+        return worldPosition();
+    }
+    return MIX(chunk->m_FixedPosition[0][slot], chunk->m_FixedPosition[1][slot], alpha);
+}
+/*!
+    Returns the world rotation as Quaternion blended between the two last fixed simulation steps by the \a alpha factor.
+    Returns the current world rotation in case of no fixed step was stored for the transform.
+*/
+Quaternion Transform::interpolatedQuaternion(float alpha) const {
+    const TransformChunk *chunk = p_ptr->m_pChunk;
+    uint32_t slot = p_ptr->m_Slot;
+    if(!chunk->m_Fixed[slot]) {
+        return worldQuaternion();
+    }
+    Quaternion result;
+    result.mix(chunk->m_FixedQuaternion[0][slot], chunk->m_FixedQuaternion[1][slot], alpha);
+    return result;
+}
+/*!
+    Returns the world transform matrix blended between the two last fixed simulation steps by the \a alpha factor.
+    It allows to render and listen the objects which are moved by the fixed steps smoothly, independently from the frame rate.
+    Returns the current world transform in case of no fixed step was stored for the transform.
+*/
+Matrix4 Transform::interpolatedTransform(float alpha) const {
+    const TransformChunk *chunk = p_ptr->m_pChunk;
+    uint32_t slot = p_ptr->m_Slot;
+    if(!chunk->m_Fixed[slot]) {
+        return worldTransform();
+    }
+    return Matrix4(interpolatedPosition(alpha), interpolatedQuaternion(alpha),
+                   MIX(chunk->m_FixedScale[0][slot], chunk->m_FixedScale[1][slot], alpha));
 }
 /*!
     Makes the Transform a child of \a parent at given \a position.
@@ -269,8 +274,5 @@ list<Transform *> &Transform::children() const {
     \internal
 */
 void Transform::setDirty() {
-    p_ptr->m_Dirty = true;
-    for(auto it : p_ptr->m_Children) {
-        it->setDirty();
-    }
+    TransformStore::setDirty(p_ptr);
 }
@@ -94,7 +94,7 @@ AABBox EditorTool::objectBound() {
     if(!m_Selected.empty()) {
         for(auto &it : m_Selected) {
             if(it.renderable == nullptr) {
-                it.renderable = dynamic_cast<Renderable *>(it.object->component("Renderable"));
+                it.renderable = it.object->findComponent<Renderable>();
             }
             if(it.renderable) {
                 if(first) {
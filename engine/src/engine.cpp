@@ -2,6 +2,9 @@
 
 #include <string>
 #include <sstream>
+#include <chrono>
+#include <algorithm>
+#include <mutex>
 
 #include <log.h>
 #include <file.h>
@@ -12,6 +15,9 @@
 #include <metatype.h>
 #include <uri.h>
 #include <threadpool.h>
+#include <framearena.h>
+
+#include <analytics/performancecounter.h>
 
 #include "module.h"
 #include "system.h"
@@ -26,6 +32,10 @@
 #include "components/armature.h"
 
 #include "components/animationcontroller.h"
+#include "components/nativebehaviour.h"
+#include "components/renderable.h"
+
+#include "components/private/transformstore.h"
 
 #ifdef THUNDER_MOBILE
     #include "adapters/mobileadaptor.h"
@@ -48,6 +58,7 @@
 #include "resources/map.h"
 
 #include "systems/resourcesystem.h"
+#include "systems/rendersystem.h"
 
 #include "log.h"
 
@@ -60,12 +71,38 @@ static const char *gSettings("settings");
 static const char *gEntry(".entry");
 static const char *gCompany(".company");
 static const char *gProject(".project");
+static const char *gTrace(".trace");
 
 static const char *TRANSFORM("Transform");
 
 #define INDEX_VERSION 2
 
+#define BEHAVIOUR_GRAIN 64
+
 class EnginePrivate {
+public:
+    typedef chrono::steady_clock::time_point TimePoint;
+
+    struct SystemTask {
+        System             *system;
+
+        Scene              *scene;
+
+        int                 phase;
+
+        Job                 job;
+
+        vector<Job>         dependencies;
+    };
+    typedef vector<SystemTask> TaskList;
+
+    enum BehaviourPhase {
+        FixedUpdate = 0,
+        Update,
+        LateUpdate,
+        FixedStore
+    };
+
 public:
     EnginePrivate() :
             m_pScene(nullptr) {
@@ -80,23 +117,294 @@ public:
             delete m_pPlatform;
         }
 
-        //for(auto it : m_Pool) {
+        //for(auto it : m_Systems) {
         //    delete it;
         //}
-        m_Pool.clear();
+        m_Systems.clear();
+    }
 
-        //for(auto it : m_Serial) {
-        //    delete it;
-        //}
-        m_Serial.clear();
+    static bool isConflicting(const System *first, const System *second) {
+        if(first == nullptr || second == nullptr) { // Behaviours can touch everything
+            return true;
+        }
+        return (first->writes() & (second->reads() | second->writes())) || (second->writes() & first->reads());
+    }
+
+    static void execute(System *system, Scene *scene, const TimePoint &frame) {
+        TimePoint begin = chrono::steady_clock::now();
+
+        system->setActiveScene(scene);
+        system->processEvents();
+
+        TimePoint end = chrono::steady_clock::now();
+        system->m_UpdateOffset.store(static_cast<uint32_t>(chrono::duration_cast<chrono::microseconds>(begin - frame).count()), memory_order_relaxed);
+        system->m_UpdateTime.store(static_cast<uint32_t>(chrono::duration_cast<chrono::microseconds>(end - begin).count()), memory_order_relaxed);
+    }
+
+    void addDependencies(SystemTask &task, const TaskList &list) {
+        for(auto &it : list) {
+            if(it.system == task.system || isConflicting(it.system, task.system)) {
+                m_ThreadPool.addDependency(task.job, it.job);
+                task.dependencies.push_back(it.job);
+            }
+        }
+    }
+
+    static int order(const System *system) {
+        // Fixed steps are executed at the beginning of the frame
+        return (system->phase() == System::FixedUpdate) ? -1 : system->phase();
+    }
+
+    static bool isMain(const SystemTask &task) {
+        return (task.system == nullptr || task.system->threadPolicy() != System::Pool);
+    }
+
+    void addTask(System *system, Scene *scene, const TimePoint &frame, int phase = Update) {
+        SystemTask task;
+        task.system = system;
+        task.scene = scene;
+        task.phase = phase;
+        if(isMain(task)) {
+            task.job = m_ThreadPool.createJob(ThreadPool::JobFunction());
+        } else {
+            task.job = m_ThreadPool.createJob([system, scene, frame]() {
+                execute(system, scene, frame);
+            });
+        }
+        addDependencies(task, m_Tasks);
+
+        m_Tasks.push_back(task);
+    }
+
+    void schedule(Scene *scene) {
+        TimePoint frame = chrono::steady_clock::now();
+
+        m_Tasks.clear();
+        // The tasks without system are sync points to execute NativeBehaviour phases
+        // The accumulated time is consumed in the editor mode too, otherwise it grows until the game starts
+        uint32_t steps = Timer::consumeFixedSteps();
+        if(!m_Game) {
+            steps = 0;
+        }
+        for(uint32_t i = 0; i < steps; i++) {
+            addTask(nullptr, scene, frame, FixedUpdate);
+            for(auto it : m_Systems) {
+                if(it->phase() == System::FixedUpdate) {
+                    addTask(it, scene, frame);
+                }
+            }
+            // The result of each step is kept to blend the last two steps by Timer::interpolation()
+            addTask(nullptr, scene, frame, FixedStore);
+        }
+        if(m_Game) {
+            addTask(nullptr, scene, frame, Update);
+        }
+        // The LateUpdate sync point is added in the editor mode too, world transforms are recalculated there
+        bool late = false;
+        for(auto it : m_Systems) {
+            if(m_Game && it->phase() == System::FixedUpdate) {
+                continue;
+            }
+            if(!late && order(it) > System::Update) {
+                addTask(nullptr, scene, frame, LateUpdate);
+                late = true;
+            }
+            addTask(it, scene, frame);
+        }
+        if(!late) {
+            addTask(nullptr, scene, frame, LateUpdate);
+        }
+
+        for(auto &it : m_Tasks) {
+            if(!isMain(it)) {
+                m_ThreadPool.run(it.job);
+            }
+        }
+    }
+
+    void executeMain(SystemTask &task, const TimePoint &frame) {
+        for(auto &it : task.dependencies) {
+            m_ThreadPool.wait(it);
+        }
+        if(task.system) {
+            execute(task.system, task.scene, frame);
+        } else if(task.phase == FixedStore) {
+            TransformStore::update(&m_ThreadPool);
+            TransformStore::storeFixedStep();
+        } else {
+            if(m_Game) {
+                executeBehaviours(task.scene, task.phase);
+            }
+            if(task.phase == LateUpdate) {
+                TransformStore::update(&m_ThreadPool);
+                extractSnapshots(task.scene);
+            }
+        }
+        m_ThreadPool.run(task.job);
+    }
+
+    static bool isActive(NativeBehaviour *behaviour, Scene *scene) {
+        if(behaviour->system() != m_pInstance) { // Handled by own system
+            return false;
+        }
+        Actor *actor = behaviour->actor();
+        return (actor && actor->scene() == scene);
+    }
+
+    static void invoke(NativeBehaviour *behaviour, int phase) {
+        switch(phase) {
+            case FixedUpdate: behaviour->fixedUpdate(); break;
+            case LateUpdate: behaviour->lateUpdate(); break;
+            default: behaviour->update(); break;
+        }
+    }
+
+    static void addBehaviour(NativeBehaviour *behaviour) {
+        unique_lock<mutex> locker(m_BehaviourMutex);
+        if(behaviour->m_Index < 0) {
+            behaviour->m_Index = static_cast<int32_t>(m_Behaviours.size());
+            m_Behaviours.push_back(behaviour);
+        }
+    }
+
+    static void removeBehaviour(NativeBehaviour *behaviour) {
+        unique_lock<mutex> locker(m_BehaviourMutex);
+        if(behaviour->m_Index >= 0) {
+            if(m_BehaviourExecution) {
+                // The list is compacted after the execution, so it's safe to remove behaviours from the executed ones
+                m_Behaviours[behaviour->m_Index] = nullptr;
+                m_BehaviourHoles = true;
+            } else {
+                NativeBehaviour *last = m_Behaviours.back();
+                last->m_Index = behaviour->m_Index;
+                m_Behaviours[last->m_Index] = last;
+                m_Behaviours.pop_back();
+            }
+            behaviour->m_Index = -1;
+        }
+    }
+
+    static void setBehaviourExecution(bool execution) {
+        unique_lock<mutex> locker(m_BehaviourMutex);
+        m_BehaviourExecution = execution;
+        if(!execution && m_BehaviourHoles) {
+            int32_t index = 0;
+            for(auto it : m_Behaviours) {
+                if(it) {
+                    it->m_Index = index;
+                    m_Behaviours[index] = it;
+                    index++;
+                }
+            }
+            m_Behaviours.resize(index);
+            m_BehaviourHoles = false;
+        }
+    }
+
+    static NativeBehaviour *behaviour(size_t index) {
+        unique_lock<mutex> locker(m_BehaviourMutex);
+        return (index < m_Behaviours.size()) ? m_Behaviours[index] : nullptr;
+    }
+
+    static size_t behavioursCount() {
+        unique_lock<mutex> locker(m_BehaviourMutex);
+        return m_Behaviours.size();
+    }
+
+    void executeBehaviours(Scene *scene, int phase) {
+        setBehaviourExecution(true);
+
+        // The list isn't compacted during the execution, so the indices stay valid while behaviours are added or removed
+        // Behaviours created during the start will be started in the same pass
+        for(size_t i = 0; i < behavioursCount(); i++) {
+            NativeBehaviour *it = behaviour(i);
+            if(it && !it->isStarted() && isActive(it, scene)) {
+                it->start();
+                it->setStarted(true);
+            }
+        }
+
+        size_t count = 0;
+
+        m_Parallel.clear();
+        {
+            unique_lock<mutex> locker(m_BehaviourMutex);
+            count = m_Behaviours.size();
+            for(size_t i = 0; i < count; i++) {
+                NativeBehaviour *it = m_Behaviours[i];
+                if(it && it->isParallelSafe() && isActive(it, scene)) {
+                    m_Parallel.push_back(it);
+                }
+            }
+        }
+        if(!m_Parallel.empty()) {
+            Job job = m_ThreadPool.parallelFor(static_cast<uint32_t>(m_Parallel.size()), BEHAVIOUR_GRAIN, [this, phase](uint32_t begin, uint32_t end) {
+                for(uint32_t i = begin; i < end; i++) {
+                    invoke(m_Parallel[i], phase);
+                }
+            });
+            m_ThreadPool.wait(job);
+        }
+        // Behaviours can be deleted by the previous ones, so the list must be checked on each step
+        for(size_t i = 0; i < count; i++) {
+            NativeBehaviour *it = behaviour(i);
+            if(it && it->isStarted() && !it->isParallelSafe() && isActive(it, scene)) {
+                invoke(it, phase);
+            }
+        }
+
+        setBehaviourExecution(false);
+    }
+
+    void extractSnapshots(Scene *scene) {
+        // Render reads only the snapshots, the live components can be changed while it draws
+        // Each scene extracts only own renderables, so every renderable is extracted once per frame
+        m_Parallel.clear();
+        {
+            unique_lock<mutex> locker(m_BehaviourMutex);
+            for(auto it : m_Behaviours) {
+                if(it && it->isRenderable()) {
+                    Actor *actor = it->actor();
+                    if(actor && actor->scene() == scene) {
+                        m_Parallel.push_back(it);
+                    }
+                }
+            }
+        }
+        if(!m_Parallel.empty()) {
+            Job job = m_ThreadPool.parallelFor(static_cast<uint32_t>(m_Parallel.size()), BEHAVIOUR_GRAIN, [this](uint32_t begin, uint32_t end) {
+                for(uint32_t i = begin; i < end; i++) {
+                    static_cast<Renderable *>(m_Parallel[i])->extractSnapshot();
+                }
+            });
+            m_ThreadPool.wait(job);
+        }
+        for(auto it : m_Systems) {
+            RenderSystem *render = dynamic_cast<RenderSystem *>(it);
+            if(render) {
+                render->setSnapshotsExtracted(true);
+            }
+        }
+    }
+
+    void complete() {
+        TimePoint frame = chrono::steady_clock::now();
+        for(auto &it : m_Tasks) {
+            if(isMain(it)) {
+                executeMain(it, frame);
+            }
+        }
+        for(auto &it : m_Tasks) {
+            m_ThreadPool.wait(it.job);
+        }
+        m_Tasks.clear();
     }
 
     Scene                   *m_pScene;
 
     static Engine           *m_pInstance;
 
-    static list<System *>    m_Pool;
-    static list<System *>    m_Serial;
+    static list<System *>    m_Systems;
 
     static File             *m_pFile;
 
@@ -118,6 +426,18 @@ public:
 
     ThreadPool               m_ThreadPool;
 
+    TaskList                 m_Tasks;
+
+    vector<NativeBehaviour *> m_Parallel;
+
+    static vector<NativeBehaviour *> m_Behaviours;
+
+    static mutex             m_BehaviourMutex;
+
+    static bool              m_BehaviourHoles;
+
+    static bool              m_BehaviourExecution;
+
     static ResourceSystem   *m_pResourceSystem;
 
     static Translator       *m_pTranslator;
@@ -136,8 +456,12 @@ ResourceSystem   *EnginePrivate::m_pResourceSystem = nullptr;
 Translator       *EnginePrivate::m_pTranslator = nullptr;
 Engine           *EnginePrivate::m_pInstance = nullptr;
 
-list<System *>   EnginePrivate::m_Pool;
-list<System *>   EnginePrivate::m_Serial;
+list<System *>   EnginePrivate::m_Systems;
+
+vector<NativeBehaviour *> EnginePrivate::m_Behaviours;
+mutex            EnginePrivate::m_BehaviourMutex;
+bool             EnginePrivate::m_BehaviourHoles = false;
+bool             EnginePrivate::m_BehaviourExecution = false;
 
 typedef Vector4 Color;
 
@@ -184,7 +508,7 @@ Engine::Engine(File *file, const char *path) :
     EnginePrivate::m_pInstance = this;
 
     EnginePrivate::m_pResourceSystem = new ResourceSystem;
-    EnginePrivate::m_Serial.push_back(p_ptr->m_pResourceSystem);
+    EnginePrivate::m_Systems.push_back(p_ptr->m_pResourceSystem);
     EnginePrivate::m_ApplicationPath = path;
     Uri uri(EnginePrivate::m_ApplicationPath);
     EnginePrivate::m_ApplicationDir = uri.dir();
@@ -260,6 +584,7 @@ bool Engine::init() {
 /*!
     Starts the main game cycle.
     Also this method loads the first level of your game.
+    When the engine is built with the profiler, the recorded zones are exported on exit to the file set by the ".trace" setting.
     Returns true if successful; otherwise returns false.
 */
 bool Engine::start() {
@@ -267,14 +592,7 @@ bool Engine::start() {
 
     p_ptr->m_pPlatform->start();
 
-    for(auto it : EnginePrivate::m_Pool) {
-        if(!it->init()) {
-            Log(Log::ERR) << "Failed to initialize system:" << it->name();
-            p_ptr->m_pPlatform->stop();
-            return false;
-        }
-    }
-    for(auto it : EnginePrivate::m_Serial) {
+    for(auto it : EnginePrivate::m_Systems) {
         if(!it->init()) {
             Log(Log::ERR) << "Failed to initialize system:" << it->name();
             p_ptr->m_pPlatform->stop();
@@ -317,6 +635,12 @@ bool Engine::start() {
         update(p_ptr->m_pScene);
     }
     p_ptr->m_pPlatform->stop();
+#if defined(PROFILING_ENABLED) && !defined(BUILD_WITH_EASY_PROFILER)
+    string trace = value(gTrace, "").toString();
+    if(!trace.empty() && !Profiler::exportTrace(trace)) {
+        Log(Log::ERR) << "Unable to export the trace to" << trace.c_str();
+    }
+#endif
 #endif
     return true;
 }
@@ -334,24 +658,32 @@ void Engine::resize() {
 /*!
     This method launches all your game modules responsible for processing all the game logic.
     It calls on each iteration of the game cycle for the provided \a scene.
+
+    Systems are executed as a dependency graph built from System::phase(), System::reads() and System::writes().
+    Systems with System::Main thread policy are executed in the current thread, others are executed in the thread pool.
+
+    In game mode the frame starts from the fixed steps consumed from the Timer. For each fixed step NativeBehaviour::fixedUpdate() is executed, followed by the systems of System::FixedUpdate phase.
+    The world state of transforms is stored after each step, so the last two steps can be blended by Timer::interpolation(), see Transform::interpolatedTransform().
+    Then NativeBehaviour::update() is executed before the other systems, and NativeBehaviour::lateUpdate() is executed between the System::Update and System::PostUpdate phases.
+    Behaviours are executed in the main thread, except the parallel-safe ones which are executed in batches by the thread pool.
+
+    At the end of the frame all PerformanceCounter values are moved to their history and the FrameArena is switched to the next frame.
     \note Usually, this method calls internally and must not be called manually.
 */
 void Engine::update(Scene *scene) {
     PROFILE_FUNCTION();
+    PROFILE_FRAME_BEGIN;
 
     processEvents();
 
-    for(auto it : EnginePrivate::m_Pool) {
-        it->setActiveScene(scene);
-        p_ptr->m_ThreadPool.start(*it);
-    }
-    for(auto it : EnginePrivate::m_Serial) {
-        it->setActiveScene(scene);
-        it->processEvents();
-    }
-    p_ptr->m_ThreadPool.waitForDone();
+    p_ptr->schedule(scene);
+    p_ptr->complete();
 
     p_ptr->m_pPlatform->update();
+
+    FrameArena::nextFrame();
+    PerformanceCounter::frameEnd();
+    PROFILE_FRAME_END;
 }
 /*!
     \internal
@@ -360,19 +692,20 @@ void Engine::processEvents() {
     PROFILE_FUNCTION();
 
     ObjectSystem::processEvents();
-
-    if(isGameMode()) {
-        for(auto it : m_ObjectList) {
-            NativeBehaviour *comp = dynamic_cast<NativeBehaviour *>(it);
-            if(comp && comp->isEnabled() && comp->actor() && comp->actor()->scene() == p_ptr->m_pScene) {
-                if(!comp->isStarted()) {
-                    comp->start();
-                    comp->setStarted(true);
-                }
-                comp->update();
-            }
-        }
-    }
+}
+/*!
+    \internal
+    Registers the enabled \a behaviour for the execution.
+*/
+void Engine::addNativeBehaviour(NativeBehaviour *behaviour) {
+    EnginePrivate::addBehaviour(behaviour);
+}
+/*!
+    \internal
+    Removes the \a behaviour from the execution.
+*/
+void Engine::removeNativeBehaviour(NativeBehaviour *behaviour) {
+    EnginePrivate::removeBehaviour(behaviour);
 }
 /*!
     \internal
@@ -414,10 +747,7 @@ void Engine::setValue(const string &key, const Variant &value) {
 void Engine::syncValues() {
     PROFILE_FUNCTION();
 
-    for(auto it : EnginePrivate::m_Pool) {
-        it->syncSettings();
-    }
-    for(auto it : EnginePrivate::m_Serial) {
+    for(auto it : EnginePrivate::m_Systems) {
         it->syncSettings();
     }
 
@@ -517,7 +847,7 @@ bool Engine::reloadBundle() {
         file->fread(&data[0], data.size(), 1, fp);
         file->fclose(fp);
 
-        Variant var = Json::load(string(data.begin(), data.end()));
+        Variant var = Json::load(reinterpret_cast<const char *>(data.data()), data.size());
         if(var.isValid()) {
             VariantMap root = var.toMap();
 
@@ -551,6 +881,13 @@ bool Engine::reloadBundle() {
 System *Engine::resourceSystem() {
     return EnginePrivate::m_pResourceSystem;
 }
+/*!
+    Returns the thread pool which is used to execute the systems.
+    Systems and modules can split their own work to the jobs using this pool.
+*/
+ThreadPool *Engine::threadPool() {
+    return &EnginePrivate::m_pInstance->p_ptr->m_ThreadPool;
+}
 /*!
     Returns true if game started; otherwise returns false.
 */
@@ -580,11 +917,10 @@ void Engine::addModule(Module *module) {
     PROFILE_FUNCTION();
     if(module->types() & Module::SYSTEM) {
         System *system = module->system();
-        if(system->threadPolicy() == System::Pool) {
-            EnginePrivate::m_Pool.push_back(system);
-        } else {
-            EnginePrivate::m_Serial.push_back(system);
-        }
+        auto it = upper_bound(EnginePrivate::m_Systems.begin(), EnginePrivate::m_Systems.end(), system, [](const System *left, const System *right) {
+            return EnginePrivate::order(left) < EnginePrivate::order(right);
+        });
+        EnginePrivate::m_Systems.insert(it, system);
     }
 }
 /*!
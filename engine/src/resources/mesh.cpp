@@ -7,23 +7,164 @@
 
 #include <cstring>
 #include <cfloat>
+#include <mutex>
 
 #define HEADER      "Header"
 #define DATA        "Data"
 #define DEFAULTMESH ".embedded/DefaultMesh.mtl"
 
+static mutex gDecodeMutex;
+
+enum VertexFormats {
+    Separated   = 0,
+    Interleaved,
+    Quantized
+};
+
+static uint16_t toHalf(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(float));
+
+    uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+    int32_t exponent = static_cast<int32_t>((bits >> 23) & 0xFF) - 127 + 15;
+    uint32_t mantissa = bits & 0x007FFFFF;
+
+    if(exponent <= 0) {
+        return sign; // Too small values are flushed to zero
+    }
+    if(exponent >= 31) {
+        return sign | 0x7C00; // Infinity
+    }
+    uint32_t result = (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+    result += (mantissa >> 12) & 1; // Round to nearest
+    return sign | static_cast<uint16_t>(MIN(result, 0x7BFFu));
+}
+
+static float fromHalf(uint16_t value) {
+    uint32_t sign = static_cast<uint32_t>(value & 0x8000) << 16;
+    uint32_t exponent = (value >> 10) & 0x1F;
+    uint32_t mantissa = value & 0x03FF;
+
+    uint32_t bits = sign;
+    if(exponent == 31) {
+        bits |= 0x7F800000 | (mantissa << 13);
+    } else if(exponent != 0) {
+        bits |= ((exponent - 15 + 127) << 23) | (mantissa << 13);
+    }
+    float result;
+    memcpy(&result, &bits, sizeof(float));
+    return result;
+}
+
+static void packFloats(int8_t *dst, const float *src, uint32_t count, bool quantize) {
+    if(quantize) {
+        uint16_t *half = reinterpret_cast<uint16_t *>(dst);
+        for(uint32_t i = 0; i < count; i++) {
+            half[i] = toHalf(src[i]);
+        }
+    } else {
+        memcpy(dst, src, sizeof(float) * count);
+    }
+}
+
+static void unpackFloats(float *dst, const int8_t *src, uint32_t count, bool quantized) {
+    if(quantized) {
+        // The source can be a slice of the shared buffer without any alignment
+        for(uint32_t i = 0; i < count; i++) {
+            uint16_t half;
+            memcpy(&half, src + sizeof(uint16_t) * i, sizeof(uint16_t));
+            dst[i] = fromHalf(half);
+        }
+    } else {
+        memcpy(dst, src, sizeof(float) * count);
+    }
+}
+
+/*!
+    \class VertexLayout
+    \brief Describes the interleaved vertex stream of a packed Lod.
+    \inmodule Resources
+
+    Each vertex starts with a position stored as three floats, followed by enabled attributes in the fixed order:
+    normals, tangents, uv0, uv1, colors, weights and bones.
+    Quantized layout stores normals, tangents and texture coordinates as half floats, colors as normalized bytes,
+    weights as normalized shorts and bone indices as shorts. All offsets are four byte aligned.
+*/
+/*!
+    Constructs a layout for the attributes enabled in \a flags. The \a quantized argument selects compact attribute types.
+*/
+VertexLayout::VertexLayout(int flags, bool quantized) :
+        stride(sizeof(Vector3)),
+        normals(0),
+        tangents(0),
+        uv0(0),
+        uv1(0),
+        colors(0),
+        weights(0),
+        bones(0),
+        quantized(quantized) {
+
+    uint32_t vector2 = (quantized) ? sizeof(uint16_t) * 2 : sizeof(Vector2);
+    uint32_t vector3 = (quantized) ? sizeof(uint16_t) * 4 : sizeof(Vector3);
+
+    if(flags & Mesh::Normals) {
+        normals = stride;
+        stride += vector3;
+    }
+    if(flags & Mesh::Tangents) {
+        tangents = stride;
+        stride += vector3;
+    }
+    if(flags & Mesh::Uv0) {
+        uv0 = stride;
+        stride += vector2;
+    }
+    if(flags & Mesh::Uv1) {
+        uv1 = stride;
+        stride += vector2;
+    }
+    if(flags & Mesh::Color) {
+        colors = stride;
+        stride += (quantized) ? sizeof(uint8_t) * 4 : sizeof(Vector4);
+    }
+    if(flags & Mesh::Skinned) {
+        weights = stride;
+        stride += (quantized) ? sizeof(uint16_t) * 4 : sizeof(Vector4);
+        bones = stride;
+        stride += (quantized) ? sizeof(uint16_t) * 4 : sizeof(Vector4);
+    }
+}
+
 /*!
     \class Lod
     \brief This class contains all necessary data of Level Of Detail for the Mesh.
     \inmodule Resources
+
+    Const accessors of a packed Lod decode the streams once to the cache and keep the Lod packed, so they can be called from any thread.
+    Non-const accessors return modifiable arrays, so they convert the Lod to the separate attributes.
 */
 
 Lod::Lod() :
+    m_VertexCount(0),
+    m_IndexCount(0),
+    m_PackedFlags(0),
+    m_Quantized(false),
+    m_Decoded(false),
     m_Material(nullptr) {
 
 }
 
 bool Lod::operator== (const Lod &right) const {
+    if(isPacked() && right.isPacked()) {
+        return (m_Material == right.m_Material) &&
+               (m_PackedFlags == right.m_PackedFlags) &&
+               (m_Quantized == right.m_Quantized) &&
+               (m_PackedVertices == right.m_PackedVertices) &&
+               (m_PackedIndices == right.m_PackedIndices);
+    }
+    decode();
+    right.decode();
+
     return (m_Material == right.m_Material) &&
            (m_Indices == right.m_Indices) &&
            (m_Colors == right.m_Colors) &&
@@ -52,115 +193,434 @@ void Lod::setMaterial(Material *material) {
     Returns an array of mesh indices for the particular Lod.
 */
 IndexVector &Lod::indices() {
+    unpack();
+    return m_Indices;
+}
+/*!
+    Returns an array of mesh indices for the particular Lod without conversion of the packed Lod.
+*/
+const IndexVector &Lod::indices() const {
+    decode();
     return m_Indices;
 }
 /*!
     Sets an array of mesh \a indices for the particular Lod.
 */
 void Lod::setIndices(const IndexVector &indices) {
+    unpack();
     m_Indices = indices;
 }
 /*!
     Returns an array of colors for vertices for the particular Lod.
 */
 Vector4Vector &Lod::colors() {
+    unpack();
+    return m_Colors;
+}
+/*!
+    Returns an array of colors for vertices for the particular Lod without conversion of the packed Lod.
+*/
+const Vector4Vector &Lod::colors() const {
+    decode();
     return m_Colors;
 }
 /*!
     Sets an array of \a colors for vertices for the particular Lod.
 */
 void Lod::setColors(const Vector4Vector &colors) {
+    unpack();
     m_Colors = colors;
 }
 /*!
     Returns an array of bone weights for the particular Lod.
 */
 Vector4Vector &Lod::weights() {
+    unpack();
+    return m_Weights;
+}
+/*!
+    Returns an array of bone weights for the particular Lod without conversion of the packed Lod.
+*/
+const Vector4Vector &Lod::weights() const {
+    decode();
     return m_Weights;
 }
 /*!
     Sets an array of bone \a weights for the particular Lod.
 */
 void Lod::setWeights(const Vector4Vector &weights) {
+    unpack();
     m_Weights = weights;
 }
 /*!
     Returns an array of bones for vertices for the particular Lod.
 */
 Vector4Vector &Lod::bones() {
+    unpack();
+    return m_Bones;
+}
+/*!
+    Returns an array of bones for vertices for the particular Lod without conversion of the packed Lod.
+*/
+const Vector4Vector &Lod::bones() const {
+    decode();
     return m_Bones;
 }
 /*!
     Sets an array of \a bones for vertices for the particular Lod.
 */
 void Lod::setBones(const Vector4Vector &bones) {
+    unpack();
     m_Bones = bones;
 }
 /*!
     Returns an array of mesh vertices for the particular Lod.
 */
 Vector3Vector &Lod::vertices() {
+    unpack();
+    return m_Vertices;
+}
+/*!
+    Returns an array of mesh vertices for the particular Lod without conversion of the packed Lod.
+*/
+const Vector3Vector &Lod::vertices() const {
+    decode();
     return m_Vertices;
 }
 /*!
     Sets an array of mesh \a vertices for the particular Lod.
 */
 void Lod::setVertices(const Vector3Vector &vertices) {
+    unpack();
     m_Vertices = vertices;
 }
 /*!
     Returns an array of mesh normals for the particular Lod.
 */
 Vector3Vector &Lod::normals() {
+    unpack();
+    return m_Normals;
+}
+/*!
+    Returns an array of mesh normals for the particular Lod without conversion of the packed Lod.
+*/
+const Vector3Vector &Lod::normals() const {
+    decode();
     return m_Normals;
 }
 /*!
     Sets an array of mesh \a normals for the particular Lod.
 */
 void Lod::setNormals(const Vector3Vector &normals) {
+    unpack();
     m_Normals = normals;
 }
 /*!
     Returns an array of mesh tangents for the particular Lod.
 */
 Vector3Vector &Lod::tangents() {
+    unpack();
+    return m_Tangents;
+}
+/*!
+    Returns an array of mesh tangents for the particular Lod without conversion of the packed Lod.
+*/
+const Vector3Vector &Lod::tangents() const {
+    decode();
     return m_Tangents;
 }
 /*!
     Sets an array of mesh \a tangents for the particular Lod.
 */
 void Lod::setTangents(const Vector3Vector &tangents) {
+    unpack();
     m_Tangents = tangents;
 }
 /*!
     Returns an array of mesh uv0 (base) texture coordinates for the particular Lod.
 */
 Vector2Vector &Lod::uv0() {
+    unpack();
+    return m_Uv0;
+}
+/*!
+    Returns an array of mesh uv0 (base) texture coordinates for the particular Lod without conversion of the packed Lod.
+*/
+const Vector2Vector &Lod::uv0() const {
+    decode();
     return m_Uv0;
 }
 /*!
     Sets an array of mesh \a uv0 (base) texture coordinates for the particular Lod.
 */
 void Lod::setUv0(const Vector2Vector &uv0) {
+    unpack();
     m_Uv0 = uv0;
 }
 /*!
     Returns an array of mesh uv1 texture coordinates for the particular Lod.
 */
 Vector2Vector &Lod::uv1() {
+    unpack();
+    return m_Uv1;
+}
+/*!
+    Returns an array of mesh uv1 texture coordinates for the particular Lod without conversion of the packed Lod.
+*/
+const Vector2Vector &Lod::uv1() const {
+    decode();
     return m_Uv1;
 }
 /*!
     Sets an array of mesh \a uv1 texture coordinates for the particular Lod.
 */
 void Lod::setUv1(const Vector2Vector &uv1) {
+    unpack();
     m_Uv1 = uv1;
 }
 
+/*!
+    Returns the number of vertices for the particular Lod.
+*/
+uint32_t Lod::vertexCount() const {
+    return (isPacked()) ? m_VertexCount : m_Vertices.size();
+}
+/*!
+    Returns the number of indices for the particular Lod.
+*/
+uint32_t Lod::indexCount() const {
+    return (isPacked()) ? m_IndexCount : m_Indices.size();
+}
+/*!
+    Returns true in case of Lod data is stored in the interleaved vertex stream; otherwise returns false.
+    Packed data is uploaded to GPU as is, any modification of separate vertex attributes unpacks it.
+*/
+bool Lod::isPacked() const {
+    return !m_PackedVertices.empty();
+}
+/*!
+    Returns true in case of packed vertex stream uses the quantized VertexLayout; otherwise returns false.
+*/
+bool Lod::isQuantized() const {
+    return m_Quantized;
+}
+/*!
+    Returns the size of a single index in bytes.
+    Packed Lods use 16-bit indices when all the vertices can be addressed.
+*/
+uint32_t Lod::indexSize() const {
+    if(isPacked() && m_IndexCount > 0) {
+        return m_PackedIndices.size() / m_IndexCount;
+    }
+    return sizeof(uint32_t);
+}
+/*!
+    Returns the interleaved vertex stream for the packed Lod.
+*/
+const ByteBuffer &Lod::packedVertices() const {
+    return m_PackedVertices;
+}
+/*!
+    Returns the index stream for the packed Lod.
+*/
+const ByteBuffer &Lod::packedIndices() const {
+    return m_PackedIndices;
+}
+/*!
+    \internal
+    Moves vertex attributes enabled in \a flags to the interleaved stream. The \a quantize argument enables compact attribute types.
+*/
+void Lod::pack(int flags, bool quantize) {
+    unpack();
+
+    VertexLayout layout(flags, quantize);
+
+    m_VertexCount = m_Vertices.size();
+    m_IndexCount = m_Indices.size();
+    if(m_VertexCount == 0) {
+        return;
+    }
+
+    ByteArray vertices(layout.stride * m_VertexCount, 0);
+    for(uint32_t i = 0; i < m_VertexCount; i++) {
+        int8_t *v = &vertices[layout.stride * i];
+        memcpy(v, &m_Vertices[i], sizeof(Vector3));
+
+        if((flags & Mesh::Normals) && i < m_Normals.size()) {
+            packFloats(v + layout.normals, m_Normals[i].v, 3, quantize);
+        }
+        if((flags & Mesh::Tangents) && i < m_Tangents.size()) {
+            packFloats(v + layout.tangents, m_Tangents[i].v, 3, quantize);
+        }
+        if((flags & Mesh::Uv0) && i < m_Uv0.size()) {
+            packFloats(v + layout.uv0, m_Uv0[i].v, 2, quantize);
+        }
+        if((flags & Mesh::Uv1) && i < m_Uv1.size()) {
+            packFloats(v + layout.uv1, m_Uv1[i].v, 2, quantize);
+        }
+        if((flags & Mesh::Color) && i < m_Colors.size()) {
+            if(quantize) {
+                uint8_t *color = reinterpret_cast<uint8_t *>(v + layout.colors);
+                for(int c = 0; c < 4; c++) {
+                    color[c] = static_cast<uint8_t>(CLAMP(m_Colors[i].v[c], 0.0f, 1.0f) * 255.0f + 0.5f);
+                }
+            } else {
+                memcpy(v + layout.colors, &m_Colors[i], sizeof(Vector4));
+            }
+        }
+        if((flags & Mesh::Skinned) && i < m_Weights.size() && i < m_Bones.size()) {
+            if(quantize) {
+                uint16_t *weight = reinterpret_cast<uint16_t *>(v + layout.weights);
+                uint16_t *bone = reinterpret_cast<uint16_t *>(v + layout.bones);
+                for(int b = 0; b < 4; b++) {
+                    weight[b] = static_cast<uint16_t>(CLAMP(m_Weights[i].v[b], 0.0f, 1.0f) * 65535.0f + 0.5f);
+                    bone[b] = static_cast<uint16_t>(m_Bones[i].v[b]);
+                }
+            } else {
+                memcpy(v + layout.weights, &m_Weights[i], sizeof(Vector4));
+                memcpy(v + layout.bones, &m_Bones[i], sizeof(Vector4));
+            }
+        }
+    }
+
+    ByteArray indices;
+    if(m_VertexCount <= 0x10000) {
+        indices.resize(sizeof(uint16_t) * m_IndexCount);
+        uint16_t *index = reinterpret_cast<uint16_t *>(indices.data());
+        for(uint32_t i = 0; i < m_IndexCount; i++) {
+            index[i] = static_cast<uint16_t>(m_Indices[i]);
+        }
+    } else {
+        indices.resize(sizeof(uint32_t) * m_IndexCount);
+        memcpy(indices.data(), m_Indices.data(), sizeof(uint32_t) * m_IndexCount);
+    }
+
+    m_PackedVertices = ByteBuffer(std::move(vertices));
+    m_PackedIndices = ByteBuffer(std::move(indices));
+    m_PackedFlags = flags;
+    m_Quantized = quantize;
+    m_Decoded = false;
+
+    m_Vertices = Vector3Vector();
+    m_Normals = Vector3Vector();
+    m_Tangents = Vector3Vector();
+    m_Uv0 = Vector2Vector();
+    m_Uv1 = Vector2Vector();
+    m_Colors = Vector4Vector();
+    m_Weights = Vector4Vector();
+    m_Bones = Vector4Vector();
+    m_Indices = IndexVector();
+}
+/*!
+    \internal
+    Converts the Lod to separate vertex attributes and releases the interleaved stream.
+*/
+void Lod::unpack() {
+    if(!isPacked()) {
+        return;
+    }
+    decode();
+
+    m_PackedVertices = ByteBuffer();
+    m_PackedIndices = ByteBuffer();
+    m_Decoded = false;
+}
+/*!
+    \internal
+    Restores separate vertex attributes from the interleaved stream to the cache, the stream stays untouched.
+    Const accessors can be called from the different threads, so the decoding is serialized.
+*/
+void Lod::decode() const {
+    if(!isPacked()) {
+        return;
+    }
+    unique_lock<mutex> locker(gDecodeMutex);
+    if(m_Decoded) {
+        return;
+    }
+    VertexLayout layout(m_PackedFlags, m_Quantized);
+
+    m_Vertices.resize(m_VertexCount);
+    if(m_PackedFlags & Mesh::Normals) {
+        m_Normals.resize(m_VertexCount);
+    }
+    if(m_PackedFlags & Mesh::Tangents) {
+        m_Tangents.resize(m_VertexCount);
+    }
+    if(m_PackedFlags & Mesh::Uv0) {
+        m_Uv0.resize(m_VertexCount);
+    }
+    if(m_PackedFlags & Mesh::Uv1) {
+        m_Uv1.resize(m_VertexCount);
+    }
+    if(m_PackedFlags & Mesh::Color) {
+        m_Colors.resize(m_VertexCount);
+    }
+    if(m_PackedFlags & Mesh::Skinned) {
+        m_Weights.resize(m_VertexCount);
+        m_Bones.resize(m_VertexCount);
+    }
+
+    for(uint32_t i = 0; i < m_VertexCount; i++) {
+        const int8_t *v = m_PackedVertices.data() + layout.stride * i;
+        unpackFloats(m_Vertices[i].v, v, 3, false);
+
+        if(m_PackedFlags & Mesh::Normals) {
+            unpackFloats(m_Normals[i].v, v + layout.normals, 3, m_Quantized);
+        }
+        if(m_PackedFlags & Mesh::Tangents) {
+            unpackFloats(m_Tangents[i].v, v + layout.tangents, 3, m_Quantized);
+        }
+        if(m_PackedFlags & Mesh::Uv0) {
+            unpackFloats(m_Uv0[i].v, v + layout.uv0, 2, m_Quantized);
+        }
+        if(m_PackedFlags & Mesh::Uv1) {
+            unpackFloats(m_Uv1[i].v, v + layout.uv1, 2, m_Quantized);
+        }
+        if(m_PackedFlags & Mesh::Color) {
+            if(m_Quantized) {
+                const uint8_t *color = reinterpret_cast<const uint8_t *>(v + layout.colors);
+                m_Colors[i] = Vector4(color[0], color[1], color[2], color[3]) * (1.0f / 255.0f);
+            } else {
+                unpackFloats(m_Colors[i].v, v + layout.colors, 4, false);
+            }
+        }
+        if(m_PackedFlags & Mesh::Skinned) {
+            if(m_Quantized) {
+                uint16_t weight[4];
+                uint16_t bone[4];
+                memcpy(weight, v + layout.weights, sizeof(weight));
+                memcpy(bone, v + layout.bones, sizeof(bone));
+                m_Weights[i] = Vector4(weight[0], weight[1], weight[2], weight[3]) * (1.0f / 65535.0f);
+                m_Bones[i] = Vector4(bone[0], bone[1], bone[2], bone[3]);
+            } else {
+                unpackFloats(m_Weights[i].v, v + layout.weights, 4, false);
+                unpackFloats(m_Bones[i].v, v + layout.bones, 4, false);
+            }
+        }
+    }
+
+    m_Indices.resize(m_IndexCount);
+    if(indexSize() == sizeof(uint16_t)) {
+        const int8_t *data = m_PackedIndices.data();
+        for(uint32_t i = 0; i < m_IndexCount; i++) {
+            uint16_t index;
+            memcpy(&index, data + sizeof(uint16_t) * i, sizeof(uint16_t));
+            m_Indices[i] = index;
+        }
+    } else if(m_IndexCount > 0) {
+        memcpy(m_Indices.data(), m_PackedIndices.data(), sizeof(uint32_t) * m_IndexCount);
+    }
+
+    m_Decoded = true;
+}
+
 class MeshPrivate {
 public:
     MeshPrivate() :
             m_Dynamic(false),
+            m_Packed(false),
+            m_Quantized(false),
             m_Flags(0),
             m_Topology(Mesh::Triangles) {
 
@@ -168,6 +628,10 @@ public:
 
     bool m_Dynamic;
 
+    bool m_Packed;
+
+    bool m_Quantized;
+
     uint8_t m_Flags;
 
     int m_Topology;
@@ -238,13 +702,25 @@ void Mesh::makeDynamic() {
 void Mesh::loadUserData(const VariantMap &data) {
     clear();
 
+    uint32_t format = Separated;
     auto it = data.find(HEADER);
     if(it != data.end()) {
         VariantList header = (*it).second.value<VariantList>();
 
         auto i = header.begin();
         p_ptr->m_Flags = (*i).toInt();
+        i++;
+        if(i != header.end()) {
+            format = (*i).toInt();
+            i++;
+            Vector3 min = (*i).toVector3();
+            i++;
+            Vector3 max = (*i).toVector3();
+            p_ptr->m_Box.setBox(min, max);
+        }
     }
+    p_ptr->m_Packed = (format != Separated);
+    p_ptr->m_Quantized = (format == Quantized);
 
     auto mesh = data.find(DATA);
     if(mesh != data.end()) {
@@ -267,15 +743,40 @@ void Mesh::loadUserData(const VariantMap &data) {
             uint32_t vCount = (*y).toInt();
             y++;
 
+            if(p_ptr->m_Packed) {
+                // Streams are shared with the resource buffer and uploaded without conversion
+                l.m_VertexCount = vCount;
+                l.m_IndexCount = (*y).toInt();
+                y++;
+                l.m_PackedVertices = (*y).toByteBuffer();
+                y++;
+                l.m_PackedIndices = (*y).toByteBuffer();
+                y++;
+                l.m_PackedFlags = p_ptr->m_Flags;
+                l.m_Quantized = p_ptr->m_Quantized;
+
+                VertexLayout layout(l.m_PackedFlags, l.m_Quantized);
+                uint32_t indices = l.m_PackedIndices.size();
+                if(l.m_PackedVertices.size() != layout.stride * vCount ||
+                   (indices != sizeof(uint16_t) * l.m_IndexCount && indices != sizeof(uint32_t) * l.m_IndexCount)) {
+                    Log(Log::ERR) << "Corrupted vertex stream for mesh" << name().c_str();
+                    l = Lod();
+                }
+                p_ptr->m_Lods.push_back(std::move(l));
+
+                x++;
+                continue;
+            }
+
             uint32_t tCount = (*y).toInt();
             y++;
 
-            ByteArray data;
+            ByteBuffer data;
             { // Required field
-                data = (*y).toByteArray();
+                data = (*y).toByteBuffer();
                 y++;
                 l.m_Vertices.resize(vCount);
-                memcpy(&l.m_Vertices[0],  &data[0], sizeof(Vector3) * vCount);
+                memcpy(&l.m_Vertices[0],  data.data(), sizeof(Vector3) * vCount);
                 for(uint32_t i = 0; i < vCount; i++) {
                     min.x = MIN(min.x, l.m_Vertices[i].x);
                     min.y = MIN(min.y, l.m_Vertices[i].y);
@@ -287,57 +788,59 @@ void Mesh::loadUserData(const VariantMap &data) {
                 }
             }
             { // Required field
-                data = (*y).toByteArray();
+                data = (*y).toByteBuffer();
                 y++;
                 l.m_Indices.resize(tCount * 3);
-                memcpy(&l.m_Indices[0], &data[0], sizeof(uint32_t) * tCount * 3);
+                memcpy(&l.m_Indices[0], data.data(), sizeof(uint32_t) * tCount * 3);
             }
             if(p_ptr->m_Flags & MeshAttributes::Color) { // Optional field
-                data = (*y).toByteArray();
+                data = (*y).toByteBuffer();
                 y++;
                 l.m_Colors.resize(vCount);
-                memcpy(&l.m_Colors[0], &data[0], sizeof(Vector4) * vCount);
+                memcpy(&l.m_Colors[0], data.data(), sizeof(Vector4) * vCount);
             }
             if(p_ptr->m_Flags & MeshAttributes::Uv0) { // Optional field
-                data = (*y).toByteArray();
+                data = (*y).toByteBuffer();
                 y++;
                 l.m_Uv0.resize(vCount);
-                memcpy(&l.m_Uv0[0], &data[0], sizeof(Vector2) * vCount);
+                memcpy(&l.m_Uv0[0], data.data(), sizeof(Vector2) * vCount);
             }
             if(p_ptr->m_Flags & MeshAttributes::Uv1) { // Optional field
-                data = (*y).toByteArray();
+                data = (*y).toByteBuffer();
                 y++;
                 l.m_Uv1.resize(vCount);
-                memcpy(&l.m_Uv1[0], &data[0], sizeof(Vector2) * vCount);
+                memcpy(&l.m_Uv1[0], data.data(), sizeof(Vector2) * vCount);
             }
             if(p_ptr->m_Flags & MeshAttributes::Normals) { // Optional field
-                data = (*y).toByteArray();
+                data = (*y).toByteBuffer();
                 y++;
                 l.m_Normals.resize(vCount);
-                memcpy(&l.m_Normals[0], &data[0], sizeof(Vector3) * vCount);
+                memcpy(&l.m_Normals[0], data.data(), sizeof(Vector3) * vCount);
             }
             if(p_ptr->m_Flags & MeshAttributes::Tangents) { // Optional field
-                data = (*y).toByteArray();
+                data = (*y).toByteBuffer();
                 y++;
                 l.m_Tangents.resize(vCount);
-                memcpy(&l.m_Tangents[0], &data[0],  sizeof(Vector3) * vCount);
+                memcpy(&l.m_Tangents[0], data.data(),  sizeof(Vector3) * vCount);
             }
             if(p_ptr->m_Flags & MeshAttributes::Skinned) { // Optional field
-                data = (*y).toByteArray();
+                data = (*y).toByteBuffer();
                 y++;
                 l.m_Weights.resize(vCount);
-                memcpy(&l.m_Weights[0], &data[0],  sizeof(Vector4) * vCount);
+                memcpy(&l.m_Weights[0], data.data(),  sizeof(Vector4) * vCount);
 
-                data = (*y).toByteArray();
+                data = (*y).toByteBuffer();
                 y++;
                 l.m_Bones.resize(vCount);
-                memcpy(&l.m_Bones[0], &data[0],  sizeof(Vector4) * vCount);
+                memcpy(&l.m_Bones[0], data.data(),  sizeof(Vector4) * vCount);
             }
-            p_ptr->m_Lods.push_back(l);
+            p_ptr->m_Lods.push_back(std::move(l));
 
             x++;
         }
-        p_ptr->m_Box.setBox(min, max);
+        if(!p_ptr->m_Packed) {
+            p_ptr->m_Box.setBox(min, max);
+        }
     }
     setState(ToBeUpdated);
 }
@@ -351,13 +854,39 @@ VariantMap Mesh::saveUserData() const {
 
     VariantList header;
     header.push_back(flag);
+    if(p_ptr->m_Packed) {
+        Vector3 min, max;
+        p_ptr->m_Box.box(min, max);
+
+        header.push_back((p_ptr->m_Quantized) ? Quantized : Interleaved);
+        header.push_back(min);
+        header.push_back(max);
+    }
     result[HEADER]  = header;
 
     VariantList surface;
     surface.push_back(topology());
 
     for(size_t index = 0; index < p_ptr->m_Lods.size(); index++) {
-        Lod *l = lod(index);
+        const Lod *l = lod(index);
+
+        if(p_ptr->m_Packed) {
+            Lod packed;
+            if(!l->isPacked()) {
+                packed = *l;
+                packed.pack(flag, p_ptr->m_Quantized);
+                l = &packed;
+            }
+            VariantList lod;
+            lod.push_back("{00000000-0402-0000-0000-000000000000}");
+            lod.push_back(static_cast<int32_t>(l->vertexCount()));
+            lod.push_back(static_cast<int32_t>(l->indexCount()));
+            lod.push_back(l->packedVertices());
+            lod.push_back(l->packedIndices());
+
+            surface.push_back(lod);
+            continue;
+        }
 
         VariantList lod;
         // Push material
@@ -553,6 +1082,26 @@ void Mesh::batchMesh(Mesh *mesh, Matrix4 *transform) {
         setState(ToBeUpdated);
     }
 }
+/*!
+    Returns true in case of Mesh is stored with interleaved vertex streams; otherwise returns false.
+*/
+bool Mesh::isPacked() const {
+    return p_ptr->m_Packed;
+}
+/*!
+    Moves vertex attributes of all Levels Of Detail to interleaved vertex streams and 16-bit indices where possible.
+    Set \a quantize to store normals, tangents and texture coordinates as half floats.
+    Packed streams are serialized as is and uploaded to GPU without conversion.
+*/
+void Mesh::pack(bool quantize) {
+    recalcBounds();
+    for(auto &l : p_ptr->m_Lods) {
+        l.pack(p_ptr->m_Flags, quantize);
+    }
+    p_ptr->m_Packed = true;
+    p_ptr->m_Quantized = quantize;
+    setState(ToBeUpdated);
+}
 /*!
     Generates bound box according new geometry.
 */
@@ -560,15 +1109,16 @@ void Mesh::recalcBounds() {
     Vector3 min( FLT_MAX);
     Vector3 max(-FLT_MAX);
 
-    for(auto l : p_ptr->m_Lods) {
-        for(uint32_t i = 0; i < l.vertices().size(); i++) {
-            min.x = MIN(min.x, l.m_Vertices[i].x);
-            min.y = MIN(min.y, l.m_Vertices[i].y);
-            min.z = MIN(min.z, l.m_Vertices[i].z);
+    for(const auto &l : p_ptr->m_Lods) {
+        const Vector3Vector &vertices = l.vertices();
+        for(auto &it : vertices) {
+            min.x = MIN(min.x, it.x);
+            min.y = MIN(min.y, it.y);
+            min.z = MIN(min.z, it.z);
 
-            max.x = MAX(max.x, l.m_Vertices[i].x);
-            max.y = MAX(max.y, l.m_Vertices[i].y);
-            max.z = MAX(max.z, l.m_Vertices[i].z);
+            max.x = MAX(max.x, it.x);
+            max.y = MAX(max.y, it.y);
+            max.z = MAX(max.z, it.z);
         }
     }
 
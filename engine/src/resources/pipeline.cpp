@@ -242,7 +242,9 @@ void Pipeline::analizeScene(Scene *scene, RenderSystem *system) {
     combineComponents(scene, scene->isToBeUpdated());
 
     Camera *camera = Camera::current();
-    m_Filter = Camera::frustumCulling(m_SceneComponents, Camera::frustumCorners(*camera));
+    // Culling result lives in the frame arena, copy it to keep the capacity of m_Filter between frames
+    RenderFrameList filter = Camera::frustumCulling(m_SceneComponents, Camera::frustumCorners(*camera));
+    m_Filter.assign(filter.begin(), filter.end());
     sortByDistance(m_Filter, camera->actor()->transform()->position());
 
     // Post process settings mixer
@@ -353,7 +355,7 @@ CommandBuffer *Pipeline::buffer() const {
     return m_Buffer;
 }
 
-void Pipeline::drawComponents(uint32_t layer, list<Renderable *> &list) {
+void Pipeline::drawComponents(uint32_t layer, const RenderList &list) {
     for(auto it : list) {
         it->draw(*m_Buffer, layer);
     }
@@ -416,48 +418,50 @@ void Pipeline::postProcess(RenderTarget *source, uint32_t layer) {
     m_Buffer->resetViewProjection();
 }
 
-void Pipeline::combineComponents(Object *object, bool update) {
-    for(auto &it : object->getChildren()) {
-        Object *child = it;
-        if(child->isComponent()) {
-            Component *component = static_cast<Component *>(child);
-            if(component->isRenderable()) {
-                Renderable *comp = static_cast<Renderable *>(child);
-                if(comp->isEnabled() && comp->actor()->isEnabledInHierarchy()) {
-                    if(update) {
-                        comp->update();
-                    }
-                    if(comp->isLight()) {
-                        m_SceneLights.push_back(comp);
-                    } else {
-                        if(comp->actor()->layers() & CommandBuffer::UI) {
-                            m_UiComponents.push_back(comp);
-                        } else {
-                            m_SceneComponents.push_back(comp);
-                        }
-                    }
+void Pipeline::combineComponents(Scene *scene, bool update) {
+    // Components are registered in the scene on attachment, so there is no need to walk through the hierarchy
+    const vector<Component *> &renderables = scene->components(Renderable::metaClass()->typeId());
+    // Updated components can attach new ones, the registry keeps the indices of the existing
+    for(size_t i = 0; i < renderables.size(); i++) {
+        Renderable *comp = static_cast<Renderable *>(renderables[i]);
+        if(comp && comp->isEnabled() && comp->actor()->isEnabledInHierarchy()) {
+            if(update) {
+                comp->update();
+            }
+            // Components updated by the render or missed by the Engine extraction
+            if(update || !comp->hasSnapshot() || !m_pSystem->isSnapshotsExtracted()) {
+                comp->extractSnapshot();
+            }
+            if(comp->isLight()) {
+                m_SceneLights.push_back(comp);
+            } else {
+                if(comp->snapshot().m_Layers & CommandBuffer::UI) {
+                    m_UiComponents.push_back(comp);
+                } else {
+                    m_SceneComponents.push_back(comp);
                 }
-            } else if(component->isPostProcessVolume()){
-                m_postProcessVolume.push_back(static_cast<PostProcessVolume *>(component));
             }
-        } else {
-            combineComponents(child, update);
         }
     }
+
+    for(auto it : scene->components(PostProcessVolume::metaClass()->typeId())) {
+        m_postProcessVolume.push_back(static_cast<PostProcessVolume *>(it));
+    }
 }
 
-struct ObjectComp {
-    bool operator() (const Renderable *left, const Renderable *right) {
-        Matrix4 m1 = left->actor()->transform()->worldTransform();
-        Matrix4 m2 = right->actor()->transform()->worldTransform();
-        return origin.dot(Vector3(m1[12], m1[13], m1[14])) < origin.dot(Vector3(m2[12], m2[13], m2[14]));
+void Pipeline::sortByDistance(RenderList &in, const Vector3 &origin) {
+    // Sort keys are evaluated once per component instead of once per comparison, the index keeps the order of equal keys
+    FrameVector<pair<float, uint32_t>> keys;
+    keys.reserve(in.size());
+    RenderFrameList source(in.begin(), in.end());
+    for(uint32_t i = 0; i < source.size(); i++) {
+        const Matrix4 &m = source[i]->snapshot().m_Transform;
+        keys.push_back(make_pair(origin.dot(Vector3(m[12], m[13], m[14])), i));
     }
-    Vector3 origin;
-};
 
-void Pipeline::sortByDistance(list<Renderable *> &in, const Vector3 &origin) {
-    ObjectComp comp;
-    comp.origin = origin;
+    std::sort(keys.begin(), keys.end());
 
-    in.sort(comp);
+    for(uint32_t i = 0; i < keys.size(); i++) {
+        in[i] = source[keys[i].second];
+    }
 }
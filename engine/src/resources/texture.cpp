@@ -1,11 +1,36 @@
 #include "resources/texture.h"
 
 #include <variant.h>
+#include <log.h>
 
 #include <cstring>
+#include <climits>
 
 #define HEADER  "Header"
 #define DATA    "Data"
+#define IMAGE   "Image"
+
+#define IMAGE_ALIGNMENT 16
+
+static const uint8_t gIdentifier[12] = {0xAB, 'T', 'E', 'X', ' ', '1', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+
+struct ImageHeader {
+    uint8_t identifier[12];
+    uint32_t endianness;
+    uint32_t format;
+    uint32_t compress;
+    uint32_t width;
+    uint32_t height;
+    uint32_t layers;
+    uint32_t faces;
+    uint32_t levels;
+    uint32_t alignment;
+};
+
+struct ImageLevel {
+    uint32_t offset;
+    uint32_t size;
+};
 
 class TexturePrivate {
 public:
@@ -16,10 +41,18 @@ public:
             m_Wrap(Texture::Clamp),
             m_Width(1),
             m_Height(1),
-            m_Depth(0) {
+            m_Depth(0),
+            m_Faces(0),
+            m_Levels(0) {
 
     }
 
+    ImageLevel level(uint32_t face, uint32_t lod) const {
+        ImageLevel result;
+        memcpy(&result, m_Image.data() + sizeof(ImageHeader) + sizeof(ImageLevel) * (lod * m_Faces + face), sizeof(ImageLevel));
+        return result;
+    }
+
     int32_t m_Format;
     int32_t m_Compress;
     int32_t m_Filtering;
@@ -30,8 +63,13 @@ public:
 
     int32_t m_Depth;
 
+    uint32_t m_Faces;
+    uint32_t m_Levels;
+
     Vector2Vector m_Shape;
     Texture::Sides m_Sides;
+
+    ByteBuffer m_Image;
 };
 
 /*!
@@ -40,6 +78,11 @@ public:
     \inmodule Resources
 
     This class can be used to handle texture resource or create them at runtime.
+
+    Imported textures are stored in a packed image container: a fixed header with format, dimensions, number of array layers,
+    faces and mip levels, followed by a table of levels and tightly packed level data aligned to 16 bytes.
+    The container is kept in the resource buffer as is and levels are uploaded to GPU directly from it.
+    Any access to the surfaces unpacks the levels into separate arrays.
 */
 
 /*!
@@ -90,28 +133,81 @@ Texture::~Texture() {
 void Texture::loadUserData(const VariantMap &data) {
     clear();
 
+    {
+        auto it = data.find(IMAGE);
+        if(it != data.end()) {
+            ByteBuffer image = (*it).second.toByteBuffer();
+
+            // Only the header and the table of levels are read, level data stays in the resource buffer
+            ImageHeader header;
+            memset(&header, 0, sizeof(ImageHeader));
+            if(image.size() >= sizeof(ImageHeader)) {
+                memcpy(&header, image.data(), sizeof(ImageHeader));
+            }
+            uint64_t count = static_cast<uint64_t>(header.levels) * header.faces * header.layers;
+            if(image.size() < sizeof(ImageHeader) ||
+               memcmp(header.identifier, gIdentifier, sizeof(gIdentifier)) != 0 ||
+               header.layers != 1 || header.faces == 0 || header.levels == 0 || header.levels > 32 ||
+               header.width == 0 || header.height == 0 ||
+               image.size() < sizeof(ImageHeader) + sizeof(ImageLevel) * count) {
+                Log(Log::ERR) << "Corrupted image for texture" << name().c_str();
+            } else {
+                p_ptr->m_Format = header.format;
+                p_ptr->m_Compress = header.compress;
+                p_ptr->m_Width = header.width;
+                p_ptr->m_Height = header.height;
+                p_ptr->m_Faces = header.faces;
+                p_ptr->m_Levels = header.levels;
+                p_ptr->m_Image = image;
+
+                // Level sizes are calculated in 32-bit, so the first level must fit into it, size(1, 1) is the size of pixel or compressed block
+                uint64_t units = static_cast<uint64_t>(header.width) * header.height;
+                if(isCompressed()) {
+                    units = ((static_cast<uint64_t>(header.width) + 3) / 4) * ((static_cast<uint64_t>(header.height) + 3) / 4);
+                }
+                if(units * static_cast<uint64_t>(size(1, 1)) > INT32_MAX) {
+                    Log(Log::ERR) << "Too large image for texture" << name().c_str();
+                    clear();
+                    count = 0;
+                }
+
+                for(uint32_t i = 0; i < count; i++) {
+                    uint32_t lod = i / header.faces;
+                    ImageLevel level = p_ptr->level(i % header.faces, lod);
+                    // Each level must keep at least the data of its mip dimensions, the render reads it as is
+                    int32_t w = MAX(p_ptr->m_Width >> lod, 1);
+                    int32_t h = MAX(p_ptr->m_Height >> lod, 1);
+                    if(static_cast<uint64_t>(level.offset) + level.size > image.size() ||
+                       level.size < static_cast<uint32_t>(size(w, h))) {
+                        Log(Log::ERR) << "Corrupted image for texture" << name().c_str();
+                        clear();
+                        break;
+                    }
+                }
+            }
+        }
+    }
     {
         auto it = data.find(DATA);
         if(it != data.end()) {
             const VariantList &surfaces = (*it).second.value<VariantList>();
-            for(auto s : surfaces) {
+            for(auto &s : surfaces) {
                 Surface img;
                 int32_t w = p_ptr->m_Width;
                 int32_t h = p_ptr->m_Height;
                 const VariantList &lods = s.value<VariantList>();
-                for(auto l : lods) {
-                    ByteArray bits = l.toByteArray();
+                for(auto &l : lods) {
+                    const ByteBuffer bits = l.toByteBuffer();
                     uint32_t s = size(w, h);
                     if(s && !bits.empty()) {
-                        ByteArray pixels;
-                        pixels.resize(s);
-                        memcpy(&pixels[0], &bits[0], s);
-                        img.push_back(pixels);
+                        ByteArray pixels(s);
+                        memcpy(&pixels[0], bits.data(), MIN(s, bits.size()));
+                        img.push_back(std::move(pixels));
                     }
                     w = MAX(w / 2, 1);
                     h = MAX(h / 2, 1);
                 }
-                p_ptr->m_Sides.push_back(img);
+                p_ptr->m_Sides.push_back(std::move(img));
             }
         }
     }
@@ -122,25 +218,129 @@ void Texture::loadUserData(const VariantMap &data) {
 VariantMap Texture::saveUserData() const {
     VariantMap result;
 
-    VariantList surfaces;
-    for(auto &side : p_ptr->m_Sides) {
-        VariantList surface;
-        for(auto lod : side) {
-            surface.push_back(lod);
+    if(isPacked()) {
+        result[IMAGE] = p_ptr->m_Image;
+    } else if(!p_ptr->m_Sides.empty()) {
+        ByteArray image = pack();
+        if(!image.empty()) {
+            result[IMAGE] = image;
         }
-        surfaces.push_back(surface);
     }
-    result[DATA] = surfaces;
 
     return result;
 }
+/*!
+    \internal
+    Returns surfaces of the texture in the packed image container.
+*/
+ByteArray Texture::pack() const {
+    const Sides &sides = p_ptr->m_Sides;
 
+    uint32_t faces = sides.size();
+    uint32_t levels = sides.front().size();
+    for(auto &side : sides) {
+        levels = MIN(levels, side.size());
+    }
+    // The loader rejects images without levels, so there is nothing to store
+    if(levels == 0) {
+        return ByteArray();
+    }
+
+    ImageHeader header;
+    memcpy(header.identifier, gIdentifier, sizeof(gIdentifier));
+    header.endianness = 0x04030201;
+    header.format = p_ptr->m_Format;
+    header.compress = p_ptr->m_Compress;
+    header.width = p_ptr->m_Width;
+    header.height = p_ptr->m_Height;
+    header.layers = 1;
+    header.faces = faces;
+    header.levels = levels;
+    header.alignment = IMAGE_ALIGNMENT;
+
+    // Levels are stored in the order: mip level, face
+    vector<ImageLevel> table(levels * faces);
+    uint32_t offset = sizeof(ImageHeader) + sizeof(ImageLevel) * table.size();
+    for(uint32_t l = 0; l < levels; l++) {
+        for(uint32_t f = 0; f < faces; f++) {
+            offset = (offset + IMAGE_ALIGNMENT - 1) & ~(IMAGE_ALIGNMENT - 1);
+
+            ImageLevel &level = table[l * faces + f];
+            level.offset = offset;
+            level.size = sides[f][l].size();
+            offset += level.size;
+        }
+    }
+
+    ByteArray result(offset, 0);
+    memcpy(&result[0], &header, sizeof(ImageHeader));
+    memcpy(&result[sizeof(ImageHeader)], table.data(), sizeof(ImageLevel) * table.size());
+    for(uint32_t l = 0; l < levels; l++) {
+        for(uint32_t f = 0; f < faces; f++) {
+            const ImageLevel &level = table[l * faces + f];
+            if(level.size) {
+                memcpy(&result[level.offset], sides[f][l].data(), level.size);
+            }
+        }
+    }
+    return result;
+}
+/*!
+    \internal
+    Moves levels from the packed image container to the surfaces.
+*/
+void Texture::unpack() {
+    if(!isPacked()) {
+        return;
+    }
+    for(uint32_t f = 0; f < p_ptr->m_Faces; f++) {
+        Surface surface;
+        for(uint32_t l = 0; l < p_ptr->m_Levels; l++) {
+            ImageLevel level = p_ptr->level(f, l);
+            const int8_t *data = p_ptr->m_Image.data() + level.offset;
+            surface.push_back(ByteArray(data, data + level.size));
+        }
+        p_ptr->m_Sides.push_back(std::move(surface));
+    }
+    p_ptr->m_Image = ByteBuffer();
+}
+/*!
+    Returns true in case of texture levels are stored in the packed image container; otherwise returns false.
+*/
+bool Texture::isPacked() const {
+    return !p_ptr->m_Image.empty();
+}
+/*!
+    Returns the number of mip levels for the texture.
+*/
+int Texture::mipCount() const {
+    if(isPacked()) {
+        return p_ptr->m_Levels;
+    }
+    return (p_ptr->m_Sides.empty()) ? 0 : p_ptr->m_Sides.front().size();
+}
+/*!
+    Returns pixel data of the mip level \a lod for the provided \a face.
+    For the packed texture returned buffer shares memory with the image container; otherwise returns a copy of the surface data.
+*/
+ByteBuffer Texture::level(int face, int lod) const {
+    if(isPacked()) {
+        if(static_cast<uint32_t>(face) < p_ptr->m_Faces && static_cast<uint32_t>(lod) < p_ptr->m_Levels) {
+            ImageLevel level = p_ptr->level(face, lod);
+            return p_ptr->m_Image.slice(level.offset, level.size);
+        }
+    } else if(static_cast<uint32_t>(face) < p_ptr->m_Sides.size() && static_cast<uint32_t>(lod) < p_ptr->m_Sides[face].size()) {
+        return ByteBuffer(p_ptr->m_Sides[face][lod]);
+    }
+    return ByteBuffer();
+}
 /*!
     Returns a surface for the provided \a face.
     Each texture must contain at least one surface.
     Commonly used to set surfaces for the cube maps.
 */
 Texture::Surface &Texture::surface(int face) {
+    unpack();
     return p_ptr->m_Sides[face];
 }
 /*!
@@ -149,6 +349,7 @@ Texture::Surface &Texture::surface(int face) {
     Commonly used to set surfaces for the cube maps.
 */
 void Texture::addSurface(const Surface &surface) {
+    unpack();
     p_ptr->m_Sides.push_back(surface);
 }
 /*!
@@ -172,7 +373,13 @@ void Texture::readPixels(int x, int y, int width, int height) {
 */
 int Texture::getPixel(int x, int y) const {
     uint32_t result = 0;
-    if(!p_ptr->m_Sides.empty() && !p_ptr->m_Sides[0].empty()) {
+    if(isPacked()) {
+        ByteBuffer bits = level(0, 0);
+        uint32_t offset = (y * p_ptr->m_Width + x);
+        if(offset + sizeof(uint32_t) <= bits.size()) {
+            memcpy(&result, bits.data() + offset, sizeof(uint32_t));
+        }
+    } else if(!p_ptr->m_Sides.empty() && !p_ptr->m_Sides[0].empty()) {
         int8_t *ptr = &(p_ptr->m_Sides[0][0])[0] + (y * p_ptr->m_Width + x);
         memcpy(&result, ptr, sizeof(uint32_t));
     }
@@ -285,6 +492,7 @@ void Texture::setDepthBits(int depth) {
     In most cases returns 1 but for the cube map will return 6
 */
 Texture::Sides *Texture::getSides() {
+    unpack();
     return &p_ptr->m_Sides;
 }
 /*!
@@ -297,6 +505,9 @@ bool Texture::isCompressed() const {
     Returns true if the texture is a cube map; otherwise returns false.
 */
 bool Texture::isCubemap() const {
+    if(isPacked()) {
+        return (p_ptr->m_Faces == 6);
+    }
     return (p_ptr->m_Sides.size() == 6);
 }
 /*!
@@ -326,6 +537,9 @@ uint8_t Texture::components() const {
 void Texture::clear() {
     p_ptr->m_Sides.clear();
     p_ptr->m_Shape.clear();
+    p_ptr->m_Image = ByteBuffer();
+    p_ptr->m_Faces = 0;
+    p_ptr->m_Levels = 0;
 }
 /*!
     \internal
@@ -9,13 +9,36 @@
     \note All methods will be called internaly in the engine.
     \note Systems can process only components which registered in this system.
     \note Systems can be executed one by one or in parallel based on thread policy.
+
+    Each frame the Engine builds a dependency graph of systems.
+    Systems are ordered by their System::Phase; two systems are executed one after another only when one of them writes the data which another one reads or writes.
+    All other systems are executed in parallel.
 */
 
 /*!
     \enum System::ThreadPolicy
 
     \value Main \c The System::update will be executed one by one in the main thread. This method is handy when you need to execute systems with exact sequence. This policy uses only one CPU core.
-    \value Pool \c The System::update will be executed in the dedicated thread pool. Please note, there is no warranty of a sequence of execution for this case. This policy is preferable because it utilizes CPU cores more efficiently.
+    \value Pool \c The System::update will be executed in the dedicated thread pool. The sequence of execution is defined by phase() and data access declared in reads() and writes(). This policy is preferable because it utilizes CPU cores more efficiently.
+*/
+
+/*!
+    \enum System::Phase
+    \value PreUpdate \c The system must be executed before the game logic. For example, resource streaming.
+    \value Update \c The system executes the game logic. For example, physics or scripts.
+    \value PostUpdate \c The system reacts on the results of game logic. For example, sound listeners or animation.
+    \value Render \c The system presents the results of the frame.
+    \value FixedUpdate \c The system simulates the game world with the constant time step. The System::update is executed for each fixed step of the frame, which can be zero or several times per frame, before all other phases. Timer::fixedDeltaTime() must be used as the time step. For example, physics.
+*/
+
+/*!
+    \enum System::Access
+
+    \value Nothing \c The system doesn't touch the shared data.
+    \value Transforms \c Transform components of actors.
+    \value Components \c All other components and actors.
+    \value Resources \c Loaded resources and resource cache.
+    \value Everything \c All the shared data.
 */
 
 /*!
@@ -46,9 +69,33 @@
 */
 
 System::System() :
-    m_pScene(nullptr) {
+        m_pScene(nullptr),
+        m_UpdateTime(0),
+        m_UpdateOffset(0) {
 
 }
+/*!
+    Returns the phase of the frame in which the system must be executed.
+    For more details please refer to System::Phase enum.
+    Default is System::Update.
+*/
+int System::phase() const {
+    return Update;
+}
+/*!
+    Returns the combination of System::Access flags which the system reads during the update.
+    Default is System::Everything.
+*/
+int System::reads() const {
+    return Everything;
+}
+/*!
+    Returns the combination of System::Access flags which the system modifies during the update.
+    Default is System::Everything which means that system can't be executed in parallel with any other system.
+*/
+int System::writes() const {
+    return Everything;
+}
 /*!
     This method is a callback to react on saving game settings.
 */
@@ -76,3 +123,16 @@ void System::processEvents() {
 
     update(m_pScene);
 }
+/*!
+    Returns the duration of the last update in microseconds.
+*/
+uint32_t System::updateTime() const {
+    return m_UpdateTime.load(memory_order_relaxed);
+}
+/*!
+    Returns the time in microseconds between the beginning of the last frame and the start of the system update.
+    Together with updateTime() it can be used to find the critical path of the frame.
+*/
+uint32_t System::updateOffset() const {
+    return m_UpdateOffset.load(memory_order_relaxed);
+}
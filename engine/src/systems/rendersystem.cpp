@@ -20,16 +20,21 @@
 
 #include "commandbuffer.h"
 
+#include <framearena.h>
+
 class RenderSystemPrivate {
 public:
     RenderSystemPrivate() :
-        m_Update(true) {
+        m_Update(true),
+        m_Extracted(false) {
 
     }
     static int32_t m_AtlasPageWidth;
     static int32_t m_AtlasPageHeight;
 
     bool m_Update;
+
+    bool m_Extracted;
 };
 
 int32_t RenderSystemPrivate::m_AtlasPageWidth = 1024;
@@ -81,6 +86,18 @@ int RenderSystem::threadPolicy() const {
     return Main;
 }
 
+int RenderSystem::phase() const {
+    return Render;
+}
+
+int RenderSystem::reads() const {
+    return Everything;
+}
+
+int RenderSystem::writes() const {
+    return Components | Resources;
+}
+
 const char *RenderSystem::name() const {
     return "Render";
 }
@@ -92,8 +109,10 @@ bool RenderSystem::init() {
 void RenderSystem::update(Scene *scene) {
     PROFILE_FUNCTION();
 
-    PROFILER_RESET(POLYGONS);
-    PROFILER_RESET(DRAWCALLS);
+    // The Engine::update switches the arenas once per frame, the render without the extraction by the Engine is called outside of it (by the editor viewports)
+    if(!p_ptr->m_Extracted) {
+        FrameArena::nextFrame();
+    }
 
     Camera *camera = Camera::current();
     if(camera) {
@@ -102,6 +121,8 @@ void RenderSystem::update(Scene *scene) {
         pipe->draw(*camera);
         pipe->finish();
     }
+    // Next render without the extraction by the Engine must take the snapshots by itself
+    p_ptr->m_Extracted = false;
 }
 
 void RenderSystem::processEvents() {
@@ -119,6 +140,23 @@ void RenderSystem::setAtlasPageSize(int32_t width, int32_t height) {
     RenderSystemPrivate::m_AtlasPageWidth = width;
     RenderSystemPrivate::m_AtlasPageHeight = height;
 }
+/*!
+    Returns true in case of the snapshots of all renderables were extracted for the upcoming render of this system; otherwise returns false.
+    Without the extraction the render takes the snapshots of visited renderables by itself.
+    Such render is executed outside of the Engine frame, so it switches the FrameArena to the next frame by itself.
+
+    \sa Renderable::snapshot()
+*/
+bool RenderSystem::isSnapshotsExtracted() const {
+    return p_ptr->m_Extracted;
+}
+/*!
+    Marks the snapshots of all renderables as \a extracted for the upcoming render.
+    \note Usually, this method calls internally by the Engine and must not be called manually.
+*/
+void RenderSystem::setSnapshotsExtracted(bool extracted) {
+    p_ptr->m_Extracted = extracted;
+}
 
 void RenderSystem::composeComponent(Component *component) const {
     Renderable *renderable = dynamic_cast<Renderable *>(component);
@@ -2,11 +2,16 @@
 
 #include <bson.h>
 #include <json.h>
+#include <objectpack.h>
+
+#include <analytics/performancecounter.h>
 
 #include "engine.h"
 
 #include "resources/resource.h"
 
+static PerformanceCounter gResourcesLoaded("Resources Loaded");
+
 class ResourceSystemPrivate {
 public:
     ResourceSystem::DictionaryMap  m_IndexMap;
@@ -49,7 +54,19 @@ void ResourceSystem::update(Scene *) {
 }
 
 int ResourceSystem::threadPolicy() const {
-    return Pool;
+    return Main;
+}
+
+int ResourceSystem::phase() const {
+    return PreUpdate;
+}
+
+int ResourceSystem::reads() const {
+    return Resources;
+}
+
+int ResourceSystem::writes() const {
+    return Resources;
 }
 
 void ResourceSystem::setResource(Resource *object, const string &uuid) {
@@ -79,26 +96,36 @@ Resource *ResourceSystem::loadResource(const string &path) {
         File *file = Engine::file();
         _FILE *fp = file->fopen(uuid.c_str(), "r");
         if(fp) {
-            ByteArray data;
-            data.resize(file->fsize(fp));
-            file->fread(&data[0], data.size(), 1, fp);
+            ByteArray bytes;
+            bytes.resize(file->fsize(fp));
+            file->fread(&bytes[0], bytes.size(), 1, fp);
             file->fclose(fp);
 
-            Variant var = Bson::load(data);
-            if(!var.isValid()) {
-                var = Json::load(string(data.begin(), data.end()));
-            }
-            if(var.isValid()) {
-                Object *res = Engine::toObject(var);
-                if(res) {
-                    Resource *resource = dynamic_cast<Resource *>(res);
-                    if(resource) {
-                        resource->setState(Resource::ToBeUpdated);
-                        setResource(resource, uuid);
-                        return resource;
+            // Binary fields of the resource will share this memory
+            ByteBuffer data(std::move(bytes));
+            Object *res = nullptr;
+            ObjectPack pack(data);
+            if(pack.isValid()) {
+                res = Engine::toObject(pack);
+            } else {
+                BsonReader reader(data);
+                if(reader.isValid()) {
+                    res = Engine::toObject(reader);
+                } else {
+                    Variant var = Json::load(reinterpret_cast<const char *>(data.data()), data.size());
+                    if(var.isValid()) {
+                        res = Engine::toObject(var);
                     }
                 }
             }
+            if(res) {
+                Resource *resource = dynamic_cast<Resource *>(res);
+                if(resource) {
+                    resource->setState(Resource::ToBeUpdated);
+                    setResource(resource, uuid);
+                    return resource;
+                }
+            }
         }
 
     }
@@ -159,27 +186,35 @@ void ResourceSystem::processState(Resource *resource) {
                     File *file = Engine::file();
                     _FILE *fp = file->fopen(uuid.c_str(), "r");
                     if(fp) {
-                        ByteArray data;
-                        data.resize(file->fsize(fp));
-                        file->fread(&data[0], data.size(), 1, fp);
+                        ByteArray bytes;
+                        bytes.resize(file->fsize(fp));
+                        file->fread(&bytes[0], bytes.size(), 1, fp);
                         file->fclose(fp);
 
-                        Variant var = Bson::load(data);
+                        ByteBuffer data(std::move(bytes));
+                        ObjectPack pack(data);
+                        Variant var = pack.isValid() ? pack.toVariant() : Bson::load(data);
                         if(!var.isValid()) {
-                            var = Json::load(string(data.begin(), data.end()));
+                            var = Json::load(reinterpret_cast<const char *>(data.data()), data.size());
                         }
 
                         VariantList objects = var.toList();
                         VariantList fields = objects.front().toList();
                         auto it = std::next(fields.begin(), 4);
                         VariantMap &properties = *(reinterpret_cast<VariantMap *>((*it).data()));
+                        const MetaObject *meta = resource->metaObject();
                         for(const auto &prop : properties) {
-                            Variant v  = prop.second;
+                            const Variant &v = prop.second;
                             if(v.type() < MetaType::USERTYPE) {
-                                resource->setProperty(prop.first.c_str(), v);
+                                MetaProperty property = meta->findProperty(prop.first.c_str());
+                                if(property.isValid()) {
+                                    property.write(resource, v);
+                                }
                             }
                         }
                         resource->loadUserData(fields.back().toMap());
+
+                        gResourcesLoaded.add();
                     }
                 }
             } break;
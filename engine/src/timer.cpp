@@ -1,10 +1,17 @@
 #include "timer.h"
 
+#include <cmath>
+
 static TimePoint m_sLastTime;
 static float m_sTime        = 0.0;
 static float m_sDeltaTime   = 0.0;
 static float m_sTimeScale   = 1.0;
 
+static float m_sFixedDelta  = 1.0f / 60.0f;
+static float m_sAccumulator = 0.0;
+static float m_sAlpha       = 0.0;
+static uint32_t m_sMaxSteps = 4;
+
 /*!
     \class Timer
     \brief The interface to get time information from Thunder Engine.
@@ -14,6 +21,10 @@ static float m_sTimeScale   = 1.0;
     This class is used in all systems which doing any animation
     Using deltaTime() method developers are able to calculate a logic based on delays for example shots or movements of your character.
     Time scale value can be used for the slow-motion effects because it applied for all deltaTime() values.
+
+    Besides the variable frame time, the Timer tracks a fixed simulation timeline.
+    The time of each frame is accumulated and consumed by the Engine in the steps of fixedDeltaTime(), the rest of accumulated time is carried over to the next frame and available as interpolation() factor.
+    This allows to run the simulation with the constant tick rate which doesn't depend on the frame rate.
 */
 
 /*!
@@ -31,6 +42,8 @@ void Timer::reset() {
     m_sTime        = 0.0;
     m_sDeltaTime   = 0.0;
     m_sTimeScale   = 1.0;
+    m_sAccumulator = 0.0;
+    m_sAlpha       = 0.0;
 }
 /*!
     Updates all Timer related variables.
@@ -41,6 +54,7 @@ void Timer::update() {
 
     m_sDeltaTime = (std::chrono::duration_cast<std::chrono::duration<float> >(current - m_sLastTime)).count() * m_sTimeScale;
     m_sTime += m_sDeltaTime;
+    m_sAccumulator += m_sDeltaTime;
     m_sLastTime = current;
 }
 /*!
@@ -69,3 +83,56 @@ float Timer::scale() {
 void Timer::setScale(float scale) {
     m_sTimeScale = scale;
 }
+/*!
+    Returns the duration in seconds of one fixed simulation step.
+    Default value is 1/60 of second.
+*/
+float Timer::fixedDeltaTime() {
+    return m_sFixedDelta;
+}
+/*!
+    Sets the duration in seconds of one fixed simulation step to \a delta.
+    For example the value 1/30 sets the tick rate of the simulation to 30 Hz.
+*/
+void Timer::setFixedDeltaTime(float delta) {
+    if(delta > 0.0f) {
+        m_sFixedDelta = delta;
+    }
+}
+/*!
+    Returns the maximum number of fixed steps which can be executed in a single frame.
+    Default value is 4.
+*/
+uint32_t Timer::maxFixedSteps() {
+    return m_sMaxSteps;
+}
+/*!
+    Sets the maximum number of fixed \a steps which can be executed in a single frame.
+    In case of frame spike, the time which doesn't fit to these steps is dropped to keep the frame cost predictable.
+*/
+void Timer::setMaxFixedSteps(uint32_t steps) {
+    m_sMaxSteps = MAX(steps, 1);
+}
+/*!
+    Returns the factor in range [0, 1] between the last executed fixed step and the next one.
+    This factor can be used to blend the state of the last two fixed steps like transforms of physical bodies for the rendering and sounds, see Transform::interpolatedTransform().
+*/
+float Timer::interpolation() {
+    return m_sAlpha;
+}
+/*!
+    Consumes the accumulated time in the steps of fixedDeltaTime() and returns the number of steps which must be executed.
+    \note This method calls internally and must not be called manually.
+*/
+uint32_t Timer::consumeFixedSteps() {
+    uint32_t steps = static_cast<uint32_t>(m_sAccumulator / m_sFixedDelta);
+    if(steps > m_sMaxSteps) {
+        steps = m_sMaxSteps;
+        m_sAccumulator = fmod(m_sAccumulator, m_sFixedDelta);
+    } else {
+        m_sAccumulator -= m_sFixedDelta * steps;
+    }
+    float alpha = m_sAccumulator / m_sFixedDelta;
+    m_sAlpha = CLAMP(alpha, 0.0f, 1.0f);
+    return steps;
+}
@@ -1,20 +1,29 @@
 #include "tst_common.h"
 
 #include "components/actor.h"
+#include "components/scene.h"
 #include "components/transform.h"
 #include "components/component.h"
 #include "components/camera.h"
 #include "components/meshrender.h"
 #include "components/skinnedmeshrender.h"
 
+#include "components/private/transformstore.h"
+
 #include "resources/prefab.h"
 
 #include "systems/resourcesystem.h"
 #include "systems/rendersystem.h"
 
 #include "commandbuffer.h"
+#include "timer.h"
 
 #include <json.h>
+#include <objectpool.h>
+
+#include <cmath>
+#include <chrono>
+#include <thread>
 
 class TestComponent : public Component {
 public:
@@ -79,6 +88,113 @@ void Transform_hierarchy() {
     QCOMPARE(t2->parentTransform() == t1, true);
 }
 
+void Transform_batch_update() {
+    Transform root;
+    Transform child;
+    Transform leaf;
+    Transform other;
+
+    child.setParentTransform(&root, true);
+    leaf.setParentTransform(&child, true);
+
+    root.setPosition(Vector3(1.0f, 0.0f, 0.0f));
+    child.setPosition(Vector3(0.0f, 2.0f, 0.0f));
+    leaf.setPosition(Vector3(0.0f, 0.0f, 3.0f));
+    leaf.setScale(Vector3(2.0f));
+
+    TransformStore::update(nullptr);
+    QCOMPARE(leaf.worldPosition(), Vector3(1.0f, 2.0f, 3.0f));
+    QCOMPARE(leaf.worldScale(), Vector3(2.0f));
+
+    // Modification of the parent must be visible in the descendants before the next update
+    root.setPosition(Vector3(-1.0f, 0.0f, 0.0f));
+    QCOMPARE(leaf.worldPosition(), Vector3(-1.0f, 2.0f, 3.0f));
+
+    // The subtree moves to the deeper level and keeps own local values
+    other.setParentTransform(&root, true);
+    child.setParentTransform(&other, true);
+    other.setPosition(Vector3(0.0f, 0.0f, 1.0f));
+    TransformStore::update(nullptr);
+    QCOMPARE(leaf.worldPosition(), Vector3(-1.0f, 2.0f, 4.0f));
+    QCOMPARE(child.position(), Vector3(0.0f, 2.0f, 0.0f));
+
+    {
+        Transform temp;
+        temp.setParentTransform(&root, true);
+    }
+    QCOMPARE(leaf.parentTransform() == &child, true);
+    QCOMPARE(root.worldPosition(), Vector3(-1.0f, 0.0f, 0.0f));
+}
+
+void Fixed_step_interpolation() {
+    Timer::reset();
+    Timer::init();
+    this_thread::sleep_for(chrono::milliseconds(10));
+    Timer::update();
+    float delta = Timer::deltaTime();
+    QCOMPARE(delta > 0.0f, true);
+
+    // Two steps are executed, the half of step is left for the next frame
+    Timer::setFixedDeltaTime(delta / 2.5f);
+    QCOMPARE(Timer::consumeFixedSteps(), 2U);
+    QCOMPARE(fabs(Timer::interpolation() - 0.5f) < 1.0e-3f, true);
+    QCOMPARE(Timer::consumeFixedSteps(), 0U);
+    QCOMPARE(fabs(Timer::interpolation() - 0.5f) < 1.0e-3f, true);
+    Timer::setFixedDeltaTime(1.0f / 60.0f);
+    Timer::reset();
+
+    Transform root;
+    Transform child;
+    child.setParentTransform(&root, true);
+    child.setPosition(Vector3(0.0f, 1.0f, 0.0f));
+
+    // No fixed steps were stored, the current state is used
+    TransformStore::update(nullptr);
+    QCOMPARE(child.interpolatedPosition(0.5f), Vector3(0.0f, 1.0f, 0.0f));
+
+    TransformStore::storeFixedStep();
+    QCOMPARE(child.interpolatedPosition(0.5f), Vector3(0.0f, 1.0f, 0.0f));
+
+    root.setPosition(Vector3(2.0f, 0.0f, 0.0f));
+    TransformStore::update(nullptr);
+    TransformStore::storeFixedStep();
+    QCOMPARE(child.interpolatedPosition(0.0f), Vector3(0.0f, 1.0f, 0.0f));
+    QCOMPARE(child.interpolatedPosition(0.5f), Vector3(1.0f, 1.0f, 0.0f));
+    QCOMPARE(child.interpolatedPosition(1.0f), Vector3(2.0f, 1.0f, 0.0f));
+    QCOMPARE(child.interpolatedTransform(0.5f)[12], 1.0f);
+
+    // Modifications after the last step don't affect the blended state
+    root.setPosition(Vector3(4.0f, 0.0f, 0.0f));
+    QCOMPARE(child.interpolatedPosition(1.0f), Vector3(2.0f, 1.0f, 0.0f));
+}
+
+void Render_snapshot() {
+    ObjectSystem system;
+    Actor::registerClassFactory(&system);
+    Transform::registerClassFactory(&system);
+    MeshRender::registerClassFactory(&system);
+
+    Actor actor;
+    actor.addComponent("Transform");
+    MeshRender *render = dynamic_cast<MeshRender *>(actor.addComponent("MeshRender"));
+    QCOMPARE(render != nullptr, true);
+    QCOMPARE(render->hasSnapshot(), false);
+
+    actor.transform()->setPosition(Vector3(1.0f, 2.0f, 3.0f));
+    render->extractSnapshot();
+    const RenderSnapshot &first = render->snapshot();
+    QCOMPARE(first.m_Transform[12], 1.0f);
+    QCOMPARE(first.m_Layers, actor.layers());
+
+    // Modification of the components must not affect the published snapshot
+    actor.transform()->setPosition(Vector3(4.0f, 5.0f, 6.0f));
+    QCOMPARE(render->snapshot().m_Transform[12], 1.0f);
+
+    render->extractSnapshot();
+    QCOMPARE(render->snapshot().m_Transform[12], 4.0f);
+    QCOMPARE(first.m_Transform[12], 1.0f);
+}
+
 void Add_Remove_Component() {
     ObjectSystem system;
     Actor::registerClassFactory(&system);
@@ -102,6 +218,82 @@ void Add_Remove_Component() {
     QCOMPARE(a1.getChildren().size(), 0);
 }
 
+void Find_Component() {
+    ObjectSystem system;
+    Actor::registerClassFactory(&system);
+    Transform::registerClassFactory(&system);
+    MeshRender::registerClassFactory(&system);
+
+    Actor *actor = ObjectSystem::objectCreate<Actor>();
+    Transform *transform = static_cast<Transform *>(actor->addComponent("Transform"));
+    MeshRender *render = static_cast<MeshRender *>(actor->addComponent("MeshRender"));
+
+    QCOMPARE(int(actor->components().size()), 2);
+    QCOMPARE(actor->transform(), transform);
+    QCOMPARE(actor->findComponent<MeshRender>(), render);
+    QCOMPARE(actor->findComponent<Renderable>(), static_cast<Renderable *>(render));
+    QCOMPARE(actor->component("Renderable"), static_cast<Component *>(render));
+    QCOMPARE(actor->findComponent<Camera>(), static_cast<Camera *>(nullptr));
+    QCOMPARE(actor->component("Unknown"), static_cast<Component *>(nullptr));
+
+    delete render;
+    QCOMPARE(int(actor->components().size()), 1);
+    QCOMPARE(actor->findComponent<Renderable>(), static_cast<Renderable *>(nullptr));
+
+    delete transform;
+    QCOMPARE(actor->components().empty(), true);
+    QCOMPARE(actor->transform(), static_cast<Transform *>(nullptr));
+
+    delete actor;
+}
+
+void Scene_registry() {
+    ObjectSystem system;
+    Scene::registerClassFactory(&system);
+    Actor::registerClassFactory(&system);
+    Transform::registerClassFactory(&system);
+    MeshRender::registerClassFactory(&system);
+
+    const uint32_t type = Renderable::metaClass()->typeId();
+
+    Scene *scene = ObjectSystem::objectCreate<Scene>();
+    Actor *root = ObjectSystem::objectCreate<Actor>();
+    Actor *child = ObjectSystem::objectCreate<Actor>("Child", root);
+    MeshRender *render1 = static_cast<MeshRender *>(root->addComponent("MeshRender"));
+    MeshRender *render2 = static_cast<MeshRender *>(child->addComponent("MeshRender"));
+    child->addComponent("Transform");
+    QCOMPARE(root->scene(), static_cast<Scene *>(nullptr));
+    QCOMPARE(scene->components(type).empty(), true);
+    // Attachment of the hierarchy registers the components of all nested actors
+    root->setParent(scene);
+    QCOMPARE(child->scene(), scene);
+    QCOMPARE(int(scene->components(type).size()), 2);
+    QCOMPARE(scene->components(type)[0], static_cast<Component *>(render1));
+    QCOMPARE(scene->components(type)[1], static_cast<Component *>(render2));
+    QCOMPARE(scene->components(Transform::metaClass()->typeId()).empty(), true);
+
+    MeshRender *render3 = static_cast<MeshRender *>(child->addComponent("MeshRender"));
+    QCOMPARE(int(scene->components(type).size()), 3);
+
+    delete render2;
+    QCOMPARE(int(scene->components(type).size()), 2);
+    QCOMPARE(scene->components(type)[1], static_cast<Component *>(render3));
+
+    child->setParent(nullptr);
+    QCOMPARE(child->scene(), static_cast<Scene *>(nullptr));
+    QCOMPARE(int(scene->components(type).size()), 1);
+
+    child->setParent(root);
+    QCOMPARE(int(scene->components(type).size()), 2);
+
+    delete root;
+    QCOMPARE(child->scene(), static_cast<Scene *>(nullptr));
+    QCOMPARE(scene->components(type).empty(), true);
+
+    delete child;
+    delete scene;
+}
+
 void Prefab_serialization() {
     Engine system(nullptr, "");
     SkinnedMeshRender::registerClassFactory(&system);
@@ -304,6 +496,136 @@ void Update_prefab() {
     delete prefab;
 }
 
+void Benchmark_Iterate_Components_data() {
+    QTest::addColumn<bool>("pool");
+
+    QTest::newRow("Heap") << false;
+    QTest::newRow("Pool") << true;
+}
+
+void Benchmark_Iterate_Components() {
+    // Run with "-perf -perfcounter cache-misses" to compare the cache misses instead of time
+    QFETCH(bool, pool);
+
+    const int count = 100000;
+
+    vector<Transform *> transforms;
+    vector<MeshRender *> renders;
+    vector<string *> noise;
+    transforms.reserve(count);
+    renders.reserve(count);
+    noise.reserve(count);
+    // Components are created interleaved with the other allocations as it happens during the scene loading
+    for(int i = 0; i < count; i++) {
+        if(pool) {
+            transforms.push_back(static_cast<Transform *>(ObjectPool::create(Transform::metaClass())));
+            renders.push_back(static_cast<MeshRender *>(ObjectPool::create(MeshRender::metaClass())));
+        } else {
+            transforms.push_back(new Transform);
+            renders.push_back(new MeshRender);
+        }
+        noise.push_back(new string(64 + (i % 7) * 16, 'x'));
+    }
+
+    float sum = 0.0f;
+    QBENCHMARK {
+        for(auto it : transforms) {
+            sum += it->worldTransform()[12];
+        }
+        for(auto it : renders) {
+            if(it->mesh()) {
+                sum += 1.0f;
+            }
+        }
+    }
+    QCOMPARE(sum, 0.0f);
+
+    for(int i = 0; i < count; i++) {
+        delete transforms[i];
+        delete renders[i];
+        delete noise[i];
+    }
+}
+
+void Benchmark_Find_Component_data() {
+    QTest::addColumn<bool>("typeId");
+
+    QTest::newRow("Name") << false;
+    QTest::newRow("TypeId") << true;
+}
+
+void Benchmark_Find_Component() {
+    QFETCH(bool, typeId);
+
+    ObjectSystem system;
+    Actor::registerClassFactory(&system);
+    Transform::registerClassFactory(&system);
+    MeshRender::registerClassFactory(&system);
+    Camera::registerClassFactory(&system);
+
+    Actor *actor = ObjectSystem::objectCreate<Actor>();
+    actor->addComponent("Transform");
+    actor->addComponent("Camera");
+    actor->addComponent("MeshRender");
+
+    int found = 0;
+    QBENCHMARK {
+        for(int i = 0; i < 10000; i++) {
+            Component *component = (typeId) ? actor->findComponent<Renderable>() : actor->component("Renderable");
+            if(component) {
+                found++;
+            }
+        }
+    }
+    QCOMPARE((found > 0), true);
+
+    delete actor;
+}
+
+void Benchmark_Spawn_Prefab_data() {
+    QTest::addColumn<bool>("batch");
+
+    QTest::newRow("Clone") << false;
+    QTest::newRow("Batch") << true;
+}
+
+void Benchmark_Spawn_Prefab() {
+    QFETCH(bool, batch);
+
+    const int count = 100;
+
+    Engine system(nullptr, "");
+    TestComponent::registerClassFactory(&system);
+
+    Actor *prefab = Engine::composeActor("", "Prefab");
+    Actor *parent = prefab;
+    for(int i = 0; i < 256; i++) {
+        Actor *actor = Engine::composeActor("TestComponent", "Level", (i % 16 == 0) ? prefab : parent);
+        actor->transform()->setPosition(Vector3(1.0f, 0.0f, 0.0f));
+        parent = actor;
+    }
+
+    Prefab *fab = Engine::objectCreate<Prefab>("");
+    fab->setActor(prefab);
+
+    QBENCHMARK {
+        Object::ObjectList instances;
+        if(batch) {
+            instances = prefab->cloneBatch(count);
+        } else {
+            for(int i = 0; i < count; i++) {
+                instances.push_back(prefab->clone());
+            }
+        }
+        QCOMPARE(int(instances.size()), count);
+        for(auto it : instances) {
+            delete it;
+        }
+    }
+
+    delete fab;
+}
+
 } REGISTER(ActorTest)
 
 #include "tst_actor.moc"
@@ -0,0 +1,176 @@
+#include "tst_common.h"
+
+#include "resources/mesh.h"
+
+#include <engine.h>
+
+#include <cmath>
+
+class MeshTest : public QObject {
+    Q_OBJECT
+
+    static Mesh *createMesh(uint32_t count, int flags) {
+        Lod lod;
+        Vector3Vector vertices;
+        Vector3Vector normals;
+        Vector2Vector uvs;
+        Vector4Vector colors;
+        IndexVector indices;
+        for(uint32_t i = 0; i < count; i++) {
+            vertices.push_back(Vector3(i, 0.5f * i, -1.0f * i));
+            normals.push_back(Vector3(0.0f, (i % 2) ? 1.0f : -1.0f, 0.5f));
+            uvs.push_back(Vector2(0.25f, 0.75f));
+            colors.push_back(Vector4(0.0f, 1.0f, 0.0f, 1.0f));
+            indices.push_back(count - i - 1);
+        }
+        lod.setVertices(vertices);
+        lod.setIndices(indices);
+        if(flags & Mesh::Normals) {
+            lod.setNormals(normals);
+        }
+        if(flags & Mesh::Uv0) {
+            lod.setUv0(uvs);
+        }
+        if(flags & Mesh::Color) {
+            lod.setColors(colors);
+        }
+
+        Mesh *mesh = new Mesh;
+        mesh->setFlags(flags);
+        mesh->addLod(&lod);
+        return mesh;
+    }
+
+private slots:
+
+void Pack_round_trip() {
+    int flags = Mesh::Normals | Mesh::Uv0 | Mesh::Color;
+    for(int quantize = 0; quantize < 2; quantize++) {
+        Mesh *source = createMesh(16, flags);
+        Lod origin = *source->lod(0);
+
+        Mesh *mesh = createMesh(16, flags);
+        mesh->pack(quantize);
+
+        const Lod *lod = mesh->lod(0);
+        QCOMPARE(lod->isPacked(), true);
+        QCOMPARE(lod->isQuantized(), bool(quantize));
+        QCOMPARE(lod->vertexCount(), 16U);
+        QCOMPARE(lod->indexCount(), 16U);
+
+        // All values are representable by the half floats, so the quantized stream is decoded exactly
+        QCOMPARE(lod->vertices() == origin.vertices(), true);
+        QCOMPARE(lod->normals() == origin.normals(), true);
+        QCOMPARE(lod->uv0() == origin.uv0(), true);
+        QCOMPARE(lod->colors() == origin.colors(), true);
+        QCOMPARE(lod->indices() == origin.indices(), true);
+        // Reading must not convert the shared resource back to the separate attributes
+        QCOMPARE(lod->isPacked(), true);
+        QCOMPARE(*lod == origin, true);
+        QCOMPARE(lod->isPacked(), true);
+
+        delete mesh;
+        delete source;
+    }
+}
+
+void Half_conversion() {
+    Lod lod;
+    lod.setVertices({Vector3(), Vector3(), Vector3(), Vector3()});
+    lod.setNormals({Vector3(65504.0f, -65504.0f, 1.0e6f),
+                    Vector3(1.0e-8f, -1.0e-8f, 0.0f),
+                    Vector3(-2.0f, 1.0f / 3.0f, 2048.0f),
+                    Vector3(6.103515625e-05f, 0.1f, -0.0f)});
+    lod.setIndices({0, 1, 2, 3});
+
+    Mesh mesh;
+    mesh.setFlags(Mesh::Normals);
+    mesh.addLod(&lod);
+    mesh.pack(true);
+
+    const Vector3Vector &normals = static_cast<const Lod *>(mesh.lod(0))->normals();
+    // Max half values are kept, overflowed ones become infinity
+    QCOMPARE(normals[0].x, 65504.0f);
+    QCOMPARE(normals[0].y, -65504.0f);
+    QCOMPARE(std::isinf(normals[0].z), true);
+    // Too small values are flushed to zero
+    QCOMPARE(normals[1].x, 0.0f);
+    QCOMPARE(normals[1].y, 0.0f);
+    QCOMPARE(normals[1].z, 0.0f);
+
+    QCOMPARE(normals[2].x, -2.0f);
+    QCOMPARE(std::fabs(normals[2].y - 1.0f / 3.0f) < 1.0e-3f, true);
+    QCOMPARE(normals[2].z, 2048.0f);
+    // The smallest normal half value
+    QCOMPARE(normals[3].x, 6.103515625e-05f);
+    QCOMPARE(std::fabs(normals[3].y - 0.1f) < 1.0e-4f, true);
+}
+
+void Index_size() {
+    Mesh *small = createMesh(3, 0);
+    small->pack(false);
+    QCOMPARE(small->lod(0)->indexSize(), uint32_t(sizeof(uint16_t)));
+    QCOMPARE(static_cast<const Lod *>(small->lod(0))->indices() == IndexVector({2, 1, 0}), true);
+    delete small;
+
+    // The last vertex can't be addressed by 16-bit indices
+    Mesh *large = createMesh(0x10001, 0);
+    large->pack(false);
+    const Lod *lod = large->lod(0);
+    QCOMPARE(lod->indexSize(), uint32_t(sizeof(uint32_t)));
+    QCOMPARE(lod->indices().front(), 0x10000U);
+    QCOMPARE(lod->indices().back(), 0U);
+    delete large;
+}
+
+void Corrupted_stream() {
+    Engine system(nullptr, "");
+
+    Mesh *mesh = createMesh(8, Mesh::Normals);
+    mesh->pack(true);
+    VariantMap data = static_cast<Object *>(mesh)->saveUserData();
+    delete mesh;
+
+    VariantList surface = data["Data"].value<VariantList>();
+    VariantList lod = surface.back().value<VariantList>();
+    auto it = lod.begin();
+    std::advance(it, 3);
+
+    // Truncated vertex stream
+    VariantMap corrupted = data;
+    VariantList l = lod;
+    auto vertices = l.begin();
+    std::advance(vertices, 3);
+    *vertices = ByteArray((*it).toByteBuffer().size() - 1);
+    surface.back() = l;
+    corrupted["Data"] = surface;
+
+    Mesh broken;
+    static_cast<Object *>(&broken)->loadUserData(corrupted);
+    QCOMPARE(broken.lodsCount(), 1);
+    QCOMPARE(broken.lod(0)->isPacked(), false);
+    QCOMPARE(broken.lod(0)->vertexCount(), 0U);
+
+    // Index stream which fits neither 16-bit nor 32-bit indices
+    l = lod;
+    auto indices = l.begin();
+    std::advance(indices, 4);
+    *indices = ByteArray(8 * 3);
+    surface.back() = l;
+    corrupted["Data"] = surface;
+
+    Mesh wrong;
+    static_cast<Object *>(&wrong)->loadUserData(corrupted);
+    QCOMPARE(wrong.lod(0)->isPacked(), false);
+    QCOMPARE(wrong.lod(0)->indexCount(), 0U);
+
+    // The valid data is loaded as is
+    Mesh valid;
+    static_cast<Object *>(&valid)->loadUserData(data);
+    QCOMPARE(valid.lod(0)->isPacked(), true);
+    QCOMPARE(valid.lod(0)->vertexCount(), 8U);
+}
+
+} REGISTER(MeshTest)
+
+#include "tst_mesh.moc"
@@ -0,0 +1,110 @@
+#include "tst_common.h"
+
+#include "resources/texture.h"
+
+#include <cstring>
+
+#define HEADER_WIDTH    24
+#define HEADER_LEVELS   40
+#define LEVEL_SIZE      (48 + 4)
+
+class TextureTest : public QObject {
+    Q_OBJECT
+
+    static Texture *createTexture(int faces) {
+        Texture *texture = new Texture;
+        texture->setFormat(Texture::RGBA8);
+        texture->setWidth(16);
+        texture->setHeight(8);
+        for(int f = 0; f < faces; f++) {
+            Texture::Surface surface;
+            int w = 16;
+            int h = 8;
+            while(true) {
+                ByteArray pixels(w * h * 4);
+                for(size_t i = 0; i < pixels.size(); i++) {
+                    pixels[i] = static_cast<int8_t>(i + f + w);
+                }
+                surface.push_back(pixels);
+                if(w == 1 && h == 1) {
+                    break;
+                }
+                w = MAX(w / 2, 1);
+                h = MAX(h / 2, 1);
+            }
+            texture->addSurface(surface);
+        }
+        return texture;
+    }
+
+    static bool isRejected(const ByteArray &image) {
+        VariantMap data;
+        data["Image"] = image;
+
+        Texture texture;
+        static_cast<Object *>(&texture)->loadUserData(data);
+        return !texture.isPacked() && texture.mipCount() == 0;
+    }
+
+private slots:
+
+void Pack_round_trip() {
+    for(int faces : {1, 6}) {
+        Texture *texture = createTexture(faces);
+        VariantMap data = static_cast<Object *>(texture)->saveUserData();
+
+        Texture result;
+        static_cast<Object *>(&result)->loadUserData(data);
+        QCOMPARE(result.isPacked(), true);
+        QCOMPARE(result.width(), 16);
+        QCOMPARE(result.height(), 8);
+        QCOMPARE(result.mipCount(), 5);
+        QCOMPARE(result.isCubemap(), faces == 6);
+        for(int f = 0; f < faces; f++) {
+            for(int l = 0; l < 5; l++) {
+                QCOMPARE(result.level(f, l) == ByteBuffer(texture->surface(f)[l]), true);
+            }
+        }
+
+        delete texture;
+    }
+}
+
+void Corrupted_image() {
+    Texture *texture = createTexture(1);
+    ByteArray image = static_cast<Object *>(texture)->saveUserData()["Image"].toByteArray();
+    delete texture;
+
+    QCOMPARE(isRejected(image), false);
+    // Truncated table of levels
+    QCOMPARE(isRejected(ByteArray(image.begin(), image.begin() + LEVEL_SIZE)), true);
+
+    uint32_t value = 0;
+    // Zero width
+    ByteArray corrupted = image;
+    memcpy(&corrupted[HEADER_WIDTH], &value, sizeof(value));
+    QCOMPARE(isRejected(corrupted), true);
+    // No levels
+    corrupted = image;
+    memcpy(&corrupted[HEADER_LEVELS], &value, sizeof(value));
+    QCOMPARE(isRejected(corrupted), true);
+    // The first level is smaller than 16x8 pixels
+    corrupted = image;
+    value = 16 * 8 * 4 - 1;
+    memcpy(&corrupted[LEVEL_SIZE], &value, sizeof(value));
+    QCOMPARE(isRejected(corrupted), true);
+}
+
+void Pack_empty_face() {
+    Texture *texture = createTexture(6);
+    // The face without levels can't be stored in the image
+    texture->surface(5).clear();
+    VariantMap data = static_cast<Object *>(texture)->saveUserData();
+    QCOMPARE(data.find("Image") == data.end(), true);
+
+    delete texture;
+}
+
+} REGISTER(TextureTest)
+
+#include "tst_texture.moc"
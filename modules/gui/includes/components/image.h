@@ -38,6 +38,8 @@ public:
 private:
     void draw(CommandBuffer &buffer, uint32_t layer) override;
 
+    void fillSnapshot(RenderSnapshot &snapshot) const override;
+
     void loadUserData(const VariantMap &data) override;
     VariantMap saveUserData() const override;
 
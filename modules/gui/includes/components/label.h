@@ -51,6 +51,8 @@ public:
 private:
     void draw(CommandBuffer &buffer, uint32_t layer) override;
 
+    void fillSnapshot(RenderSnapshot &snapshot) const override;
+
     void loadData(const VariantList &data) override;
     void loadUserData(const VariantMap &data) override;
     VariantMap saveUserData() const override;
@@ -17,6 +17,12 @@ private:
 
     int threadPolicy() const override;
 
+    int phase() const override;
+
+    int reads() const override;
+
+    int writes() const override;
+
     Object *instantiateObject(const MetaObject *meta, Object *parent) override;
 
     void composeComponent(Component *component) const override;
@@ -39,12 +39,12 @@ public:
 
 AbstractButton::AbstractButton() :
     Widget(),
-    p_ptr(new AbstractButtonPrivate) {
+    p_ptr(createPrivate<AbstractButtonPrivate>()) {
 
 }
 
 AbstractButton::~AbstractButton() {
-    delete p_ptr;
+    destroyPrivate(p_ptr);
 }
 
 float AbstractButton::fadeDuration() const {
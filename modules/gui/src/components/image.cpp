@@ -84,29 +84,36 @@ public:
 };
 
 Image::Image() :
-    p_ptr(new ImagePrivate(this)) {
+    p_ptr(createPrivate<ImagePrivate>(this)) {
 
 }
 
 Image::~Image() {
-    delete p_ptr;
+    destroyPrivate(p_ptr);
 }
 
 /*!
     \internal
 */
 void Image::draw(CommandBuffer &buffer, uint32_t layer) {
-    Actor *a = actor();
-    if(p_ptr->m_pCustomMesh) {
+    const RenderSnapshot &s = snapshot();
+    if(s.m_pMesh) {
         if(layer & CommandBuffer::RAYCAST) {
-            buffer.setColor(CommandBuffer::idToColor(a->uuid()));
+            buffer.setColor(CommandBuffer::idToColor(actor()->uuid()));
         }
-        buffer.drawMesh(a->transform()->worldTransform(),
-                        p_ptr->m_pCustomMesh,
-                        0, layer, (p_ptr->m_pCustomMaterial) ? p_ptr->m_pCustomMaterial : p_ptr->m_pMaterial);
+        buffer.drawMesh(s.m_Transform, s.m_pMesh, 0, layer, s.m_pMaterial);
         buffer.setColor(Vector4(1.0f));
     }
 }
+/*!
+    \internal
+*/
+void Image::fillSnapshot(RenderSnapshot &snapshot) const {
+    Renderable::fillSnapshot(snapshot);
+
+    snapshot.m_pMesh = p_ptr->m_pCustomMesh;
+    snapshot.m_pMaterial = (p_ptr->m_pCustomMaterial) ? p_ptr->m_pCustomMaterial : p_ptr->m_pMaterial;
+}
 
 /*!
     Returns an instantiated Material assigned to SpriteRender.
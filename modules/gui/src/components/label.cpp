@@ -91,26 +91,37 @@ public:
 */
 
 Label::Label() :
-        p_ptr(new LabelPrivate(this)) {
+        p_ptr(createPrivate<LabelPrivate>(this)) {
 
 }
 
 Label::~Label() {
-    delete p_ptr;
+    destroyPrivate(p_ptr);
 }
 /*!
     \internal
 */
 void Label::draw(CommandBuffer &buffer, uint32_t layer) {
-    Actor *a = actor();
-    if(p_ptr->m_pMesh && !p_ptr->m_Text.empty()) {
+    const RenderSnapshot &s = snapshot();
+    if(s.m_pMesh) {
         if(layer & CommandBuffer::RAYCAST) {
-            buffer.setColor(CommandBuffer::idToColor(a->uuid()));
+            buffer.setColor(CommandBuffer::idToColor(actor()->uuid()));
         }
-        buffer.drawMesh(a->transform()->worldTransform(), p_ptr->m_pMesh, 0, layer, p_ptr->m_pMaterial);
+        buffer.drawMesh(s.m_Transform, s.m_pMesh, 0, layer, s.m_pMaterial);
         buffer.setColor(Vector4(1.0f));
     }
 }
+/*!
+    \internal
+*/
+void Label::fillSnapshot(RenderSnapshot &snapshot) const {
+    Renderable::fillSnapshot(snapshot);
+
+    if(!p_ptr->m_Text.empty()) {
+        snapshot.m_pMesh = p_ptr->m_pMesh;
+    }
+    snapshot.m_pMaterial = p_ptr->m_pMaterial;
+}
 /*!
     Returns the text which will be drawn.
 */
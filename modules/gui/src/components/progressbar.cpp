@@ -52,12 +52,12 @@ public:
 
 ProgressBar::ProgressBar() :
     Widget(),
-    p_ptr(new ProgressBarPrivate) {
+    p_ptr(createPrivate<ProgressBarPrivate>()) {
 
 }
 
 ProgressBar::~ProgressBar() {
-    delete p_ptr;
+    destroyPrivate(p_ptr);
 }
 
 float ProgressBar::from() const {
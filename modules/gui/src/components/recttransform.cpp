@@ -26,7 +26,7 @@ public:
 };
 
 RectTransform::RectTransform() :
-    p_ptr(new RectTransformPrivate) {
+    p_ptr(createPrivate<RectTransformPrivate>()) {
 
 }
 
@@ -35,7 +35,7 @@ RectTransform::~RectTransform() {
     for(auto it : list) {
         it->setRectTransform(nullptr);
     }
-    delete p_ptr;
+    destroyPrivate(p_ptr);
 }
 
 Vector2 RectTransform::size() const {
@@ -33,12 +33,12 @@ public:
 
 Switch::Switch() :
     AbstractButton(),
-    p_ptr(new SwitchPrivate) {
+    p_ptr(createPrivate<SwitchPrivate>()) {
 
 }
 
 Switch::~Switch() {
-    delete p_ptr;
+    destroyPrivate(p_ptr);
 
 }
 
@@ -23,7 +23,7 @@ public:
 };
 
 Widget::Widget() :
-    p_ptr(new WidgetPrivate) {
+    p_ptr(createPrivate<WidgetPrivate>()) {
 
 }
 
@@ -31,7 +31,7 @@ Widget::~Widget() {
     if(p_ptr->m_pTransform) {
         p_ptr->m_pTransform->unsubscribe(this);
     }
-    delete p_ptr;
+    destroyPrivate(p_ptr);
 }
 
 void Widget::update() {
@@ -95,7 +95,7 @@ void Widget::actorParentChanged() {
 
         object = dynamic_cast<Actor *>(object->parent());
         if(object) {
-            p_ptr->m_pParent = static_cast<Widget *>(object->component("Widget"));
+            p_ptr->m_pParent = object->findComponent<Widget>();
         }
     }
 }
@@ -61,6 +61,18 @@ int GuiSystem::threadPolicy() const {
     return Main;
 }
 
+int GuiSystem::phase() const {
+    return PostUpdate;
+}
+
+int GuiSystem::reads() const {
+    return Transforms | Components;
+}
+
+int GuiSystem::writes() const {
+    return Components;
+}
+
 Object *GuiSystem::instantiateObject(const MetaObject *meta, Object *parent) {
     Object *result = System::instantiateObject(meta, parent);
     Actor *actor = dynamic_cast<Actor *>(parent);
@@ -18,6 +18,12 @@ public:
 
     int threadPolicy() const;
 
+    int phase() const;
+
+    int reads() const;
+
+    int writes() const;
+
 protected:
     ALCdevice                  *m_pDevice;
     ALCcontext                 *m_pContext;
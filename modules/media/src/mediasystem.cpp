@@ -72,3 +72,15 @@ void MediaSystem::update(Scene *) {
 int MediaSystem::threadPolicy() const {
     return Pool;
 }
+
+int MediaSystem::phase() const {
+    return PostUpdate;
+}
+
+int MediaSystem::reads() const {
+    return Transforms | Components;
+}
+
+int MediaSystem::writes() const {
+    return Nothing;
+}
@@ -24,6 +24,12 @@ public:
 
     int threadPolicy() const override;
 
+    int phase() const override;
+
+    int reads() const override;
+
+    int writes() const override;
+
 protected:
     bool m_Inited;
 
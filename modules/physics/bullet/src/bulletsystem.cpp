@@ -10,6 +10,8 @@
 #include <log.h>
 #include <timer.h>
 
+#include <analytics/performancecounter.h>
+
 #include <components/scene.h>
 #include <components/actor.h>
 
@@ -21,6 +23,8 @@
 
 #include "resources/physicmaterial.h"
 
+static PerformanceCounter gPhysicsPairs("Physics Pairs", PerformanceCounter::Gauge);
+
 BulletSystem::BulletSystem(Engine *engine) :
         System(),
         m_Inited(false),
@@ -105,6 +109,7 @@ void BulletSystem::update(Scene *scene) {
             body->dirtyContacts();
         }
 
+        gPhysicsPairs.set(m_pDispatcher->getNumManifolds());
         for(int i = 0; i < m_pDispatcher->getNumManifolds(); i++) {
             btPersistentManifold *contact = m_pDispatcher->getManifoldByIndexInternal(i);
 
@@ -128,10 +133,22 @@ void BulletSystem::update(Scene *scene) {
             body->cleanContacts();
         }
 
-        world->stepSimulation(Timer::deltaTime(), 4);
+        world->stepSimulation(Timer::fixedDeltaTime(), 0);
     }
 }
 
 int BulletSystem::threadPolicy() const {
     return Pool;
 }
+
+int BulletSystem::phase() const {
+    return FixedUpdate;
+}
+
+int BulletSystem::reads() const {
+    return Transforms | Components;
+}
+
+int BulletSystem::writes() const {
+    return Transforms | Components;
+}
@@ -52,10 +52,12 @@ void Collider::dirtyContacts() {
 }
 
 void Collider::cleanContacts() {
+    static const int32_t exitedSignal = Collider::metaClass()->indexOfSignal("exited()");
+
     auto it = m_Collisions.begin();
     while(it != m_Collisions.end()) {
         if(it->second == true) {
-            emitSignal(_SIGNAL(exited()));
+            emitSignal(exitedSignal);
             it = m_Collisions.erase(it);
             m_pCollisionObject->activate(true);
         } else {
@@ -65,17 +67,20 @@ void Collider::cleanContacts() {
 }
 
 void Collider::setContact(Collider *other) {
+    static const int32_t staySignal = Collider::metaClass()->indexOfSignal("stay()");
+    static const int32_t enteredSignal = Collider::metaClass()->indexOfSignal("entered()");
+
     bool result = true;
     for(auto &it : m_Collisions) {
         if(it.first == other->uuid()) {
-            emitSignal(_SIGNAL(stay()));
+            emitSignal(staySignal);
             it.second = false;
             result = false;
             break;
         }
     }
     if(result) {
-        emitSignal(_SIGNAL(entered()));
+        emitSignal(enteredSignal);
         m_Collisions[other->uuid()] = false;
     }
 }
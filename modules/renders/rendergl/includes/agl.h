@@ -10,8 +10,12 @@
     #include <GLFW/glfw3.h>
 #endif
 
-#define POLYGONS    "Polygons"
-#define DRAWCALLS   "Draw Calls"
+#include <analytics/performancecounter.h>
+
+extern PerformanceCounter gPolygons;
+extern PerformanceCounter gDrawCalls;
+extern PerformanceCounter gStateChanges;
+extern PerformanceCounter gUploadedBytes;
 
 void _CheckGLError(const char *file, int line);
 #define CheckGLError()// _CheckGLError(__FILE__, __LINE__)
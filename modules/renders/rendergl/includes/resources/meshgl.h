@@ -30,8 +30,11 @@ public:
 
     uint32_t instance() const;
 
+    uint32_t indexType(uint32_t lod) const;
+
 protected:
     void updateVao(uint32_t lod);
+    void updateInterleavedVao(uint32_t lod);
     void updateVbo(CommandBufferGL *buffer);
 
     void destroyVao(CommandBufferGL *buffer);
@@ -50,6 +53,9 @@ public:
     IndexVector m_weights;
     IndexVector m_bones;
 
+    IndexVector m_indexTypes;
+    IndexVector m_strides;
+
     uint32_t m_InstanceBuffer;
 
     typedef vector<list<VaoStruct *>> VaoVector;
@@ -127,6 +127,7 @@ void CommandBufferGL::drawMesh(const Matrix4 &model, Mesh *mesh, uint32_t sub, u
         uint32_t program = mat->bind(layer, material->surfaceType());
         if(program) {
             glUseProgram(program);
+            gStateChanges.add();
 
             glUniformMatrix4fv(MODEL_UNIFORM, 1, GL_FALSE, model.mat);
 
@@ -136,7 +137,7 @@ void CommandBufferGL::drawMesh(const Matrix4 &model, Mesh *mesh, uint32_t sub, u
 
             Mesh::TriangleTopology topology = static_cast<Mesh::TriangleTopology>(mesh->topology());
             if(topology > Mesh::Lines) {
-                uint32_t vert = l->vertices().size();
+                uint32_t vert = l->vertexCount();
                 int32_t glMode = GL_TRIANGLE_STRIP;
                 switch(topology) {
                 case Mesh::LineStrip:   glMode = GL_LINE_STRIP; break;
@@ -144,13 +145,13 @@ void CommandBufferGL::drawMesh(const Matrix4 &model, Mesh *mesh, uint32_t sub, u
                 default: break;
                 }
                 glDrawArrays(glMode, 0, vert);
-                PROFILER_STAT(POLYGONS, vert - 2);
+                gPolygons.add(vert - 2);
             } else {
-                uint32_t index = l->indices().size();
-                glDrawElements((topology == Mesh::Triangles) ? GL_TRIANGLES : GL_LINES, index, GL_UNSIGNED_INT, nullptr);
-                PROFILER_STAT(POLYGONS, index / 3);
+                uint32_t index = l->indexCount();
+                glDrawElements((topology == Mesh::Triangles) ? GL_TRIANGLES : GL_LINES, index, m->indexType(lod), nullptr);
+                gPolygons.add(index / 3);
             }
-            PROFILER_STAT(DRAWCALLS, 1);
+            gDrawCalls.add();
 
             glBindVertexArray(0);
         }
@@ -174,11 +175,13 @@ void CommandBufferGL::drawMeshInstanced(const Matrix4 *models, uint32_t count, M
 
         if(program) {
             glUseProgram(program);
+            gStateChanges.add();
 
             glUniformMatrix4fv(MODEL_UNIFORM, 1, GL_FALSE, Matrix4().mat);
 
             glBindBuffer(GL_ARRAY_BUFFER, m->instance());
             glBufferData(GL_ARRAY_BUFFER, count * sizeof(Matrix4), models, GL_DYNAMIC_DRAW);
+            gUploadedBytes.add(count * sizeof(Matrix4));
 
             putUniforms(program, material);
 
@@ -186,15 +189,15 @@ void CommandBufferGL::drawMeshInstanced(const Matrix4 *models, uint32_t count, M
 
             Mesh::TriangleTopology topology = static_cast<Mesh::TriangleTopology>(mesh->topology());
             if(topology > Mesh::Lines) {
-                uint32_t vert = l->vertices().size();
+                uint32_t vert = l->vertexCount();
                 glDrawArraysInstanced((topology == Mesh::TriangleStrip) ? GL_TRIANGLE_STRIP : GL_LINE_STRIP, 0, vert, count);
-                PROFILER_STAT(POLYGONS, index - 2 * count);
+                gPolygons.add((vert - 2) * count);
             } else {
-                uint32_t index = l->indices().size();
-                glDrawElementsInstanced((topology == Mesh::Triangles) ? GL_TRIANGLES : GL_LINES, index, GL_UNSIGNED_INT, nullptr, count);
-                PROFILER_STAT(POLYGONS, (index / 3) * count);
+                uint32_t index = l->indexCount();
+                glDrawElementsInstanced((topology == Mesh::Triangles) ? GL_TRIANGLES : GL_LINES, index, m->indexType(lod), nullptr, count);
+                gPolygons.add((index / 3) * count);
             }
-            PROFILER_STAT(DRAWCALLS, 1);
+            gDrawCalls.add();
 
             glBindVertexArray(0);
         }
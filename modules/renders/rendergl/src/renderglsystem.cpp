@@ -16,6 +16,11 @@
 
 #define MAX_RESOLUTION 8192
 
+PerformanceCounter gPolygons("Polygons");
+PerformanceCounter gDrawCalls("Draw Calls");
+PerformanceCounter gStateChanges("State Changes");
+PerformanceCounter gUploadedBytes("Uploaded Bytes");
+
 void _CheckGLError(const char* file, int line) {
     GLenum err ( glGetError() );
 
@@ -59,45 +59,77 @@ void MeshGL::updateVao(uint32_t lod) {
     // vertices
     glBindBuffer(GL_ARRAY_BUFFER, m_vertices[lod]);
     glEnableVertexAttribArray(VERTEX_ATRIB);
-    glVertexAttribPointer(VERTEX_ATRIB, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+    glVertexAttribPointer(VERTEX_ATRIB, 3, GL_FLOAT, GL_FALSE, m_strides[lod], nullptr);
 
     uint8_t flag = flags();
 
+    if(m_strides[lod]) {
+        updateInterleavedVao(lod);
+    } else {
+        if(flag & Mesh::Normals) {
+            glBindBuffer(GL_ARRAY_BUFFER, m_normals[lod]);
+            glEnableVertexAttribArray(NORMAL_ATRIB);
+            glVertexAttribPointer(NORMAL_ATRIB, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+        }
+        if(flag & Mesh::Tangents) {
+            glBindBuffer(GL_ARRAY_BUFFER, m_tangents[lod]);
+            glEnableVertexAttribArray(TANGENT_ATRIB);
+            glVertexAttribPointer(TANGENT_ATRIB, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+        }
+        if(flag & Mesh::Uv0) {
+            glBindBuffer(GL_ARRAY_BUFFER, m_uv0[lod]);
+            glEnableVertexAttribArray(UV0_ATRIB);
+            glVertexAttribPointer(UV0_ATRIB, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+        }
+        if(flag & Mesh::Color) {
+            //glBindBuffer(GL_ARRAY_BUFFER, m_colors[lod]);
+            //glEnableVertexAttribArray(COLOR_ATRIB);
+            //glVertexAttribPointer(COLOR_ATRIB, 4, GL_FLOAT, GL_FALSE, 0, nullptr);
+        }
+        if(flag & Mesh::Skinned) {
+            glBindBuffer(GL_ARRAY_BUFFER, m_bones[lod]);
+            glEnableVertexAttribArray(BONES_ATRIB);
+            glVertexAttribPointer(BONES_ATRIB, 4, GL_FLOAT, GL_FALSE, 0, nullptr);
+
+            glBindBuffer(GL_ARRAY_BUFFER, m_weights[lod]);
+            glEnableVertexAttribArray(WEIGHTS_ATRIB);
+            glVertexAttribPointer(WEIGHTS_ATRIB, 4, GL_FLOAT, GL_FALSE, 0, nullptr);
+        }
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_InstanceBuffer);
+    for(uint32_t i = 0; i < 4; i++) {
+        glEnableVertexAttribArray(INSTANCE_ATRIB + i);
+        glVertexAttribPointer(INSTANCE_ATRIB + i, 4, GL_FLOAT, GL_FALSE, sizeof(Matrix4), reinterpret_cast<void *>(i * sizeof(Vector4)));
+        glVertexAttribDivisor(INSTANCE_ATRIB + i, 1);
+    }
+}
+
+void MeshGL::updateInterleavedVao(uint32_t lod) {
+    uint8_t flag = flags();
+
+    Lod *l = Mesh::lod(lod);
+    VertexLayout layout(flag, l->isQuantized());
+
+    uint32_t vector = (layout.quantized) ? GL_HALF_FLOAT : GL_FLOAT;
     if(flag & Mesh::Normals) {
-        glBindBuffer(GL_ARRAY_BUFFER, m_normals[lod]);
         glEnableVertexAttribArray(NORMAL_ATRIB);
-        glVertexAttribPointer(NORMAL_ATRIB, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+        glVertexAttribPointer(NORMAL_ATRIB, 3, vector, GL_FALSE, layout.stride, reinterpret_cast<void *>(layout.normals));
     }
     if(flag & Mesh::Tangents) {
-        glBindBuffer(GL_ARRAY_BUFFER, m_tangents[lod]);
         glEnableVertexAttribArray(TANGENT_ATRIB);
-        glVertexAttribPointer(TANGENT_ATRIB, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+        glVertexAttribPointer(TANGENT_ATRIB, 3, vector, GL_FALSE, layout.stride, reinterpret_cast<void *>(layout.tangents));
     }
     if(flag & Mesh::Uv0) {
-        glBindBuffer(GL_ARRAY_BUFFER, m_uv0[lod]);
         glEnableVertexAttribArray(UV0_ATRIB);
-        glVertexAttribPointer(UV0_ATRIB, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
-    }
-    if(flag & Mesh::Color) {
-        //glBindBuffer(GL_ARRAY_BUFFER, m_colors[lod]);
-        //glEnableVertexAttribArray(COLOR_ATRIB);
-        //glVertexAttribPointer(COLOR_ATRIB, 4, GL_FLOAT, GL_FALSE, 0, nullptr);
+        glVertexAttribPointer(UV0_ATRIB, 2, vector, GL_FALSE, layout.stride, reinterpret_cast<void *>(layout.uv0));
     }
     if(flag & Mesh::Skinned) {
-        glBindBuffer(GL_ARRAY_BUFFER, m_bones[lod]);
         glEnableVertexAttribArray(BONES_ATRIB);
-        glVertexAttribPointer(BONES_ATRIB, 4, GL_FLOAT, GL_FALSE, 0, nullptr);
+        glVertexAttribPointer(BONES_ATRIB, 4, (layout.quantized) ? GL_UNSIGNED_SHORT : GL_FLOAT, GL_FALSE, layout.stride, reinterpret_cast<void *>(layout.bones));
 
-        glBindBuffer(GL_ARRAY_BUFFER, m_weights[lod]);
         glEnableVertexAttribArray(WEIGHTS_ATRIB);
-        glVertexAttribPointer(WEIGHTS_ATRIB, 4, GL_FLOAT, GL_FALSE, 0, nullptr);
-    }
-
-    glBindBuffer(GL_ARRAY_BUFFER, m_InstanceBuffer);
-    for(uint32_t i = 0; i < 4; i++) {
-        glEnableVertexAttribArray(INSTANCE_ATRIB + i);
-        glVertexAttribPointer(INSTANCE_ATRIB + i, 4, GL_FLOAT, GL_FALSE, sizeof(Matrix4), reinterpret_cast<void *>(i * sizeof(Vector4)));
-        glVertexAttribDivisor(INSTANCE_ATRIB + i, 1);
+        glVertexAttribPointer(WEIGHTS_ATRIB, 4, (layout.quantized) ? GL_UNSIGNED_SHORT : GL_FLOAT, GL_TRUE, layout.stride, reinterpret_cast<void *>(layout.weights));
     }
 }
 
@@ -112,6 +144,8 @@ void MeshGL::updateVbo(CommandBufferGL *buffer) {
     if(m_triangles.size() < count) {
         m_triangles.resize(count);
         m_vertices.resize(count);
+        m_indexTypes.resize(count);
+        m_strides.resize(count);
 
         glGenBuffers(count, &m_triangles[0]);
         glGenBuffers(count, &m_vertices[0]);
@@ -140,35 +174,67 @@ void MeshGL::updateVbo(CommandBufferGL *buffer) {
     bool dynamic = isDynamic();
 
     for(uint32_t i = 0; i < count; i++) {
-        Lod *l = lod(i);
+        const Lod *l = lod(i);
+
+        m_indexTypes[i] = GL_UNSIGNED_INT;
+        m_strides[i] = 0;
+        if(l->isPacked() && !dynamic) {
+            // Interleaved stream goes to the single buffer as is
+            const ByteBuffer &vertices = l->packedVertices();
+            glBindBuffer(GL_ARRAY_BUFFER, m_vertices[i]);
+            glBufferData(GL_ARRAY_BUFFER, vertices.size(), vertices.data(), GL_STATIC_DRAW);
+            gUploadedBytes.add(vertices.size());
+
+            const ByteBuffer &indices = l->packedIndices();
+            if(!indices.empty()) {
+                glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_triangles[i]);
+                glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size(), indices.data(), GL_STATIC_DRAW);
+                gUploadedBytes.add(indices.size());
+            }
+
+            m_indexTypes[i] = (l->indexSize() == sizeof(uint16_t)) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+            m_strides[i] = VertexLayout(flag, l->isQuantized()).stride;
+
+            if(m_Vao.size() <= i) {
+                m_Vao.push_back(list<VaoStruct *>());
+            }
+            continue;
+        }
 
         uint32_t vCount = l->vertices().size();
         if(!l->vertices().empty()) {
             glBindBuffer(GL_ARRAY_BUFFER, m_vertices[i]);
             glBufferData(GL_ARRAY_BUFFER, sizeof(Vector3) * vCount, &l->vertices()[0], (dynamic) ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+            gUploadedBytes.add(sizeof(Vector3) * vCount);
         }
         if(!l->indices().empty()) {
             glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_triangles[i]);
             glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint32_t) * l->indices().size(), &l->indices()[0], (dynamic) ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+            gUploadedBytes.add(sizeof(uint32_t) * l->indices().size());
         }
         if(flag & Mesh::Normals) {
             glBindBuffer(GL_ARRAY_BUFFER, m_normals[i]);
             glBufferData(GL_ARRAY_BUFFER, sizeof(Vector3) * vCount, &l->normals()[0], (dynamic) ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+            gUploadedBytes.add(sizeof(Vector3) * vCount);
         }
         if(flag & Mesh::Tangents) {
             glBindBuffer(GL_ARRAY_BUFFER, m_tangents[i]);
             glBufferData(GL_ARRAY_BUFFER, sizeof(Vector3) * vCount, &l->tangents()[0], (dynamic) ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+            gUploadedBytes.add(sizeof(Vector3) * vCount);
         }
         if(flag & Mesh::Uv0) {
             glBindBuffer(GL_ARRAY_BUFFER, m_uv0[i]);
             glBufferData(GL_ARRAY_BUFFER, sizeof(Vector2) * vCount, &l->uv0()[0], (dynamic) ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+            gUploadedBytes.add(sizeof(Vector2) * vCount);
         }
         if(flag & Mesh::Skinned) {
             glBindBuffer(GL_ARRAY_BUFFER, m_weights[i]);
             glBufferData(GL_ARRAY_BUFFER, sizeof(Vector4) * vCount, &l->weights()[0], (dynamic) ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+            gUploadedBytes.add(sizeof(Vector4) * vCount);
 
             glBindBuffer(GL_ARRAY_BUFFER, m_bones[i]);
             glBufferData(GL_ARRAY_BUFFER, sizeof(Vector4) * vCount, &l->bones()[0], (dynamic) ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+            gUploadedBytes.add(sizeof(Vector4) * vCount);
         }
         if(m_Vao.size() <= i) {
             m_Vao.push_back(list<VaoStruct *>());
@@ -233,8 +299,18 @@ void MeshGL::destroyVbo() {
 
     m_weights.clear();
     m_bones.clear();
+
+    m_indexTypes.clear();
+    m_strides.clear();
 }
 
 uint32_t MeshGL::instance() const {
     return m_InstanceBuffer;
 }
+
+uint32_t MeshGL::indexType(uint32_t lod) const {
+    if(lod < m_indexTypes.size()) {
+        return m_indexTypes[lod];
+    }
+    return GL_UNSIGNED_INT;
+}
@@ -49,9 +49,7 @@ void TextureGL::updateTexture() {
     uint32_t target = isCubemap() ? GL_TEXTURE_CUBE_MAP : GL_TEXTURE_2D;
     glBindTexture(target, m_ID);
 
-    Texture::Sides *sides = getSides();
-
-    bool mipmap = (sides->empty()) ? false : (sides->at(0).size() > 1);
+    bool mipmap = (mipCount() > 1);
 
     int32_t min = (mipmap) ? GL_NEAREST_MIPMAP_NEAREST : GL_NEAREST;
     int32_t mag = GL_NEAREST;
@@ -122,10 +120,10 @@ void TextureGL::updateTexture() {
 
     switch(target) {
         case GL_TEXTURE_CUBE_MAP: {
-            uploadTextureCubemap(sides, target, internal, glformat, type);
+            uploadTextureCubemap(target, internal, glformat, type);
         } break;
         default: {
-            uploadTexture(sides, 0, target, internal, glformat, type);
+            uploadTexture(0, target, internal, glformat, type);
         } break;
     }
 
@@ -144,52 +142,74 @@ void TextureGL::destroyTexture() {
     }
 }
 
-bool TextureGL::uploadTexture(const Sides *sides, uint32_t imageIndex, uint32_t target, uint32_t internal, uint32_t format, uint32_t type) {
+bool TextureGL::uploadTexture(uint32_t imageIndex, uint32_t target, uint32_t internal, uint32_t format, uint32_t type) {
     int32_t w = width();
     int32_t h = height();
 
-    if(sides->empty()) {
+    // Packed levels are streamed to GPU directly from the resource buffer
+    const Sides *sides = (isPacked()) ? nullptr : getSides();
+    if(sides && sides->empty()) {
         glTexImage2D(target, 0, internal, w, h, 0, format, type, nullptr);
     } else {
-        const Surface &image = sides->at(imageIndex);
-        if(isCompressed()) {
-            // load all mipmaps
-            for(uint32_t i = 0; i < image.size(); i++) {
-                const int8_t *data = &(image[i])[0];
-                glCompressedTexImage2D(target, i, internal, (w >> i), (h >> i), 0, size((w >> i), (h >> i)), data);
-                CheckGLError();
-            }
-        } else {
-            GLint alignment = -1;
-            if(!isDwordAligned()) {
-                glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
-                CheckGLError();
-                glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-                CheckGLError();
+        uint32_t count = (sides) ? sides->at(imageIndex).size() : mipCount();
+
+        GLint alignment = -1;
+        if(!isCompressed() && !isDwordAligned()) {
+            glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+            CheckGLError();
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+            CheckGLError();
+        }
+
+        bool result = true;
+        // load all mipmaps
+        for(uint32_t i = 0; i < count; i++) {
+            int32_t mipWidth = MAX(w >> i, 1);
+            int32_t mipHeight = MAX(h >> i, 1);
+            ByteBuffer packed;
+            const int8_t *data = nullptr;
+            uint32_t bytes = 0;
+            if(sides) {
+                const ByteArray &image = sides->at(imageIndex)[i];
+                data = image.data();
+                bytes = image.size();
+            } else {
+                packed = level(imageIndex, i);
+                data = packed.data();
+                bytes = packed.size();
             }
 
-            // load all mipmaps
-            for(uint32_t i = 0; i < image.size(); i++) {
-                const int8_t *data = &(image[i])[0];
-                glTexImage2D(target, i, internal, (w >> i), (h >> i), 0, format, type, data);
-                CheckGLError();
+            // The driver reads the whole level, so the smaller ones would be read out of bounds
+            if(bytes < static_cast<uint32_t>(size(mipWidth, mipHeight))) {
+                result = false;
+                break;
             }
-            if(alignment != -1) {
-                glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
-                CheckGLError();
+
+            if(isCompressed()) {
+                glCompressedTexImage2D(target, i, internal, mipWidth, mipHeight, 0, bytes, data);
+            } else {
+                glTexImage2D(target, i, internal, mipWidth, mipHeight, 0, format, type, data);
             }
+            CheckGLError();
+            gUploadedBytes.add(bytes);
+        }
+
+        if(alignment != -1) {
+            glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+            CheckGLError();
         }
+        return result;
     }
 
     return true;
 }
 
-bool TextureGL::uploadTextureCubemap(const Sides *sides, uint32_t target, uint32_t internal, uint32_t format, uint32_t type) {
+bool TextureGL::uploadTextureCubemap(uint32_t target, uint32_t internal, uint32_t format, uint32_t type) {
     // loop through cubemap faces and load them as 2D textures
     for(uint32_t n = 0; n < 6; n++) {
         // specify cubemap face
         target = GL_TEXTURE_CUBE_MAP_POSITIVE_X + n;
-        if(!uploadTexture(sides, n, target, internal, format, type)) {
+        if(!uploadTexture(n, target, internal, format, type)) {
             return false;
         }
     }
@@ -124,7 +124,7 @@ void AngelBehaviour::updateMeta() {
     uint32_t count = info->GetPropertyCount();
     for(uint32_t i = 0; i <= count; i++) {
         if(i == count) {
-            m_PropertyTable.push_back({nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr});
+            m_PropertyTable.push_back({nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr});
         } else {
             const char *name;
             int typeId;
@@ -178,7 +178,7 @@ void AngelBehaviour::updateMeta() {
                     m_PropertyAdresses[name] = propertyFields;
                     m_PropertyTable.push_back({name, table, nullptr, nullptr, nullptr, nullptr, nullptr,
                                                &Reader<decltype(&AngelBehaviour::readProperty), &AngelBehaviour::readProperty>::read,
-                                               &Writer<decltype(&AngelBehaviour::writeProperty), &AngelBehaviour::writeProperty>::write});
+                                               &Writer<decltype(&AngelBehaviour::writeProperty), &AngelBehaviour::writeProperty>::write, nullptr});
                 }
             }
         }
@@ -0,0 +1,74 @@
+#ifndef PERFORMANCECOUNTER_H
+#define PERFORMANCECOUNTER_H
+
+#include <stdint.h>
+#include <atomic>
+#include <vector>
+
+#include "global.h"
+
+#define COUNTER_SHARDS      8
+#define COUNTER_HISTORY     600
+
+using namespace std;
+
+class NEXT_LIBRARY_EXPORT PerformanceCounter {
+public:
+    enum Type {
+        Counter = 0,
+        Gauge
+    };
+
+    typedef vector<PerformanceCounter *> CounterList;
+
+public:
+    explicit PerformanceCounter (const char *name, Type type = Counter);
+
+    ~PerformanceCounter         ();
+
+    const char                 *name                        () const;
+
+    Type                        type                        () const;
+
+    void                        add                         (int64_t value = 1);
+
+    void                        set                         (int64_t value);
+
+    int64_t                     value                       () const;
+
+    int64_t                     last                        () const;
+
+    vector<int64_t>             history                     (uint32_t frames = COUNTER_HISTORY) const;
+
+    double                      average                     (uint32_t frames = COUNTER_HISTORY) const;
+
+    static PerformanceCounter  *find                        (const char *name);
+
+    static CounterList          counters                    ();
+
+    static void                 frameEnd                    ();
+
+private:
+    PerformanceCounter          (const PerformanceCounter &);
+    PerformanceCounter         &operator=                   (const PerformanceCounter &);
+
+    void                        commit                      ();
+
+private:
+    struct alignas(64) Shard {
+        atomic<int64_t>         value;
+    };
+
+    const char                 *m_pName;
+
+    Type                        m_Type;
+
+    Shard                       m_Shards[COUNTER_SHARDS];
+
+    int64_t                     m_History[COUNTER_HISTORY];
+
+    uint32_t                    m_Frames;
+
+};
+
+#endif // PERFORMANCECOUNTER_H
@@ -1,41 +1,59 @@
 #ifndef PROFILER
 #define PROFILER
 
+#include "global.h"
+
 #ifdef PROFILING_ENABLED
 
-#include <thread>
-#include <unordered_map>
+#include <stdint.h>
+#include <string>
 
-#include "engine.h"
-#include "timer.h"
+using namespace std;
 
 class NEXT_LIBRARY_EXPORT Profiler {
 public:
-    struct CallPoint {
+    struct SourceLocation {
         const char             *name;
 
-        TimePoint               started;
+        const char             *file;
+
+        uint32_t                line;
+    };
+
+    struct Zone {
+        const SourceLocation   *location;
+
+        uint64_t                started;
 
-        TimePoint               stoped;
+        uint64_t                stoped;
     };
 
 public:
-    Profiler                    (const char *name);
+    explicit Profiler           (const SourceLocation *location);
 
     ~Profiler                   ();
 
-    static uint32_t             stat                (const char *name);
+    static bool                 isEnabled           ();
+
+    static void                 setEnabled          (bool enable);
 
-    static void                 statAdd             (const char *name, uint32_t value);
+    static void                 frameBegin          ();
 
-    static void                 statReset           (const char *name);
+    static void                 frameEnd            ();
+
+    static uint64_t             frameIndex          ();
+
+    static bool                 exportTrace         (const string &path);
+
+    static string               traceJson           ();
 
 protected:
-    Profiler::CallPoint         m_Current;
+    const SourceLocation       *m_pLocation;
+
+    uint64_t                    m_Started;
 
 };
 
 #endif
 
 #endif // PROFILER
-
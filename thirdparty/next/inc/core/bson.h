@@ -6,9 +6,72 @@
 
 #include "variant.h"
 
+#define BSON_MAX_DEPTH  64
+
+class NEXT_LIBRARY_EXPORT BsonReader {
+public:
+    explicit BsonReader         (const ByteBuffer &data, MetaType::Type type = MetaType::VARIANTLIST);
+    BsonReader                  (const int8_t *data, uint32_t size, MetaType::Type type = MetaType::VARIANTLIST);
+
+    bool                        isValid                     () const;
+
+    bool                        next                        ();
+
+    bool                        enter                       ();
+    bool                        leave                       ();
+
+    uint32_t                    depth                       () const;
+
+    uint32_t                    type                        () const;
+    const char                 *name                        () const;
+
+    bool                        toBool                      () const;
+    int32_t                     toInt                       () const;
+    float                       toFloat                     () const;
+    string                      toString                    () const;
+    ByteBuffer                  toByteBuffer                () const;
+
+    Variant                     toVariant                   () const;
+
+private:
+    bool                        open                        (uint32_t offset, uint32_t type);
+
+    bool                        readSize                    (uint32_t offset, uint32_t end, uint32_t &size) const;
+
+    Variant                     value                       () const;
+
+    Variant                     document                    () const;
+
+    ByteBuffer                  m_Buffer;
+
+    const int8_t               *m_pData;
+
+    uint32_t                    m_Size;
+
+    uint32_t                    m_Type;
+
+    uint32_t                    m_Name;
+
+    uint32_t                    m_Value;
+
+    uint32_t                    m_Next;
+
+    uint32_t                    m_Depth;
+
+    uint32_t                    m_Ends[BSON_MAX_DEPTH];
+
+    uint32_t                    m_Kinds[BSON_MAX_DEPTH];
+
+    uint32_t                    m_Resumes[BSON_MAX_DEPTH];
+
+    bool                        m_Valid;
+
+};
+
 class NEXT_LIBRARY_EXPORT Bson {
 public:
     static Variant              load                        (const ByteArray &data, MetaType::Type type = MetaType::VARIANTLIST);
+    static Variant              load                        (const ByteBuffer &data, MetaType::Type type = MetaType::VARIANTLIST);
     static ByteArray            save                        (const Variant &data);
 };
 
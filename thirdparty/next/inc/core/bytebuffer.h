@@ -0,0 +1,46 @@
+#ifndef BYTEBUFFER_H
+#define BYTEBUFFER_H
+
+#include <stdint.h>
+#include <vector>
+#include <memory>
+
+#include <global.h>
+
+using namespace std;
+
+typedef vector<int8_t>          ByteArray;
+
+class NEXT_LIBRARY_EXPORT ByteBuffer {
+public:
+    ByteBuffer                  ();
+    explicit ByteBuffer         (ByteArray &&data);
+    explicit ByteBuffer         (const ByteArray &data);
+    ByteBuffer                  (const int8_t *data, uint32_t size);
+
+    bool                        operator==                  (const ByteBuffer &right) const;
+    bool                        operator!=                  (const ByteBuffer &right) const;
+
+    const int8_t               *data                        () const;
+
+    uint32_t                    size                        () const;
+
+    bool                        empty                       () const;
+
+    const int8_t               *begin                       () const;
+    const int8_t               *end                         () const;
+
+    ByteBuffer                  slice                       (uint32_t offset, uint32_t size) const;
+
+    ByteArray                   toByteArray                 () const;
+
+private:
+    shared_ptr<const ByteArray> m_Data;
+
+    uint32_t                    m_Offset;
+
+    uint32_t                    m_Size;
+
+};
+
+#endif // BYTEBUFFER_H
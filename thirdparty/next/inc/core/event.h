@@ -2,6 +2,7 @@
 #define EVENT_H
 
 #include <stdint.h>
+#include <cstddef>
 
 #include <global.h>
 
@@ -23,8 +24,16 @@ public:
 
     uint32_t                    type                        () const;
 
+    static void                *operator new                (size_t size);
+
+    static void                 operator delete             (void *pointer, size_t size);
+
 protected:
+    friend class ObjectPrivate;
+
     uint32_t                    m_Type;
+
+    Event                      *m_pNext;
 };
 
 #endif // EVENT_H
@@ -0,0 +1,54 @@
+#ifndef FRAMEARENA_H
+#define FRAMEARENA_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+#include "global.h"
+
+#define ARENA_BLOCK     (64 * 1024)
+
+using namespace std;
+
+class NEXT_LIBRARY_EXPORT FrameArena {
+public:
+    static void                *allocate                    (size_t size, size_t align = alignof(max_align_t));
+
+    static void                 nextFrame                   ();
+
+    static uint32_t             frameIndex                  ();
+
+    static size_t               usedBytes                   ();
+
+};
+
+template<typename T>
+class FrameAllocator {
+public:
+    typedef T                   value_type;
+
+public:
+    FrameAllocator              () {}
+
+    template<typename U>
+    FrameAllocator              (const FrameAllocator<U> &) {}
+
+    T                          *allocate                    (size_t count) {
+        return static_cast<T *>(FrameArena::allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void                        deallocate                  (T *, size_t) {}
+
+    template<typename U>
+    bool                        operator==                  (const FrameAllocator<U> &) const { return true; }
+
+    template<typename U>
+    bool                        operator!=                  (const FrameAllocator<U> &) const { return false; }
+
+};
+
+template<typename T>
+using FrameVector = vector<T, FrameAllocator<T>>;
+
+#endif // FRAMEARENA_H
@@ -3,13 +3,20 @@
 
 #include <string>
 #include <cstdint>
+#include <functional>
 
 #include "variant.h"
 
 class NEXT_LIBRARY_EXPORT Json {
+public:
+    typedef function<void (const char *, uint32_t)> Writer;
+
 public:
     static Variant              load                        (const string &data);
+    static Variant              load                        (const char *data, uint32_t size);
+
     static string               save                        (const Variant &data, int32_t tab = -1);
+    static void                 save                        (const Variant &data, const Writer &writer, int32_t tab = -1);
 };
 
 #endif // JSON_H
@@ -84,7 +84,7 @@ public: \
     static const MetaProperty::Table *properties() { \
         static const MetaProperty::Table table[] { \
             __VA_ARGS__, \
-            {nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr} \
+            {nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr} \
         }; \
         return table; \
     }
@@ -93,7 +93,7 @@ public: \
 public: \
     static const MetaProperty::Table *properties() { \
         static const MetaProperty::Table table[] { \
-            {nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr} \
+            {nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr} \
         }; \
         return table; \
     }
@@ -107,7 +107,8 @@ public: \
    &Reader<decltype(&r), &r>::address<&r>, \
    &Writer<decltype(&w), &w>::address<&w>, \
     nullptr, \
-    nullptr \
+    nullptr, \
+    Copier<decltype(&r), &r, decltype(&w), &w>::copier() \
 }
 
 #define A_PROPERTYEX(t, p, r, w, a) { \
@@ -119,7 +120,8 @@ public: \
    &Reader<decltype(&r), &r>::address<&r>, \
    &Writer<decltype(&w), &w>::address<&w>, \
     nullptr, \
-    nullptr \
+    nullptr, \
+    Copier<decltype(&r), &r, decltype(&w), &w>::copier() \
 }
 
 // Method declaration
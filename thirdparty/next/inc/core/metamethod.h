@@ -59,6 +59,8 @@ class NEXT_LIBRARY_EXPORT MethodCallEvent : public Event {
 public:
     MethodCallEvent  (int32_t method, Object *sender, const Variant &args);
 
+    MethodCallEvent  (int32_t method, Object *sender, const Variant *args);
+
     Object          *sender     () const;
 
     int32_t          method     () const;
@@ -71,6 +73,8 @@ protected:
     int32_t          m_Method;
 
     Variant          m_Args;
+
+    const Variant   *m_pArgs;
 };
 
 namespace unpack {
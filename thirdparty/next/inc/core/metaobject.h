@@ -2,6 +2,7 @@
 #define METAOBJECT_H
 
 #include <string>
+#include <vector>
 
 #include "metatype.h"
 #include "metaproperty.h"
@@ -34,6 +35,8 @@ public:
 
     int                         indexOfProperty             (const char *) const;
 
+    MetaProperty                findProperty                (const char *) const;
+
     MetaProperty                property                    (int) const;
     int                         propertyCount               () const;
     int                         propertyOffset              () const;
@@ -45,6 +48,14 @@ public:
     int                         enumeratorOffset            () const;
 
     bool                        canCastTo                   (const char *) const;
+    bool                        canCastTo                   (uint32_t) const;
+
+    uint32_t                    typeId                      () const;
+
+    static uint32_t             typeId                      (const char *);
+
+private:
+    int                         findMethod                  (const char *, int) const;
 
 private:
     Constructor                 m_Constructor;
@@ -56,6 +67,12 @@ private:
     int                         m_MethodCount;
     int                         m_PropCount;
     int                         m_EnumCount;
+    int                         m_MethodOffset;
+    int                         m_PropOffset;
+    vector<uint32_t>            m_MethodHashes;
+    vector<string>              m_Signatures;
+    vector<pair<uint32_t, int>> m_PropertyIndex;
+    vector<uint32_t>            m_Hierarchy;
 
 };
 
@@ -13,6 +13,7 @@ public:
     typedef void                (*AddressMem)           (char *, size_t);
     typedef Variant             (*ReadProperty)         (const void *, const MetaProperty&);
     typedef void                (*WriteProperty)        (void *, const MetaProperty&, const Variant&);
+    typedef void                (*CopyMem)              (const void *, void *);
 
     struct Table {
         const char             *name;
@@ -24,6 +25,7 @@ public:
         AddressMem              writemem;
         ReadProperty            readproperty;
         WriteProperty           writeproperty;
+        CopyMem                 copier;
     };
 
 public:
@@ -36,6 +38,10 @@ public:
     Variant                 read                        (const void *object) const;
     void                    write                       (void *object, const Variant &value) const;
 
+    bool                    isTrivial                   () const;
+
+    void                    copy                        (const void *source, void *destination) const;
+
     template<typename T>
     void                    write                       (void *object, const T &value) const {
         uint32_t type = MetaType::type<T>();
@@ -195,4 +201,50 @@ struct Writer<void(Class::*)(const MetaProperty &, const T&), WriteFunc> {
     }
 };
 
+//Property copy
+template<typename Signature>
+struct Accessor;
+
+template<typename T, typename Class>
+struct Accessor<T(Class::*)()> {
+    typedef Class                                   ClassType;
+    typedef typename std::decay<T>::type            T_no_cv;
+};
+
+template<typename T, typename Class>
+struct Accessor<T(Class::*)()const> {
+    typedef const Class                             ClassType;
+    typedef typename std::decay<T>::type            T_no_cv;
+};
+
+template<typename T, typename Class>
+struct Accessor<void(Class::*)(T)> {
+    typedef Class                                   ClassType;
+    typedef typename std::decay<T>::type            T_no_cv;
+};
+
+template<typename R, R ReadFunc, typename W, W WriteFunc,
+         bool Trivial = std::is_same<typename Accessor<R>::T_no_cv, typename Accessor<W>::T_no_cv>::value &&
+                        std::is_trivially_copyable<typename Accessor<R>::T_no_cv>::value &&
+                        !std::is_pointer<typename Accessor<R>::T_no_cv>::value>
+struct Copier {
+    inline static MetaProperty::CopyMem copier() {
+        return nullptr;
+    }
+};
+
+template<typename R, R ReadFunc, typename W, W WriteFunc>
+struct Copier<R, ReadFunc, W, WriteFunc, true> {
+    typedef typename Accessor<R>::ClassType         ReadClass;
+    typedef typename Accessor<W>::ClassType         WriteClass;
+
+    inline static void copy(const void *src, void *dst) {
+        (reinterpret_cast<WriteClass *>(dst)->*WriteFunc)((reinterpret_cast<ReadClass *>(const_cast<void *>(src))->*ReadFunc)());
+    }
+
+    inline static MetaProperty::CopyMem copier() {
+        return &copy;
+    }
+};
+
 #endif // AMETAPROPERTY_H
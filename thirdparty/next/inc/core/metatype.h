@@ -26,6 +26,7 @@ public:
         VARIANTMAP,
         VARIANTLIST,
         BYTEARRAY,
+        BYTEBUFFER,
 
         VECTOR2                 = 10,
         VECTOR3,
@@ -25,6 +25,9 @@
 #include <map>
 #include <queue>
 #include <list>
+#include <new>
+#include <utility>
+#include <functional>
 
 #include <global.h>
 
@@ -100,12 +103,18 @@ public:
 
     virtual ~Object                 ();
 
+    static void                    *operator new                (size_t size);
+    static void                    *operator new                (size_t size, void *place) { A_UNUSED(size); return place; }
+    static void                     operator delete             (void *pointer);
+    static void                     operator delete             (void *pointer, void *place) { A_UNUSED(pointer); A_UNUSED(place); }
+
     static Object                  *construct                   ();
 
     static const MetaObject        *metaClass                   ();
     virtual const MetaObject       *metaObject                  () const;
 
     virtual Object                 *clone                       (Object *parent = nullptr);
+    virtual ObjectList              cloneBatch                  (uint32_t count, Object *parent = nullptr);
 
     Object                         *parent                      () const;
 
@@ -159,6 +168,8 @@ public:
 
     void                            emitSignal                  (const char *signal, const Variant &args = Variant());
 
+    void                            emitSignal                  (int32_t index, const Variant &args = Variant());
+
 // Virtual members
 public:
     virtual const ObjectList       &getChildren                 () const;
@@ -201,7 +212,7 @@ protected:
     VariantList                     serializeData               (const MetaObject *meta) const;
 
     virtual void                    addChild                    (Object *child, int32_t position = -1);
-    void                            removeChild                 (Object *child);
+    virtual void                    removeChild                 (Object *child);
 
     Object                         *sender                      () const;
 
@@ -209,15 +220,43 @@ protected:
 
     virtual void                    methodCallEvent             (MethodCallEvent *event);
 
+    template<typename T, typename... Args>
+    T                              *createPrivate               (Args &&... args) {
+        return new (allocatePrivate(sizeof(T))) T(std::forward<Args>(args)...);
+    }
+
+    template<typename T>
+    static void                     destroyPrivate              (T *pointer) {
+        if(pointer) {
+            pointer->~T();
+            freePrivate(pointer);
+        }
+    }
+
+    void                           *allocatePrivate             (size_t size) const;
+
+    static void                     freePrivate                 (void *pointer);
+
 private:
     friend class ObjectTest;
     friend class ThreadPoolPrivate;
+    friend class ObjectPrivate;
     friend class ObjectSystem;
 
 private:
     void                            setUUID                     (uint32_t id);
 
+    void                            setClonedFrom               (uint32_t id);
+
+    static void                     findIndexed                 (uint32_t id, const function<bool(Object *)> &filter, ObjectList &result);
+
     void                            setSystem                   (ObjectSystem *system);
+
+    Object                         *nextPending                 () const;
+
+    void                            setNextPending              (Object *next);
+
+    Object                         *takePending                 ();
 };
 
 #endif // Object_H
@@ -0,0 +1,104 @@
+#ifndef OBJECTPACK_H
+#define OBJECTPACK_H
+
+#include <cstdint>
+
+#include "variant.h"
+
+class NEXT_LIBRARY_EXPORT ObjectPack {
+public:
+    explicit ObjectPack         (const ByteBuffer &data);
+
+    bool                        isValid                     () const;
+
+    uint32_t                    count                       () const;
+
+    Variant                     toVariant                   () const;
+
+    static ByteArray            save                        (const Variant &objects);
+
+private:
+    friend class ObjectSystem;
+
+    struct Header {
+        uint8_t                 identifier[4];
+        uint32_t                version;
+        uint32_t                strings;
+        uint32_t                chars;
+        uint32_t                schemas;
+        uint32_t                properties;
+        uint32_t                objects;
+        uint32_t                links;
+        uint32_t                blocks;
+        uint32_t                blobs;
+    };
+
+    struct Schema {
+        uint32_t                type;
+        uint32_t                first;
+        uint32_t                count;
+        uint32_t                stride;
+    };
+
+    struct Property {
+        uint32_t                name;
+        uint32_t                type;
+        uint32_t                offset;
+    };
+
+    struct Entry {
+        uint32_t                schema;
+        uint32_t                uuid;
+        uint32_t                parent;
+        uint32_t                name;
+        uint32_t                block;
+        uint32_t                first;
+        uint32_t                count;
+        uint32_t                data;
+        uint32_t                size;
+    };
+
+    struct Link {
+        uint32_t                sender;
+        uint32_t                signal;
+        uint32_t                receiver;
+        uint32_t                method;
+    };
+
+    bool                        open                        ();
+
+    const char                 *text                        (uint32_t index) const;
+
+    Variant                     value                       (const Entry &entry, const Property &property) const;
+
+    Variant                     blob                        (uint32_t offset, uint32_t size, MetaType::Type type) const;
+
+    VariantMap                  userData                    (const Entry &entry) const;
+
+    VariantList                 object                      (uint32_t index) const;
+
+    ByteBuffer                  m_Buffer;
+
+    Header                      m_Header;
+
+    const uint32_t             *m_pStrings;
+
+    const char                 *m_pChars;
+
+    const Schema               *m_pSchemas;
+
+    const Property             *m_pProperties;
+
+    const Entry                *m_pObjects;
+
+    const Link                 *m_pLinks;
+
+    const int8_t               *m_pBlocks;
+
+    const int8_t               *m_pBlobs;
+
+    bool                        m_Valid;
+
+};
+
+#endif // OBJECTPACK_H
@@ -0,0 +1,31 @@
+#ifndef OBJECTPOOL_H
+#define OBJECTPOOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "global.h"
+
+class Object;
+class MetaObject;
+
+class NEXT_LIBRARY_EXPORT ObjectPool {
+public:
+    static Object              *create                      (const MetaObject *meta);
+
+    static size_t               slotSize                    (const MetaObject *meta);
+
+private:
+    friend class Object;
+
+    static void                *allocate                    (size_t size);
+
+    static void                 free                        (void *pointer);
+
+    static void                *allocatePrivate             (const Object *owner, size_t size);
+
+    static void                 freePrivate                 (void *pointer);
+
+};
+
+#endif // OBJECTPOOL_H
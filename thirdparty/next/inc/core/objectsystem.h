@@ -6,10 +6,15 @@
 #include <string>
 #include <memory>
 #include <thread>
+#include <atomic>
+#include <mutex>
+#include <vector>
 
 #include "object.h"
 
 class MetaObject;
+class BsonReader;
+class ObjectPack;
 
 class NEXT_LIBRARY_EXPORT ObjectSystem : public Object {
 public:
@@ -51,6 +56,8 @@ public:
 
     static Variant                      toVariant               (const Object *object, bool force = false);
     static Object                      *toObject                (const Variant &variant, Object *root = nullptr);
+    static Object                      *toObject                (const BsonReader &document, Object *root = nullptr);
+    static Object                      *toObject                (const ObjectPack &pack, Object *root = nullptr);
 
     static uint32_t                     generateUUID            ();
 
@@ -58,7 +65,7 @@ public:
 
     static Object                      *findRoot                (Object *object);
 
-    static Object                      *findObject              (uint32_t uuid, Object *root);
+    static Object                      *findObject              (uint32_t uuid, Object *root = nullptr);
 
 protected:
     void                                factoryAdd              (const string &name, const string &uri, const MetaObject *meta);
@@ -75,17 +82,29 @@ private:
     friend class ObjectSystemTest;
     friend class Object;
 
-    void                                addObject               (Object *object);
+    Object::ObjectList::iterator        addObject               (Object *object);
 
-    void                                suspendObject           (Object *object);
+    void                                addPending              (Object *object);
+
+    void                                removePending           (Object *object);
+
+    typedef unordered_map<uint32_t, Object *>          ObjectMap;
+
+    static Object                      *findParent              (const ObjectMap &array, uint32_t uuid, Object *root);
+
+    static Object                      *createInvalid           (const VariantList &data, const string &name, uint32_t uuid, Object *parent);
 
 protected:
     Object::ObjectList                  m_ObjectList;
 
-    Object                             *m_SuspendObject;
+    thread::id                          m_threadId;
+
+private:
+    atomic<Object *>                    m_pPendingList;
 
+    vector<Object *>                    m_PendingBatch;
 
-    thread::id                          m_threadId;
+    mutex                               m_PendingMutex;
 
 };
 
@@ -2,12 +2,41 @@
 #define THREADPOOL_H
 
 #include <stdint.h>
+#include <functional>
 
 #include "object.h"
 
 class ThreadPoolPrivate;
+class JobPrivate;
+
+class NEXT_LIBRARY_EXPORT Job {
+public:
+    Job                         ();
+
+    Job                         (const Job &job);
+
+    ~Job                        ();
+
+    Job                        &operator=                   (const Job &job);
+
+    bool                        isValid                     () const;
+
+    bool                        isFinished                  () const;
+
+private:
+    friend class ThreadPool;
+
+    explicit Job                (JobPrivate *job);
+
+    JobPrivate                 *p_ptr;
+
+};
 
 class NEXT_LIBRARY_EXPORT ThreadPool : public Object {
+public:
+    typedef function<void ()>                       JobFunction;
+    typedef function<void (uint32_t, uint32_t)>     RangeFunction;
+
 public:
     ThreadPool                  ();
 
@@ -15,6 +44,18 @@ public:
 
     void                        start                       (Object &object);
 
+    Job                         createJob                   (const JobFunction &function, const Job &parent = Job());
+
+    void                        addDependency               (const Job &job, const Job &dependency);
+
+    Job                         continueWith                (const Job &job, const JobFunction &function);
+
+    void                        run                         (const Job &job);
+
+    void                        wait                        (const Job &job);
+
+    Job                         parallelFor                 (uint32_t count, uint32_t grain, const RangeFunction &function);
+
     uint32_t                    maxThreads                  () const;
 
     void                        setMaxThreads               (uint32_t value);
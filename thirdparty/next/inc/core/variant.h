@@ -30,14 +30,14 @@
 
 #include "amath.h"
 #include "metatype.h"
+#include "bytebuffer.h"
 
 using namespace std;
 
 class Variant;
 
 typedef map<string, Variant>    VariantMap;
-typedef list<Variant>           VariantList;
-typedef vector<int8_t>          ByteArray;
+typedef vector<Variant>         VariantList;
 
 class NEXT_LIBRARY_EXPORT Variant {
 public:
@@ -60,6 +60,7 @@ public:
             bool                b;
             void               *ptr;
             SharedPrivate      *shared;
+            uint8_t             so[sizeof(Matrix4)];
         };
     };
 
@@ -75,6 +76,12 @@ public:
     Variant                     (const VariantMap &value);
     Variant                     (const VariantList &value);
     Variant                     (const ByteArray &value);
+    Variant                     (const ByteBuffer &value);
+
+    Variant                     (string &&value);
+    Variant                     (VariantMap &&value);
+    Variant                     (VariantList &&value);
+    Variant                     (ByteArray &&value);
 
     Variant                     (const Vector2 &value);
     Variant                     (const Vector3 &value);
@@ -83,13 +90,15 @@ public:
     Variant                     (const Matrix3 &value);
     Variant                     (const Matrix4 &value);
 
-    Variant                     (uint32_t type, void *copy);
+    Variant                     (uint32_t type, const void *copy);
 
     ~Variant                    ();
 
     Variant                     (const Variant &value);
+    Variant                     (Variant &&value) noexcept;
 
     Variant                    &operator=                   (const Variant &value);
+    Variant                    &operator=                   (Variant &&value) noexcept;
 
     bool                        operator==                  (const Variant &right) const;
     bool                        operator!=                  (const Variant &right) const;
@@ -115,32 +124,15 @@ public:
     T                           value                       () const {
         uint32_t type = MetaType::type<T>();
 
-        if(mData.type < MetaType::STRING) {
+        const void *ptr = pointer();
+        if(ptr) {
             if(mData.type == type) {
-                return *reinterpret_cast<const T *>(&mData.ptr);
+                return *reinterpret_cast<const T *>(ptr);
             } else if(canConvert(type)) {
                 T result;
-                MetaType::convert(&mData.ptr, mData.type, &result, type);
+                MetaType::convert(ptr, mData.type, &result, type);
                 return result;
             }
-        } else {
-            if(mData.ptr) {
-                if(mData.type == type) {
-                    if(mData.is_shared) {
-                        return *reinterpret_cast<const T *>(mData.shared->ptr);
-                    } else {
-                        return *reinterpret_cast<const T *>(mData.ptr);
-                    }
-                } else if(canConvert(type)) {
-                    T result;
-                    if(mData.is_shared) {
-                        MetaType::convert(mData.shared->ptr, mData.type, &result, type);
-                    } else {
-                        MetaType::convert(mData.ptr, mData.type, &result, type);
-                    }
-                    return result;
-                }
-            }
         }
         return T();
     }
@@ -149,18 +141,15 @@ public:
     static Variant             fromValue                   (const T &value) {
         uint32_t type = MetaType::type<T>();
         if(type != MetaType::INVALID) {
-            if(type < MetaType::STRING) {
-                return Variant(value);
-            }
-
-            Variant result;
-            result.mData.type = type;
-            result.mData.ptr = MetaType::create(result.mData.type, reinterpret_cast<const void *>(&value));
-            return result;
+            return Variant(type, &value);
         }
         return Variant();
     }
 
+    static inline bool          isInline                    (uint32_t type) {
+        return (type >= MetaType::VECTOR2 && type <= MetaType::RAY);
+    }
+
     // Conversion and getters
     bool                        toBool                      () const;
     int                         toInt                       () const;
@@ -170,6 +159,7 @@ public:
     const VariantMap            toMap                       () const;
     const VariantList           toList                      () const;
     const ByteArray             toByteArray                 () const;
+    const ByteBuffer            toByteBuffer                () const;
 
     const Vector2               toVector2                   () const;
     const Vector3               toVector3                   () const;
@@ -178,6 +168,14 @@ public:
     const Matrix3               toMatrix3                   () const;
     const Matrix4               toMatrix4                   () const;
 
+protected:
+    inline void                *pointer                     () const {
+        if(mData.type < MetaType::STRING || isInline(mData.type)) {
+            return mData.so;
+        }
+        return (mData.is_shared) ? mData.shared->ptr : mData.ptr;
+    }
+
 protected:
     mutable Data                mData;
 
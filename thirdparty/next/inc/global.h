@@ -19,25 +19,31 @@
         #define PROFILE_FUNCTION(...) EASY_FUNCTION(__VA_ARGS__)
         #define PROFILE_START EASY_PROFILER_ENABLE
         #define PROFILE_STOP profiler::dumpBlocksToFile("profile.prof")
-        #define PROFILER_STAT(x, y)
-        #define PROFILER_RESET(label)
+        #define PROFILE_FRAME_BEGIN
+        #define PROFILE_FRAME_END
     #else
         #include <analytics/profiler.h>
 
-        #define PROFILE_BLOCK(name, ...)
-        #define PROFILE_FUNCTION(...) Profiler MARK(__FUNCTION__);
-        #define PROFILE_START
-        #define PROFILE_STOP
-        #define PROFILER_STAT(x, y)
-        #define PROFILER_RESET(label)
+        #define PROFILE_CONCAT_IMPL(a, b) a##b
+        #define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+        #define PROFILE_ZONE(name) \
+            static const Profiler::SourceLocation PROFILE_CONCAT(_location, __LINE__) = {name, __FILE__, __LINE__}; \
+            Profiler PROFILE_CONCAT(_zone, __LINE__)(&PROFILE_CONCAT(_location, __LINE__));
+
+        #define PROFILE_BLOCK(name, ...) PROFILE_ZONE(name)
+        #define PROFILE_FUNCTION(...) PROFILE_ZONE(__FUNCTION__)
+        #define PROFILE_START Profiler::setEnabled(true)
+        #define PROFILE_STOP Profiler::setEnabled(false)
+        #define PROFILE_FRAME_BEGIN Profiler::frameBegin()
+        #define PROFILE_FRAME_END Profiler::frameEnd()
     #endif
 #else
     #define PROFILE_BLOCK(name, ...)
     #define PROFILE_FUNCTION(...)
     #define PROFILE_START
     #define PROFILE_STOP
-    #define PROFILER_STAT(label, y)
-    #define PROFILER_RESET(label)
+    #define PROFILE_FRAME_BEGIN
+    #define PROFILE_FRAME_END
 #endif
 
 #define A_UNUSED(a) (void)a
@@ -0,0 +1,208 @@
+#include "analytics/performancecounter.h"
+
+#include <mutex>
+#include <algorithm>
+#include <cstring>
+
+class CounterRegistry {
+public:
+    static CounterRegistry *instance() {
+        // Intentionally never destroyed, counters can be static objects of other modules
+        static CounterRegistry *registry = new CounterRegistry;
+        return registry;
+    }
+
+    static uint32_t shard() {
+        static atomic<uint32_t> next(0);
+        static thread_local uint32_t index = next.fetch_add(1, memory_order_relaxed) % COUNTER_SHARDS;
+        return index;
+    }
+
+    mutex                               m_Mutex;
+
+    PerformanceCounter::CounterList     m_Counters;
+};
+
+/*!
+    \class PerformanceCounter
+    \brief The PerformanceCounter class accumulates the performance statistics per frame.
+    \since Next 1.0
+    \inmodule Analytics
+
+    Each counter is identified by a name and registered in the global registry on construction.
+    Counters can be updated from any thread, values are accumulated in separate per-thread slots, so concurrent updates don't contend on the same cache line.
+    At the end of each frame the current values are moved to the rolling history which keeps the last COUNTER_HISTORY frames.
+
+    The editor and the game use the same query interface: find() to get a counter by name and last() or history() to read the values.
+
+    \code
+        static PerformanceCounter drawCalls("Draw Calls");
+
+        void draw() {
+            ...
+            drawCalls.add();
+        }
+
+        int64_t value = PerformanceCounter::find("Draw Calls")->last();
+    \endcode
+*/
+/*!
+    \enum PerformanceCounter::Type
+
+    \value Counter \c The values added during the frame are summed up. The counter is reset at the end of each frame.
+    \value Gauge \c The last set value is kept until it will be changed.
+*/
+/*!
+    Constructs a counter with \a name and \a type and registers it.
+    \note The \a name must be a static string.
+*/
+PerformanceCounter::PerformanceCounter(const char *name, Type type) :
+        m_pName(name),
+        m_Type(type),
+        m_Frames(0) {
+
+    for(auto &it : m_Shards) {
+        it.value.store(0, memory_order_relaxed);
+    }
+    memset(m_History, 0, sizeof(m_History));
+
+    CounterRegistry *registry = CounterRegistry::instance();
+    unique_lock<mutex> locker(registry->m_Mutex);
+    registry->m_Counters.push_back(this);
+}
+
+PerformanceCounter::~PerformanceCounter() {
+    CounterRegistry *registry = CounterRegistry::instance();
+    unique_lock<mutex> locker(registry->m_Mutex);
+    auto it = std::find(registry->m_Counters.begin(), registry->m_Counters.end(), this);
+    if(it != registry->m_Counters.end()) {
+        registry->m_Counters.erase(it);
+    }
+}
+/*!
+    Returns the name of counter.
+*/
+const char *PerformanceCounter::name() const {
+    return m_pName;
+}
+/*!
+    Returns the type of counter.
+*/
+PerformanceCounter::Type PerformanceCounter::type() const {
+    return m_Type;
+}
+/*!
+    Adds the \a value to the current frame value of counter.
+    This method is thread safe.
+*/
+void PerformanceCounter::add(int64_t value) {
+    m_Shards[CounterRegistry::shard()].value.fetch_add(value, memory_order_relaxed);
+}
+/*!
+    Sets the current \a value of gauge.
+    For the counters of PerformanceCounter::Counter type the value replaces everything accumulated in the current frame.
+    This method is thread safe.
+*/
+void PerformanceCounter::set(int64_t value) {
+    for(uint32_t i = 1; i < COUNTER_SHARDS; i++) {
+        m_Shards[i].value.store(0, memory_order_relaxed);
+    }
+    m_Shards[0].value.store(value, memory_order_relaxed);
+}
+/*!
+    Returns the value accumulated in the current frame.
+    \note The current frame is not finished, so the value may be incomplete. Please use last() to get the value of the previous frame.
+*/
+int64_t PerformanceCounter::value() const {
+    int64_t result = 0;
+    for(auto &it : m_Shards) {
+        result += it.value.load(memory_order_relaxed);
+    }
+    return result;
+}
+/*!
+    Returns the value of the last finished frame.
+*/
+int64_t PerformanceCounter::last() const {
+    unique_lock<mutex> locker(CounterRegistry::instance()->m_Mutex);
+    if(m_Frames == 0) {
+        return 0;
+    }
+    return m_History[(m_Frames - 1) % COUNTER_HISTORY];
+}
+/*!
+    Returns the values of the last \a frames finished frames from the oldest to the newest.
+    The history is limited by COUNTER_HISTORY frames.
+*/
+vector<int64_t> PerformanceCounter::history(uint32_t frames) const {
+    unique_lock<mutex> locker(CounterRegistry::instance()->m_Mutex);
+    uint32_t count = min(frames, min(m_Frames, static_cast<uint32_t>(COUNTER_HISTORY)));
+    vector<int64_t> result;
+    result.reserve(count);
+    for(uint32_t i = m_Frames - count; i < m_Frames; i++) {
+        result.push_back(m_History[i % COUNTER_HISTORY]);
+    }
+    return result;
+}
+/*!
+    Returns the average value of the last \a frames finished frames.
+*/
+double PerformanceCounter::average(uint32_t frames) const {
+    vector<int64_t> values = history(frames);
+    if(values.empty()) {
+        return 0.0;
+    }
+    double result = 0.0;
+    for(auto it : values) {
+        result += static_cast<double>(it);
+    }
+    return result / values.size();
+}
+/*!
+    Returns the registered counter with \a name; otherwise returns nullptr.
+*/
+PerformanceCounter *PerformanceCounter::find(const char *name) {
+    CounterRegistry *registry = CounterRegistry::instance();
+    unique_lock<mutex> locker(registry->m_Mutex);
+    for(auto it : registry->m_Counters) {
+        if(strcmp(it->m_pName, name) == 0) {
+            return it;
+        }
+    }
+    return nullptr;
+}
+/*!
+    Returns the list of all registered counters.
+*/
+PerformanceCounter::CounterList PerformanceCounter::counters() {
+    CounterRegistry *registry = CounterRegistry::instance();
+    unique_lock<mutex> locker(registry->m_Mutex);
+    return registry->m_Counters;
+}
+/*!
+    Finishes the frame for all registered counters and moves their values to the history.
+    \note Usually, this method calls internally by the Engine and must not be called manually.
+*/
+void PerformanceCounter::frameEnd() {
+    CounterRegistry *registry = CounterRegistry::instance();
+    unique_lock<mutex> locker(registry->m_Mutex);
+    for(auto it : registry->m_Counters) {
+        it->commit();
+    }
+}
+/*!
+    \internal
+    Moves the current value to the history.
+*/
+void PerformanceCounter::commit() {
+    int64_t result = 0;
+    if(m_Type == Counter) {
+        for(auto &it : m_Shards) {
+            result += it.value.exchange(0, memory_order_relaxed);
+        }
+    } else {
+        result = value();
+    }
+    m_History[m_Frames % COUNTER_HISTORY] = result;
+    m_Frames++;
+}
@@ -2,33 +2,363 @@
 
 #ifdef PROFILING_ENABLED
 
-typedef list<Profiler::CallPoint>             CallsList;
-typedef unordered_map<thread::id, CallsList>  ThreadMap;
-typedef unordered_map<const char *, uint32_t> StatsMap;
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <sstream>
+#include <fstream>
 
-static ThreadMap m_Threads;
-static StatsMap  m_Stats;
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+    #define PROFILER_TSC
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #include <x86intrin.h>
+    #define PROFILER_TSC
+#endif
 
-Profiler::Profiler(const char *name) {
-    m_Current.name = name;
-    m_Current.started = std::chrono::high_resolution_clock::now();
-}
+#define PROFILER_CAPACITY   (1 << 16)
+#define PROFILER_MASK       (PROFILER_CAPACITY - 1)
 
-Profiler::~Profiler() {
-    m_Current.stoped = std::chrono::high_resolution_clock::now();
-    m_Threads[this_thread::get_id()].push_back(m_Current);
+inline static uint64_t ticks() {
+#ifdef PROFILER_TSC
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count());
+#endif
 }
 
-uint32_t Profiler::stat(const char *name) {
-    return m_Stats[name];
+class ThreadBuffer {
+public:
+    // Each slot is guarded by own sequence number, the reader drops the slots which are being rewritten
+    struct Slot {
+        atomic<uint64_t>                    sequence;
+
+        atomic<const Profiler::SourceLocation *> location;
+
+        atomic<uint64_t>                    started;
+
+        atomic<uint64_t>                    stoped;
+    };
+
+    ThreadBuffer(uint32_t id) :
+            m_Head(0),
+            m_Id(id) {
+
+        for(auto &it : m_Slots) {
+            it.sequence.store(~0ULL, memory_order_relaxed);
+        }
+    }
+
+    void push(const Profiler::SourceLocation *location, uint64_t started, uint64_t stoped) {
+        // Only the owner thread writes to the buffer, so the head can be advanced without RMW operations
+        uint64_t head = m_Head.load(memory_order_relaxed);
+        Slot &slot = m_Slots[head & PROFILER_MASK];
+        slot.sequence.store(~0ULL, memory_order_relaxed);
+        atomic_thread_fence(memory_order_release);
+        slot.location.store(location, memory_order_relaxed);
+        slot.started.store(started, memory_order_relaxed);
+        slot.stoped.store(stoped, memory_order_relaxed);
+        slot.sequence.store(head, memory_order_release);
+        m_Head.store(head + 1, memory_order_release);
+    }
+
+    void read(vector<Profiler::Zone> &result) const {
+        uint64_t head = m_Head.load(memory_order_acquire);
+        // The slot at the head can be already rewritten by the owner thread
+        uint64_t first = (head >= PROFILER_CAPACITY) ? head - PROFILER_CAPACITY + 1 : 0;
+        result.reserve(result.size() + static_cast<size_t>(head - first));
+        for(uint64_t i = first; i < head; i++) {
+            const Slot &slot = m_Slots[i & PROFILER_MASK];
+            if(slot.sequence.load(memory_order_acquire) != i) {
+                continue;
+            }
+            Profiler::Zone zone;
+            zone.location = slot.location.load(memory_order_relaxed);
+            zone.started = slot.started.load(memory_order_relaxed);
+            zone.stoped = slot.stoped.load(memory_order_relaxed);
+            atomic_thread_fence(memory_order_acquire);
+            // Drop the zone which was overwritten by the owner thread during the reading
+            if(slot.sequence.load(memory_order_relaxed) == i) {
+                result.push_back(zone);
+            }
+        }
+    }
+
+    atomic<uint64_t>        m_Head;
+
+    uint32_t                m_Id;
+
+    Slot                    m_Slots[PROFILER_CAPACITY];
+};
+
+class BufferOwner {
+public:
+    BufferOwner() :
+            m_pBuffer(nullptr) {
+
+    }
+
+    ~BufferOwner();
+
+    ThreadBuffer           *m_pBuffer;
+};
+
+class ProfilerPrivate {
+public:
+    ProfilerPrivate() :
+            m_Start(chrono::steady_clock::now()),
+            m_StartTicks(ticks()),
+            m_Frame(0),
+            m_FrameStarted(0),
+            m_Threads(0) {
+
+    }
+
+    static ProfilerPrivate *instance() {
+        // Intentionally never destroyed, zones can be recorded during static destruction
+        static ProfilerPrivate *profiler = new ProfilerPrivate;
+        return profiler;
+    }
+
+    static ThreadBuffer *buffer() {
+        if(s_pBuffer == nullptr && !s_Exited) {
+            ProfilerPrivate *profiler = instance();
+            unique_lock<mutex> locker(profiler->m_Mutex);
+            s_pBuffer = new ThreadBuffer(profiler->m_Threads++);
+            profiler->m_Buffers.push_back(s_pBuffer);
+            // Touch the owner to register its destructor for the current thread
+            s_Owner.m_pBuffer = s_pBuffer;
+        }
+        return s_pBuffer;
+    }
+
+    double nanosecondsPerTick() const {
+#ifdef PROFILER_TSC
+        uint64_t elapsed = ticks() - m_StartTicks;
+        double time = chrono::duration<double, nano>(chrono::steady_clock::now() - m_Start).count();
+        return (elapsed > 0) ? time / static_cast<double>(elapsed) : 1.0;
+#else
+        return 1.0;
+#endif
+    }
+
+    static void escape(ostream &stream, const char *string) {
+        for(const char *c = string; c && *c; c++) {
+            switch(*c) {
+                case '"': stream << "\\\""; break;
+                case '\\': stream << "\\\\"; break;
+                default: stream << *c; break;
+            }
+        }
+    }
+
+    chrono::steady_clock::time_point m_Start;
+
+    uint64_t                m_StartTicks;
+
+    atomic<uint64_t>        m_Frame;
+
+    uint64_t                m_FrameStarted;
+
+    uint32_t                m_Threads;
+
+    mutex                   m_Mutex;
+
+    vector<ThreadBuffer *>  m_Buffers;
+
+    static atomic<bool>     s_Enabled;
+
+    // Trivially destructible on purpose, zones can be recorded by other thread_local destructors
+    static thread_local ThreadBuffer *s_pBuffer;
+
+    static thread_local bool s_Exited;
+
+    static thread_local BufferOwner s_Owner;
+};
+
+atomic<bool> ProfilerPrivate::s_Enabled(true);
+
+thread_local ThreadBuffer *ProfilerPrivate::s_pBuffer = nullptr;
+
+thread_local bool ProfilerPrivate::s_Exited = false;
+
+thread_local BufferOwner ProfilerPrivate::s_Owner;
+
+/*!
+    Releases the buffer of the exiting thread, the zones of this thread will not be exported anymore.
+*/
+BufferOwner::~BufferOwner() {
+    if(m_pBuffer) {
+        ProfilerPrivate *profiler = ProfilerPrivate::instance();
+        {
+            unique_lock<mutex> locker(profiler->m_Mutex);
+            auto it = find(profiler->m_Buffers.begin(), profiler->m_Buffers.end(), m_pBuffer);
+            if(it != profiler->m_Buffers.end()) {
+                profiler->m_Buffers.erase(it);
+            }
+        }
+        delete m_pBuffer;
+    }
+    ProfilerPrivate::s_pBuffer = nullptr;
+    ProfilerPrivate::s_Exited = true;
 }
 
-void Profiler::statAdd(const char *name, uint32_t value) {
-    m_Stats[name] += value;
+static const Profiler::SourceLocation gFrame = {"Frame", __FILE__, __LINE__};
+
+/*!
+    \class Profiler
+    \brief The Profiler class collects the timings of the code zones.
+    \since Next 1.0
+    \inmodule Analytics
+
+    Profiler is a scoped object which measures the time between its construction and destruction.
+    Usually it's created by PROFILE_FUNCTION() or PROFILE_BLOCK() macros which are compiled out in case of PROFILING_ENABLED is not defined.
+
+    Each thread records the zones to own ring buffer, so recording doesn't take any locks and doesn't allocate memory.
+    The ring buffer keeps only the latest zones, the older ones are overwritten.
+    The buffer is released when its thread exits, so the zones of finished threads are not exported.
+    Frame markers are recorded by frameBegin() and frameEnd() methods.
+
+    The collected data can be exported at any time to the Chrome trace format, which can be opened by chrome://tracing or Perfetto UI.
+
+    \code
+        void MyClass::update() {
+            PROFILE_FUNCTION();
+
+            {
+                PROFILE_BLOCK("Heavy part");
+                ...
+            }
+        }
+
+        Profiler::exportTrace("trace.json");
+    \endcode
+*/
+/*!
+    \struct Profiler::SourceLocation
+    \brief Static information about the profiled zone: the \c name, source \c file and \c line.
+*/
+/*!
+    Starts the zone described with static \a location.
+*/
+Profiler::Profiler(const SourceLocation *location) :
+        m_pLocation(nullptr),
+        m_Started(0) {
+    if(ProfilerPrivate::s_Enabled.load(memory_order_relaxed)) {
+        m_pLocation = location;
+        m_Started = ticks();
+    }
+}
+/*!
+    Finishes the zone and records it to the buffer of the current thread.
+*/
+Profiler::~Profiler() {
+    if(m_pLocation) {
+        ThreadBuffer *buffer = ProfilerPrivate::buffer();
+        if(buffer) {
+            buffer->push(m_pLocation, m_Started, ticks());
+        }
+    }
+}
+/*!
+    Returns true if the recording of zones is enabled; otherwise returns false.
+*/
+bool Profiler::isEnabled() {
+    return ProfilerPrivate::s_Enabled.load(memory_order_relaxed);
+}
+/*!
+    Enables or disables the recording of zones with the \a enable flag.
+    The recording is enabled by default.
+*/
+void Profiler::setEnabled(bool enable) {
+    ProfilerPrivate::s_Enabled.store(enable, memory_order_relaxed);
 }
+/*!
+    Marks the beginning of a new frame.
+    \note Must be called from the thread which executes the frames.
+*/
+void Profiler::frameBegin() {
+    ProfilerPrivate::instance()->m_FrameStarted = ticks();
+}
+/*!
+    Marks the end of the current frame and records it as a zone.
+    \note Must be called from the thread which executes the frames.
+*/
+void Profiler::frameEnd() {
+    ProfilerPrivate *profiler = ProfilerPrivate::instance();
+    if(ProfilerPrivate::s_Enabled.load(memory_order_relaxed)) {
+        ThreadBuffer *buffer = ProfilerPrivate::buffer();
+        if(buffer) {
+            buffer->push(&gFrame, profiler->m_FrameStarted, ticks());
+        }
+    }
+    profiler->m_Frame.fetch_add(1, memory_order_relaxed);
+}
+/*!
+    Returns the number of finished frames.
+*/
+uint64_t Profiler::frameIndex() {
+    return ProfilerPrivate::instance()->m_Frame.load(memory_order_relaxed);
+}
+/*!
+    Exports the recorded zones of all threads to the file located along the \a path in Chrome trace format.
+    This method can be called from any thread at any time.
+    Returns true if succeed; otherwise returns false.
 
-void Profiler::statReset(const char *name) {
-    m_Stats[name] = 0;
+    \sa traceJson()
+*/
+bool Profiler::exportTrace(const string &path) {
+    ofstream file(path.c_str(), ios::out | ios::trunc);
+    if(file.is_open()) {
+        file << traceJson();
+        return file.good();
+    }
+    return false;
 }
+/*!
+    Returns the recorded zones of all threads as a JSON string in Chrome trace format.
+*/
+string Profiler::traceJson() {
+    ProfilerPrivate *profiler = ProfilerPrivate::instance();
+
+    // Keeps the buffers alive while reading, exiting threads wait for the export to finish
+    unique_lock<mutex> locker(profiler->m_Mutex);
 
+    // Microseconds per tick
+    double scale = profiler->nanosecondsPerTick() / 1000.0;
+
+    stringstream stream;
+    stream.setf(ios::fixed);
+    stream.precision(3);
+    stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    vector<Zone> zones;
+    for(auto buffer : profiler->m_Buffers) {
+        if(!first) {
+            stream << ",";
+        }
+        first = false;
+        stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << buffer->m_Id;
+        stream << ",\"args\":{\"name\":\"Thread " << buffer->m_Id << "\"}}";
+
+        zones.clear();
+        buffer->read(zones);
+        for(auto &it : zones) {
+            stream << ",{\"name\":\"";
+            ProfilerPrivate::escape(stream, it.location->name);
+            stream << "\",\"cat\":\"" << ((it.location == &gFrame) ? "frame" : "zone") << "\",\"ph\":\"X\"";
+            double started = static_cast<double>(static_cast<int64_t>(it.started - profiler->m_StartTicks)) * scale;
+            stream << ",\"ts\":" << started;
+            stream << ",\"dur\":" << static_cast<double>(it.stoped - it.started) * scale;
+            stream << ",\"pid\":0,\"tid\":" << buffer->m_Id;
+            stream << ",\"args\":{\"file\":\"";
+            ProfilerPrivate::escape(stream, it.location->file);
+            stream << "\",\"line\":" << it.location->line << "}}";
+        }
+    }
+    stream << "]}";
+    return stream.str();
+}
 #endif
@@ -52,11 +52,10 @@ void PropertyAnimation::setTarget(Object *object, const char *property) {
     setCurrentValue(p_ptr->m_Default);
 
     if(object) {
-        const MetaObject *meta = object->metaObject();
-        int32_t index = meta->indexOfProperty(property);
-        if(index > -1) {
+        MetaProperty meta = object->metaObject()->findProperty(property);
+        if(meta.isValid()) {
             p_ptr->m_pObject = object;
-            p_ptr->m_Property = meta->property(index);
+            p_ptr->m_Property = meta;
             p_ptr->m_Default = p_ptr->m_Property.read(p_ptr->m_pObject);
             setCurrentValue(p_ptr->m_Default);
         }
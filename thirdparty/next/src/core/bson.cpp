@@ -4,26 +4,6 @@
 
 #include <cstring>
 
-void appendProperty(Variant &container, const Variant &data, const string &name) {
-    switch(container.type()) {
-        case MetaType::VARIANTLIST: {
-            if(container.data() == nullptr) {
-                container = VariantList();
-            }
-            VariantList &list = *(reinterpret_cast<VariantList *>(container.data()));
-            list.push_back(data);
-        } break;
-        case MetaType::VARIANTMAP: {
-            if(container.data() == nullptr) {
-                container = VariantMap();
-            }
-            VariantMap &map = *(reinterpret_cast<VariantMap *>(container.data()));
-            map[name] = data;
-        } break;
-        default: break;
-    }
-}
-
 enum DataTypes {
     FLOAT      = 1,
     STRING,
@@ -40,153 +20,406 @@ enum DataTypes {
     QUATERNION
 };
 
-Variant parse(const ByteArray &data, uint32_t &offset, MetaType::Type type, bool first) {
-    PROFILE_FUNCTION();
-    Variant result(type);
-    if(data.empty()) {
-        return result;
+static uint32_t metaType(uint8_t tag) {
+    switch(tag) {
+        case BOOL:      return MetaType::BOOLEAN;
+        case INT32:     return MetaType::INTEGER;
+        case FLOAT:     return MetaType::FLOAT;
+        case STRING:    return MetaType::STRING;
+        case OBJECT:    return MetaType::VARIANTMAP;
+        case ARRAY:     return MetaType::VARIANTLIST;
+        case BINARY:    return MetaType::BYTEBUFFER;
+        case VECTOR2:   return MetaType::VECTOR2;
+        case VECTOR3:   return MetaType::VECTOR3;
+        case VECTOR4:   return MetaType::VECTOR4;
+        case MATRIX3:   return MetaType::MATRIX3;
+        case MATRIX4:   return MetaType::MATRIX4;
+        case QUATERNION:return MetaType::QUATERNION;
+        default: break;
     }
+    return MetaType::INVALID;
+}
 
-    uint32_t global = offset;
-
-    uint32_t size;
-    memcpy(&size, &data[offset], sizeof(uint32_t));
-    if(offset + size > data.size()) {
-        return Variant();
+static Variant *insert(void *container, uint32_t kind, const char *name, Variant &&value) {
+    if(kind == MetaType::VARIANTLIST) {
+        VariantList &list = *(reinterpret_cast<VariantList *>(container));
+        list.push_back(std::move(value));
+        return &list.back();
     }
-    offset  += sizeof(uint32_t);
+    // Keys are stored in sorted order, so each one is appended at the end of map
+    VariantMap &map = *(reinterpret_cast<VariantMap *>(container));
+    auto it = map.emplace_hint(map.end(), name, Variant());
+    it->second = std::move(value);
+    return &it->second;
+}
+/*!
+    \class BsonReader
+    \brief Cursor based reader of Binary JSON documents.
+    \since Next 1.0
+    \inmodule Core
 
-    while(offset < global + size) {
-        uint8_t t = data[offset];
-        offset++;
+    BsonReader iterates elements of a BSON document directly in the source buffer.
+    Moving the cursor doesn't allocate memory and doesn't use recursion, nested documents are tracked with a fixed size stack.
+    Names and values are read on demand, binary fields are returned as slices of the source ByteBuffer.
 
-        string name;
-        for(; offset < global + size; offset++) {
-            if(data[offset] == 0) {
-                offset++;
-                break;
+    Example:
+    \code
+        BsonReader reader(buffer, MetaType::VARIANTMAP);
+        while(reader.next()) {
+            if(strcmp(reader.name(), "mesh") == 0 && reader.enter()) {
+                ... // Iterate fields of nested document
+                reader.leave();
             }
-            name.push_back(data[offset]);
         }
+    \endcode
 
-        if(global == 225) {
-            global = 225;
-        }
+    \sa Bson
+*/
+/*!
+    Constructs a reader for the BSON document stored in \a data with expected \a type of root container (can be MetaType::VARIANTLIST or MetaType::VARIANTMAP).
+    Binary fields share the memory of \a data.
+*/
+BsonReader::BsonReader(const ByteBuffer &data, MetaType::Type type) :
+        m_Buffer(data),
+        m_pData(data.data()),
+        m_Size(data.size()),
+        m_Type(MetaType::INVALID),
+        m_Name(0),
+        m_Value(0),
+        m_Next(0),
+        m_Depth(0),
+        m_Valid(false) {
+
+    m_Valid = open(0, type);
+}
+/*!
+    Constructs a reader for the BSON document of \a size bytes located at \a data with expected \a type of root container (can be MetaType::VARIANTLIST or MetaType::VARIANTMAP).
+    The \a data must stay alive while reader in use, binary fields will be copied.
+*/
+BsonReader::BsonReader(const int8_t *data, uint32_t size, MetaType::Type type) :
+        m_pData(data),
+        m_Size(size),
+        m_Type(MetaType::INVALID),
+        m_Name(0),
+        m_Value(0),
+        m_Next(0),
+        m_Depth(0),
+        m_Valid(false) {
+
+    m_Valid = open(0, type);
+}
+/*!
+    Returns true if the document is well formed so far; otherwise returns false.
+*/
+bool BsonReader::isValid() const {
+    return m_Valid;
+}
+/*!
+    Moves the cursor to the next element of the current document.
+    Returns false if there are no more elements or the document is broken.
+*/
+bool BsonReader::next() {
+    m_Type = MetaType::INVALID;
+    if(!m_Valid || m_Depth == 0) {
+        return false;
+    }
 
-        switch(t) {
-            case BOOL: {
-                uint8_t value = data[offset];
-                offset++;
-
-                appendProperty(result, (value) ? true : false, name);
-            } break;
-            case STRING: {
-                uint32_t length;
-                memcpy(&length, &data[offset], sizeof(uint32_t));
-                offset += sizeof(uint32_t);
-
-                char *value = new char[length];
-                memcpy(value, &data[offset], length);
-                offset += length;
-
-                appendProperty(result, value, name);
-                delete []value;
-            } break;
-            case OBJECT: {
-                int32_t length;
-                memcpy(&length, &data[offset], sizeof(uint32_t));
-
-                Variant container  = parse(data, offset, MetaType::VARIANTMAP, false);
-                appendProperty(result, container, name);
-            } break;
-            case ARRAY: {
-                int32_t length;
-                memcpy(&length, &data[offset], sizeof(uint32_t));
-
-                Variant container  = parse(data, offset, MetaType::VARIANTLIST, false);
-                appendProperty(result, container, name);
-            } break;
-            case BINARY: {
-                uint32_t length;
-                memcpy(&length, &data[offset],  sizeof(uint32_t));
-                offset += sizeof(uint32_t);
-                uint8_t sub;
-                memcpy(&sub, &data[offset],     sizeof(uint8_t));
-                offset++;
-                ByteArray value(data.begin() + offset, data.begin() + offset + length);
-
-                appendProperty(result, value, name);
-                offset += length;
-            } break;
-            case FLOAT: {
-                float value;
-                memcpy(&value, &data[offset], sizeof(float));
-                offset += sizeof(float);
-
-                appendProperty(result, value, name);
-            } break;
-            case INT32: {
-                int32_t value;
-                memcpy(&value, &data[offset], sizeof(uint32_t));
-                offset += sizeof(uint32_t);
-
-                appendProperty(result, value, name);
-            } break;
-            case VECTOR2: {
-                Vector2 value;
-                memcpy(&value, &data[offset], sizeof(Vector2));
-                offset += sizeof(Vector2);
-
-                appendProperty(result, value, name);
-            } break;
-            case VECTOR3: {
-                Vector3 value;
-                memcpy(&value, &data[offset], sizeof(Vector3));
-                offset += sizeof(Vector3);
-
-                appendProperty(result, value, name);
-            } break;
-            case VECTOR4: {
-                Vector4 value;
-                memcpy(&value, &data[offset], sizeof(Vector4));
-                offset += sizeof(Vector4);
-
-                appendProperty(result, value, name);
-            } break;
-            case MATRIX3: {
-                Matrix3 value;
-                memcpy(&value, &data[offset], sizeof(Matrix3));
-                offset += sizeof(Matrix3);
-
-                appendProperty(result, value, name);
-            } break;
-            case MATRIX4: {
-                Matrix4 value;
-                memcpy(&value, &data[offset], sizeof(Matrix4));
-                offset += sizeof(Matrix4);
-
-                appendProperty(result, value, name);
-            } break;
-            case QUATERNION: {
-                Quaternion value;
-                memcpy(&value, &data[offset], sizeof(Quaternion));
-                offset += sizeof(Quaternion);
-
-                appendProperty(result, value, name);
-            } break;
-            default: break;
-        }
+    uint32_t end = m_Ends[m_Depth - 1];
+    uint32_t offset = m_Next;
+    if(offset >= end) {
+        return false;
+    }
 
+    uint8_t tag = m_pData[offset];
+    uint32_t name = offset + 1;
+    const int8_t *zero = static_cast<const int8_t *>(memchr(&m_pData[name], 0, end - name));
+    if(zero == nullptr) {
+        m_Valid = false;
+        return false;
+    }
+    uint32_t value = (zero - m_pData) + 1;
+
+    uint32_t size = 0;
+    uint32_t header = 0;
+    switch(tag) {
+        case BOOL:      size = 1; break;
+        case INT32:     size = sizeof(int32_t); break;
+        case FLOAT:     size = sizeof(float); break;
+        case VECTOR2:   size = sizeof(Vector2); break;
+        case VECTOR3:   size = sizeof(Vector3); break;
+        case VECTOR4:   size = sizeof(Vector4); break;
+        case MATRIX3:   size = sizeof(Matrix3); break;
+        case MATRIX4:   size = sizeof(Matrix4); break;
+        case QUATERNION:size = sizeof(Quaternion); break;
+        case STRING: {
+            m_Valid = readSize(value, end, size);
+            header = sizeof(uint32_t);
+        } break;
+        case BINARY: {
+            m_Valid = readSize(value, end, size);
+            header = sizeof(uint32_t) + 1;
+        } break;
+        case OBJECT:
+        case ARRAY: {
+            m_Valid = readSize(value, end, size);
+        } break;
+        default: {
+            m_Valid = false;
+        } break;
     }
 
-    if(first && result.type() == MetaType::VARIANTLIST) {
-        return result.value<VariantList>();
+    // The length prefix is not trusted, it's checked in 64-bit to not wrap around near UINT32_MAX
+    if(!m_Valid || static_cast<uint64_t>(size) + header > end - value) {
+        m_Valid = false;
+        return false;
     }
+    size += header;
 
-    if(result.data() == nullptr) {
+    m_Type  = metaType(tag);
+    m_Name  = name;
+    m_Value = value;
+    m_Next  = value + size;
+    return true;
+}
+/*!
+    Moves the cursor inside of the current element if it's a nested document or array.
+    Returns true on success; otherwise returns false.
+
+    \sa leave()
+*/
+bool BsonReader::enter() {
+    if((m_Type != MetaType::VARIANTMAP && m_Type != MetaType::VARIANTLIST) || m_Depth >= BSON_MAX_DEPTH) {
+        return false;
+    }
+    m_Resumes[m_Depth] = m_Next;
+    m_Valid = open(m_Value, m_Type);
+    return m_Valid;
+}
+/*!
+    Skips the rest of the current nested document and moves the cursor back to its parent.
+    The next() call continues with the element which follows the nested document.
+    Returns false if the cursor is already in the root document.
+
+    \sa enter()
+*/
+bool BsonReader::leave() {
+    if(m_Depth <= 1) {
+        return false;
+    }
+    m_Depth--;
+    m_Next = m_Resumes[m_Depth];
+    m_Type = MetaType::INVALID;
+    return true;
+}
+/*!
+    Returns the nesting level of the current document, the root document has level 1.
+*/
+uint32_t BsonReader::depth() const {
+    return m_Depth;
+}
+/*!
+    Returns MetaType of the current element.
+    Nested documents are reported as MetaType::VARIANTMAP, arrays as MetaType::VARIANTLIST and binary data as MetaType::BYTEBUFFER.
+    Returns MetaType::INVALID if the cursor doesn't point to an element.
+*/
+uint32_t BsonReader::type() const {
+    return m_Type;
+}
+/*!
+    Returns the name of the current element.
+    The returned pointer references the source buffer and no copy is made.
+*/
+const char *BsonReader::name() const {
+    if(m_Type == MetaType::INVALID) {
+        return "";
+    }
+    return reinterpret_cast<const char *>(&m_pData[m_Name]);
+}
+/*!
+    Returns the current element as a bool value.
+*/
+bool BsonReader::toBool() const {
+    if(m_Type == MetaType::BOOLEAN) {
+        return (m_pData[m_Value] != 0);
+    }
+    return value().toBool();
+}
+/*!
+    Returns the current element as an integer value.
+*/
+int32_t BsonReader::toInt() const {
+    if(m_Type == MetaType::INTEGER) {
+        int32_t result;
+        memcpy(&result, &m_pData[m_Value], sizeof(int32_t));
+        return result;
+    }
+    return value().toInt();
+}
+/*!
+    Returns the current element as a float value.
+*/
+float BsonReader::toFloat() const {
+    if(m_Type == MetaType::FLOAT) {
+        float result;
+        memcpy(&result, &m_pData[m_Value], sizeof(float));
         return result;
     }
+    return value().toFloat();
+}
+/*!
+    Returns the current element as a string value.
+*/
+string BsonReader::toString() const {
+    if(m_Type == MetaType::STRING) {
+        uint32_t length;
+        memcpy(&length, &m_pData[m_Value], sizeof(uint32_t));
+        // The string never exceeds the extent of the element
+        uint32_t offset = m_Value + sizeof(uint32_t);
+        length = MIN(length, m_Next - offset);
+        const char *str = reinterpret_cast<const char *>(&m_pData[offset]);
+        return string(str, strnlen(str, length));
+    }
+    return value().toString();
+}
+/*!
+    Returns the current binary element as ByteBuffer.
+    If the reader was constructed from ByteBuffer the result shares its memory; otherwise bytes are copied.
+*/
+ByteBuffer BsonReader::toByteBuffer() const {
+    if(m_Type != MetaType::BYTEBUFFER) {
+        return ByteBuffer();
+    }
+    uint32_t length;
+    memcpy(&length, &m_pData[m_Value], sizeof(uint32_t));
+    uint32_t offset = m_Value + sizeof(uint32_t) + 1;
+    length = MIN(length, m_Next - offset);
+    if(m_pData && m_pData == m_Buffer.data()) {
+        return m_Buffer.slice(offset, length);
+    }
+    return ByteBuffer(&m_pData[offset], length);
+}
+/*!
+    Returns the current element as Variant, nested documents and arrays are converted with all their content.
+    If the cursor doesn't point to an element returns the rest of the current document.
+*/
+Variant BsonReader::toVariant() const {
+    if(m_Type == MetaType::INVALID) {
+        return document();
+    }
+    if(m_Type == MetaType::VARIANTMAP || m_Type == MetaType::VARIANTLIST) {
+        BsonReader reader(*this);
+        if(!reader.enter()) {
+            return Variant();
+        }
+        return reader.document();
+    }
+    return value();
+}
+/*!
+    \internal
+    Opens the document located at \a offset with expected \a type of container.
+*/
+bool BsonReader::open(uint32_t offset, uint32_t type) {
+    uint32_t limit = (m_Depth > 0) ? m_Ends[m_Depth - 1] : m_Size;
 
+    uint32_t size;
+    if(!readSize(offset, limit, size) || size < sizeof(uint32_t) + 1 || size > limit - offset) {
+        return false;
+    }
+    uint32_t end = offset + size - 1;
+    if(m_pData[end] != 0) {
+        return false;
+    }
+
+    m_Ends[m_Depth]  = end;
+    m_Kinds[m_Depth] = type;
+    m_Depth++;
+
+    m_Next = offset + sizeof(uint32_t);
+    m_Type = MetaType::INVALID;
+    return true;
+}
+/*!
+    \internal
+    Reads 32-bit size located at \a offset if it fits before \a end.
+*/
+bool BsonReader::readSize(uint32_t offset, uint32_t end, uint32_t &size) const {
+    if(m_pData == nullptr || offset > end || end - offset < sizeof(uint32_t)) {
+        return false;
+    }
+    memcpy(&size, &m_pData[offset], sizeof(uint32_t));
+    return true;
+}
+/*!
+    \internal
+    Returns value of the current element which is not a container.
+*/
+Variant BsonReader::value() const {
+    switch(m_Type) {
+        case MetaType::BOOLEAN:     return Variant(m_pData[m_Value] != 0);
+        case MetaType::INTEGER:     return Variant(toInt());
+        case MetaType::FLOAT:       return Variant(toFloat());
+        case MetaType::STRING:      return Variant(toString());
+        case MetaType::BYTEBUFFER:  return Variant(toByteBuffer());
+        case MetaType::VECTOR2:
+        case MetaType::VECTOR3:
+        case MetaType::VECTOR4:
+        case MetaType::MATRIX3:
+        case MetaType::MATRIX4:
+        case MetaType::QUATERNION:  return Variant(m_Type, &m_pData[m_Value]);
+        default: break;
+    }
+    return Variant();
+}
+/*!
+    \internal
+    Converts the rest of current document to Variant without recursion.
+*/
+Variant BsonReader::document() const {
+    PROFILE_FUNCTION();
+    if(!m_Valid || m_Depth == 0) {
+        return Variant();
+    }
+    BsonReader reader(*this);
+    uint32_t base = reader.m_Depth;
+
+    Variant result;
+    if(reader.m_Kinds[base - 1] == MetaType::VARIANTMAP) {
+        result = VariantMap();
+    } else {
+        result = VariantList();
+    }
+
+    void *stack[BSON_MAX_DEPTH];
+    stack[0] = result.data();
+    uint32_t top = 0;
+
+    while(true) {
+        if(!reader.next()) {
+            if(!reader.m_Valid) {
+                return Variant();
+            }
+            if(reader.m_Depth == base) {
+                break;
+            }
+            reader.leave();
+            top--;
+            continue;
+        }
+
+        uint32_t type = reader.m_Type;
+        uint32_t kind = reader.m_Kinds[reader.m_Depth - 1];
+        if(type == MetaType::VARIANTMAP || type == MetaType::VARIANTLIST) {
+            Variant *container = insert(stack[top], kind, reader.name(),
+                                        (type == MetaType::VARIANTMAP) ? Variant(VariantMap()) : Variant(VariantList()));
+            if(!reader.enter()) {
+                return Variant();
+            }
+            stack[++top] = container->data();
+        } else {
+            insert(stack[top], kind, reader.name(), reader.value());
+        }
+    }
     return result;
 }
 
@@ -200,6 +433,7 @@ uint8_t type(const Variant &data) {
         case MetaType::STRING:      result  = STRING; break;
         case MetaType::VARIANTMAP:  result  = OBJECT; break;
         case MetaType::BYTEARRAY:   result  = BINARY; break;
+        case MetaType::BYTEBUFFER:  result  = BINARY; break;
         case MetaType::VECTOR2:     result  = VECTOR2; break;
         case MetaType::VECTOR3:     result  = VECTOR3; break;
         case MetaType::VECTOR4:     result  = VECTOR4; break;
@@ -236,8 +470,24 @@ uint8_t type(const Variant &data) {
     Returns deserialized binary \a data as Variant based DOM structure with expected \a type of container (can be MetaType::VARIANTLIST or MetaType::VARIANTMAP).
 */
 Variant Bson::load(const ByteArray &data, MetaType::Type type) {
-    uint32_t offset = 0;
-    return parse(data, offset, type, true);
+    PROFILE_FUNCTION();
+    if(data.empty()) {
+        return Variant(type);
+    }
+    BsonReader reader(data.data(), data.size(), type);
+    return reader.toVariant();
+}
+/*!
+    Returns deserialized binary \a data as Variant based DOM structure with expected \a type of container (can be MetaType::VARIANTLIST or MetaType::VARIANTMAP).
+    Binary fields are returned as ByteBuffer slices of \a data, so they are not copied.
+*/
+Variant Bson::load(const ByteBuffer &data, MetaType::Type type) {
+    PROFILE_FUNCTION();
+    if(data.empty()) {
+        return Variant(type);
+    }
+    BsonReader reader(data, type);
+    return reader.toVariant();
 }
 /*!
     Returns serialized \a data as binary buffer.
@@ -258,15 +508,27 @@ ByteArray Bson::save(const Variant &data) {
             memcpy(&result[0], &size, sizeof(uint32_t));
             memcpy(&result[sizeof(uint32_t)], value.c_str(), size);
         } break;
-        case MetaType::BYTEARRAY: {
-            ByteArray value = data.toByteArray();
-            uint32_t size   = value.size();
+        case MetaType::BYTEARRAY:
+        case MetaType::BYTEBUFFER: {
+            const int8_t *value = nullptr;
+            uint32_t size   = 0;
+            if(data.data()) {
+                if(data.type() == MetaType::BYTEARRAY) {
+                    const ByteArray *array = reinterpret_cast<const ByteArray *>(data.data());
+                    value   = array->data();
+                    size    = array->size();
+                } else {
+                    const ByteBuffer *buffer = reinterpret_cast<const ByteBuffer *>(data.data());
+                    value   = buffer->data();
+                    size    = buffer->size();
+                }
+            }
             result.resize(sizeof(uint32_t) + 1 + size);
 
             memcpy(&result[0], &size, sizeof(uint32_t));
             result[sizeof(uint32_t)] = '\x00';
             if(size) {
-                memcpy(&result[sizeof(uint32_t) + 1], &value[0], size);
+                memcpy(&result[sizeof(uint32_t) + 1], value, size);
             }
         } break;
         case MetaType::VARIANTMAP: {
@@ -0,0 +1,126 @@
+#include "core/bytebuffer.h"
+
+#include <cstring>
+#include <algorithm>
+/*!
+    \class ByteBuffer
+    \brief ByteBuffer is an immutable, reference-counted block of bytes.
+    \since Next 1.0
+    \inmodule Core
+
+    Copies of ByteBuffer share the same memory, so binary payloads can be passed between Variant, Bson and resources without copying.
+    A slice() of the buffer references a part of the original memory and keeps it alive.
+
+    Example:
+    \code
+        ByteArray bytes = readFile(); // Raw file content
+        ByteBuffer buffer(std::move(bytes)); // Buffer takes the ownership without copying
+        ByteBuffer header = buffer.slice(0, 16); // Shares the same memory
+    \endcode
+*/
+/*!
+    Constructs an empty buffer.
+*/
+ByteBuffer::ByteBuffer() :
+        m_Offset(0),
+        m_Size(0) {
+
+}
+/*!
+    Constructs a buffer which takes the ownership of \a data without copying.
+*/
+ByteBuffer::ByteBuffer(ByteArray &&data) :
+        m_Data(make_shared<const ByteArray>(std::move(data))),
+        m_Offset(0),
+        m_Size(m_Data->size()) {
+
+}
+/*!
+    Constructs a buffer with a copy of \a data.
+*/
+ByteBuffer::ByteBuffer(const ByteArray &data) :
+        m_Data(make_shared<const ByteArray>(data)),
+        m_Offset(0),
+        m_Size(data.size()) {
+
+}
+/*!
+    Constructs a buffer with a copy of \a size bytes located at \a data.
+*/
+ByteBuffer::ByteBuffer(const int8_t *data, uint32_t size) :
+        m_Data(make_shared<const ByteArray>(data, data + size)),
+        m_Offset(0),
+        m_Size(size) {
+
+}
+/*!
+    Returns true if this buffer contains the same bytes as \a right buffer; otherwise returns false.
+*/
+bool ByteBuffer::operator==(const ByteBuffer &right) const {
+    if(m_Size != right.m_Size) {
+        return false;
+    }
+    if(data() == right.data() || m_Size == 0) {
+        return true;
+    }
+    return (memcmp(data(), right.data(), m_Size) == 0);
+}
+/*!
+    Returns true if this buffer contains different bytes than \a right buffer; otherwise returns false.
+*/
+bool ByteBuffer::operator!=(const ByteBuffer &right) const {
+    return !(*this == right);
+}
+/*!
+    Returns a pointer to the first byte of the buffer.
+    Returns nullptr for the empty buffer.
+*/
+const int8_t *ByteBuffer::data() const {
+    if(m_Data == nullptr || m_Data->empty()) {
+        return nullptr;
+    }
+    return m_Data->data() + m_Offset;
+}
+/*!
+    Returns the number of bytes in the buffer.
+*/
+uint32_t ByteBuffer::size() const {
+    return m_Size;
+}
+/*!
+    Returns true if the buffer has no bytes; otherwise returns false.
+*/
+bool ByteBuffer::empty() const {
+    return (m_Size == 0);
+}
+/*!
+    Returns a pointer to the first byte of the buffer.
+*/
+const int8_t *ByteBuffer::begin() const {
+    return data();
+}
+/*!
+    Returns a pointer past the last byte of the buffer.
+*/
+const int8_t *ByteBuffer::end() const {
+    return data() + m_Size;
+}
+/*!
+    Returns a buffer which shares \a size bytes of this buffer starting from \a offset.
+    The range is clamped to the bounds of this buffer.
+*/
+ByteBuffer ByteBuffer::slice(uint32_t offset, uint32_t size) const {
+    ByteBuffer result;
+    if(offset < m_Size) {
+        result.m_Data = m_Data;
+        result.m_Offset = m_Offset + offset;
+        result.m_Size = min(size, m_Size - offset);
+    }
+    return result;
+}
+/*!
+    Returns a copy of buffer bytes as ByteArray.
+*/
+ByteArray ByteBuffer::toByteArray() const {
+    return ByteArray(begin(), end());
+}
@@ -1,4 +1,117 @@
 #include "core/event.h"
+
+#include <mutex>
+#include <new>
+
+using namespace std;
+
+#define POOL_GRANULARITY    16
+#define POOL_CLASSES        16
+#define POOL_BATCH          32
+#define POOL_CACHE          (POOL_BATCH * 2)
+#define POOL_SLAB           64
+
+class EventPool {
+public:
+    struct Block {
+        Block              *m_pNext;
+    };
+
+    struct Cache {
+        Block              *m_pFree[POOL_CLASSES];
+
+        uint32_t            m_Count[POOL_CLASSES];
+    };
+
+public:
+    EventPool() {
+        for(uint32_t i = 0; i < POOL_CLASSES; i++) {
+            m_pFree[i] = nullptr;
+        }
+    }
+
+    static EventPool *instance() {
+        // Intentionally never destroyed, events can be released during static destruction
+        static EventPool *pool = new EventPool;
+        return pool;
+    }
+
+    static uint32_t sizeClass(size_t size) {
+        return static_cast<uint32_t>((size + POOL_GRANULARITY - 1) / POOL_GRANULARITY) - 1;
+    }
+
+    void *allocate(uint32_t index) {
+        Cache &cache = s_Cache;
+        Block *block = cache.m_pFree[index];
+        if(block == nullptr) {
+            cache.m_Count[index] = acquire(index, cache.m_pFree[index]);
+            block = cache.m_pFree[index];
+        }
+        cache.m_pFree[index] = block->m_pNext;
+        cache.m_Count[index]--;
+        return block;
+    }
+
+    void free(uint32_t index, void *pointer) {
+        Cache &cache = s_Cache;
+        Block *block = static_cast<Block *>(pointer);
+        block->m_pNext = cache.m_pFree[index];
+        cache.m_pFree[index] = block;
+        cache.m_Count[index]++;
+        if(cache.m_Count[index] > POOL_CACHE) {
+            Block *first = cache.m_pFree[index];
+            Block *last = first;
+            for(uint32_t i = 1; i < POOL_BATCH; i++) {
+                last = last->m_pNext;
+            }
+            cache.m_pFree[index] = last->m_pNext;
+            cache.m_Count[index] -= POOL_BATCH;
+
+            unique_lock<mutex> locker(m_Mutex[index]);
+            last->m_pNext = m_pFree[index];
+            m_pFree[index] = first;
+        }
+    }
+
+protected:
+    uint32_t acquire(uint32_t index, Block *&list) {
+        {
+            unique_lock<mutex> locker(m_Mutex[index]);
+            if(m_pFree[index]) {
+                uint32_t count = 1;
+                Block *last = m_pFree[index];
+                while(count < POOL_BATCH && last->m_pNext) {
+                    last = last->m_pNext;
+                    count++;
+                }
+                list = m_pFree[index];
+                m_pFree[index] = last->m_pNext;
+                last->m_pNext = nullptr;
+                return count;
+            }
+        }
+        // Slabs are never returned to the system, its blocks are reused by the pool
+        size_t size = (index + 1) * POOL_GRANULARITY;
+        uint8_t *slab = static_cast<uint8_t *>(::operator new(size * POOL_SLAB));
+        list = nullptr;
+        for(uint32_t i = POOL_SLAB; i > 0; i--) {
+            Block *block = reinterpret_cast<Block *>(&slab[(i - 1) * size]);
+            block->m_pNext = list;
+            list = block;
+        }
+        return POOL_SLAB;
+    }
+
+    mutex                   m_Mutex[POOL_CLASSES];
+
+    Block                  *m_pFree[POOL_CLASSES];
+
+    // Trivially destructible on purpose, cached blocks of exited threads are not returned
+    static thread_local Cache s_Cache;
+};
+
+thread_local EventPool::Cache EventPool::s_Cache;
+
 /*!
     \class Event
     \brief The Event class is the base calss for all event classes.
@@ -10,6 +123,9 @@
 
     Base Event contain only event type parameter. Subclasses of Event may contain additional parameters to describe particular events.
 
+    Events and its subclasses are allocated from the pool of fixed size blocks.
+    Each thread keeps own cache of free blocks, so creating and deleting of events usually doesn't touch the system allocator and doesn't take any locks.
+
     \sa Object::event()
 */
 /*!
@@ -29,7 +145,8 @@
     Constructs an Event with \a type of event.
 */
 Event::Event(uint32_t type) :
-        m_Type(type) {
+        m_Type(type),
+        m_pNext(nullptr) {
     PROFILE_FUNCTION();
 }
 
@@ -44,3 +161,26 @@ uint32_t Event::type() const {
     PROFILE_FUNCTION();
     return m_Type;
 }
+/*!
+    Allocates memory of \a size bytes for the new event from the event pool.
+    Big events are allocated by the system allocator.
+*/
+void *Event::operator new(size_t size) {
+    if(size > POOL_GRANULARITY * POOL_CLASSES) {
+        return ::operator new(size);
+    }
+    return EventPool::instance()->allocate(EventPool::sizeClass(size));
+}
+/*!
+    Returns memory of \a size bytes which pointed by \a pointer to the event pool.
+*/
+void Event::operator delete(void *pointer, size_t size) {
+    if(pointer == nullptr) {
+        return;
+    }
+    if(size > POOL_GRANULARITY * POOL_CLASSES) {
+        ::operator delete(pointer);
+        return;
+    }
+    EventPool::instance()->free(EventPool::sizeClass(size), pointer);
+}
@@ -0,0 +1,176 @@
+#include "core/framearena.h"
+
+#include <atomic>
+#include <new>
+
+class ArenaBuffer {
+public:
+    struct Block {
+        Block              *m_pNext;
+
+        size_t              m_Size;
+    };
+
+    struct Page {
+        Block              *m_pBlocks;
+
+        uint8_t            *m_pCurrent;
+
+        uint8_t            *m_pEnd;
+
+        size_t              m_Used;
+    };
+
+public:
+    ArenaBuffer() :
+            m_Epoch(s_Epoch.load(memory_order_acquire)) {
+        for(auto &it : m_Pages) {
+            it.m_pBlocks = nullptr;
+            it.m_pCurrent = nullptr;
+            it.m_pEnd = nullptr;
+            it.m_Used = 0;
+        }
+    }
+
+    ~ArenaBuffer() {
+        for(auto &it : m_Pages) {
+            release(it.m_pBlocks);
+        }
+    }
+
+    void *allocate(size_t size, size_t align) {
+        uint32_t epoch = s_Epoch.load(memory_order_acquire);
+        if(epoch != m_Epoch) {
+            m_Epoch = epoch;
+            reset(m_Pages[epoch & 1]);
+        }
+        Page &page = m_Pages[m_Epoch & 1];
+
+        uint8_t *result = aligned(page.m_pCurrent, align);
+        if(result == nullptr || result + size > page.m_pEnd) {
+            grow(page, (size + align > ARENA_BLOCK) ? size + align : ARENA_BLOCK);
+            result = aligned(page.m_pCurrent, align);
+        }
+        page.m_pCurrent = result + size;
+        page.m_Used += size;
+        return result;
+    }
+
+    size_t used() const {
+        return (m_Epoch == s_Epoch.load(memory_order_acquire)) ? m_Pages[m_Epoch & 1].m_Used : 0;
+    }
+
+    static atomic<uint32_t> s_Epoch;
+
+protected:
+    static uint8_t *aligned(uint8_t *pointer, size_t align) {
+        uintptr_t address = reinterpret_cast<uintptr_t>(pointer);
+        return reinterpret_cast<uint8_t *>((address + align - 1) & ~(static_cast<uintptr_t>(align) - 1));
+    }
+
+    static void release(Block *block) {
+        while(block) {
+            Block *next = block->m_pNext;
+            ::operator delete(block);
+            block = next;
+        }
+    }
+
+    static void grow(Page &page, size_t size) {
+        Block *block = static_cast<Block *>(::operator new(sizeof(Block) + size));
+        block->m_pNext = page.m_pBlocks;
+        block->m_Size = size;
+        page.m_pBlocks = block;
+        page.m_pCurrent = reinterpret_cast<uint8_t *>(block + 1);
+        page.m_pEnd = page.m_pCurrent + size;
+    }
+
+    static void reset(Page &page) {
+        Block *block = page.m_pBlocks;
+        if(block && block->m_pNext) {
+            // The page was overflowed during the previous use, replace the chain with a single block which fits everything
+            size_t size = block->m_Size;
+            for(Block *it = block->m_pNext; it; it = it->m_pNext) {
+                size += it->m_Size;
+            }
+            release(block);
+            page.m_pBlocks = nullptr;
+            grow(page, size);
+        } else if(block) {
+            page.m_pCurrent = reinterpret_cast<uint8_t *>(block + 1);
+        }
+        page.m_Used = 0;
+    }
+
+    Page                    m_Pages[2];
+
+    uint32_t                m_Epoch;
+};
+
+atomic<uint32_t> ArenaBuffer::s_Epoch(0);
+
+static thread_local ArenaBuffer s_Buffer;
+
+/*!
+    \class FrameArena
+    \brief The FrameArena class provides the memory for the transient per frame data.
+    \since Next 1.0
+    \inmodule Core
+
+    FrameArena is a linear allocator, each thread has own arena, so allocation is just a pointer bump without any locks.
+    The memory is never freed individually, instead the whole arena is reused when the frame is changed by nextFrame().
+
+    Each arena keeps two pages which are used by the even and odd frames, so the memory allocated during the frame stays valid till the end of the next frame.
+    The frame must be switched exactly once per frame by its owner, otherwise the memory of the previous frame is reused too early.
+    When a page is overflowed, it's extended with the additional blocks which are merged into the one on the next reuse, so in the steady state the arena doesn't touch the system allocator at all.
+
+    The memory is intended for the gather, culling and sorting results which are thrown away at the end of frame.
+    The FrameAllocator and FrameVector types allow to use the arena with the standard containers.
+    \note Destructors of objects placed in the arena are never called.
+
+    \code
+        FrameVector<Renderable *> result;
+        result.reserve(list.size());
+        for(auto it : list) {
+            if(isVisible(it)) {
+                result.push_back(it);
+            }
+        }
+    \endcode
+*/
+/*!
+    \class FrameAllocator
+    \brief The FrameAllocator class is an allocator for the standard containers which uses the FrameArena of the current thread.
+    \since Next 1.0
+    \inmodule Core
+
+    Deallocation does nothing, so containers which are grown step by step waste the arena memory, please reserve the required size in advance.
+*/
+/*!
+    Allocates \a size bytes aligned by \a align from the arena of the current thread.
+    The \a align must be a power of two.
+*/
+void *FrameArena::allocate(size_t size, size_t align) {
+    return s_Buffer.allocate(size, align);
+}
+/*!
+    Switches all arenas to the next frame.
+    The memory allocated two frames ago will be reused by the next allocations.
+    \note Usually, this method calls internally and must not be called manually.
+    The Engine calls it at the end of Engine::update(), the RenderSystem calls it only for the renders which are executed outside of the Engine frame, for example by the editor viewports.
+*/
+void FrameArena::nextFrame() {
+    ArenaBuffer::s_Epoch.fetch_add(1, memory_order_acq_rel);
+}
+/*!
+    Returns the index of the current frame.
+*/
+uint32_t FrameArena::frameIndex() {
+    return ArenaBuffer::s_Epoch.load(memory_order_acquire);
+}
+/*!
+    Returns the number of bytes allocated during the current frame in the arena of the current thread.
+*/
+size_t FrameArena::usedBytes() {
+    return s_Buffer.used();
+}
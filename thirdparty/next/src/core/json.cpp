@@ -1,8 +1,8 @@
 #include "core/json.h"
 
-#include <list>
-#include <map>
-#include <stack>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
 
 #include "core/variant.h"
 #include "core/objectsystem.h"
@@ -11,83 +11,363 @@
 #define J_FALSE "false"
 #define J_NULL  "null"
 
-#define FORMAT (tab > -1) ? "\n" : ""
+#define BUFFER_SIZE 16384
 
-typedef stack<Variant>  VariantStack;
-typedef stack<string>   NameStack;
+inline bool isSpace(uint8_t c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+inline bool isDigit(uint8_t c) {
+    return c >= '0' && c <= '9';
+}
+
+class JsonParser {
+public:
+    JsonParser(const char *data, uint32_t size) :
+            m_pData(data),
+            m_pEnd(data + size) {
 
-void appendProperty(VariantStack &s, const Variant &data, const string &name) {
-    Variant v;
-    if(!s.empty()) {
-        v = s.top();
-        s.pop();
     }
-    switch(v.type()) {
-        case MetaType::VARIANTLIST: {
-            VariantList &list = *(reinterpret_cast<VariantList *>(v.data()));
-            list.push_back(data);
-            s.push(list);
-            return;
-        }
-        case MetaType::VARIANTMAP: {
-            VariantMap &map = *(reinterpret_cast<VariantMap *>(v.data()));
-            uint32_t type = MetaType::type(name.c_str());
-            if((type >= MetaType::VECTOR2 && type < MetaType::USERTYPE)) {
-                Variant object(type, MetaType::create(type));
-                VariantList &list = *(reinterpret_cast<VariantList *>(data.data()));
-                MetaType::convert(&list, MetaType::VARIANTLIST, object.data(), type);
-                s.push(object);
+
+    Variant parse() {
+        Variant result;
+
+        vector<Variant *> stack;
+        string name;
+        while(true) {
+            skipSpaces();
+            if(m_pData >= m_pEnd) {
+                return Variant();
+            }
+            // Read the next value and put it to the current container
+            char c = *m_pData;
+            Variant value;
+            switch(c) {
+                case '{': value = VariantMap(); break;
+                case '[': value = VariantList(); break;
+                case '"': {
+                    string str;
+                    if(!readString(str)) {
+                        return Variant();
+                    }
+                    value = Variant(std::move(str));
+                } break;
+                case 't': {
+                    if(!readLiteral(J_TRUE, 4)) {
+                        return Variant();
+                    }
+                    value = true;
+                } break;
+                case 'f': {
+                    if(!readLiteral(J_FALSE, 5)) {
+                        return Variant();
+                    }
+                    value = false;
+                } break;
+                case 'n': {
+                    if(!readLiteral(J_NULL, 4)) {
+                        return Variant();
+                    }
+                } break;
+                default: {
+                    if(!isDigit(c) && c != '-') {
+                        return Variant();
+                    }
+                    value = readNumber();
+                } break;
+            }
+
+            Variant *slot = &result;
+            if(!stack.empty()) {
+                slot = insert(*stack.back(), name, std::move(value));
             } else {
-                map[name] = data;
-                s.push(map);
+                result = std::move(value);
+            }
+
+            if(c == '{' || c == '[') {
+                m_pData++;
+                stack.push_back(slot);
+                skipSpaces();
+                if(m_pData < m_pEnd && *m_pData != ((c == '{') ? '}' : ']')) {
+                    if(c == '{' && !readName(name)) {
+                        return Variant();
+                    }
+                    continue;
+                }
+            }
+            // Close finished containers until the next sibling value
+            while(true) {
+                if(stack.empty()) {
+                    return result;
+                }
+                skipSpaces();
+                if(m_pData >= m_pEnd) {
+                    return Variant();
+                }
+                Variant *top = stack.back();
+                bool map = (top->type() == MetaType::VARIANTMAP);
+                c = *m_pData++;
+                if(c == ',') {
+                    if(map && !readName(name)) {
+                        return Variant();
+                    }
+                    break;
+                }
+                if(c != ((map) ? '}' : ']')) {
+                    return Variant();
+                }
+                if(map) {
+                    toMathType(*top);
+                }
+                stack.pop_back();
+            }
+        }
+        return result;
+    }
+
+protected:
+    void skipSpaces() {
+        while(m_pData < m_pEnd && isSpace(*m_pData)) {
+            m_pData++;
+        }
+    }
+
+    bool readString(string &result) {
+        const char *begin = ++m_pData;
+        while(m_pData < m_pEnd && *m_pData != '"') {
+            if(*m_pData == '\\') {
+                m_pData++;
+            }
+            m_pData++;
+        }
+        if(m_pData >= m_pEnd) {
+            return false;
+        }
+        result.assign(begin, m_pData - begin);
+        m_pData++;
+        return true;
+    }
+
+    bool readName(string &name) {
+        skipSpaces();
+        if(m_pData >= m_pEnd || *m_pData != '"' || !readString(name)) {
+            return false;
+        }
+        skipSpaces();
+        if(m_pData >= m_pEnd || *m_pData != ':') {
+            return false;
+        }
+        m_pData++;
+        return true;
+    }
+
+    bool readLiteral(const char *literal, uint32_t length) {
+        if(static_cast<uint32_t>(m_pEnd - m_pData) < length || strncmp(m_pData, literal, length) != 0) {
+            return false;
+        }
+        m_pData += length;
+        return true;
+    }
+
+    Variant readNumber() {
+        char buffer[64];
+        uint32_t length = 0;
+        bool number = false;
+        while(m_pData < m_pEnd && length < sizeof(buffer) - 1) {
+            char c = *m_pData;
+            if(c == '.' || c == 'e' || c == 'E') {
+                number = true;
+            } else if(!isDigit(c) && !(c == '-' || c == '+')) {
+                break;
             }
+            buffer[length++] = c;
+            m_pData++;
+        }
+        buffer[length] = '\0';
+
+        char *end;
+        if(number) {
+            return Variant(strtof(buffer, &end));
+        }
+        return Variant(static_cast<int32_t>(strtol(buffer, &end, 10)));
+    }
+
+    static Variant *insert(Variant &container, const string &name, Variant &&value) {
+        if(container.type() == MetaType::VARIANTLIST) {
+            VariantList &list = *(reinterpret_cast<VariantList *>(container.data()));
+            list.push_back(std::move(value));
+            return &list.back();
+        }
+        VariantMap &map = *(reinterpret_cast<VariantMap *>(container.data()));
+        // Serialized maps are sorted, so most of keys are appended at the end of map
+        if(map.empty() || map.rbegin()->first < name) {
+            return &map.emplace_hint(map.end(), name, std::move(value))->second;
+        }
+        Variant &result = map[name];
+        result = std::move(value);
+        return &result;
+    }
+
+    static void toMathType(Variant &value) {
+        const VariantMap &map = *(reinterpret_cast<VariantMap *>(value.data()));
+        if(map.size() != 1 || map.begin()->second.type() != MetaType::VARIANTLIST) {
             return;
         }
-        default: break;
+        uint32_t type = MetaType::type(map.begin()->first.c_str());
+        if(type >= MetaType::VECTOR2 && type < MetaType::USERTYPE) {
+            Variant object(type, MetaType::create(type));
+            MetaType::convert(map.begin()->second.data(), MetaType::VARIANTLIST, object.data(), type);
+            value = std::move(object);
+        }
     }
-    s.push(v);
-}
 
+    const char             *m_pData;
 
-inline string readString(const string &data, uint32_t &it) {
-    PROFILE_FUNCTION();
-    uint32_t s  = ++it;
-    char c = data[s];
-    while(it < data.length() && c != '"') {
-        c = data[++it];
-        if(c == '\\') {
-            c = data[++it];
+    const char             *m_pEnd;
+};
+
+class JsonStream {
+public:
+    explicit JsonStream(const Json::Writer &writer) :
+            m_Writer(writer),
+            m_Size(0) {
+
+    }
+
+    ~JsonStream() {
+        flush();
+    }
+
+    void write(const char *data, uint32_t size) {
+        if(m_Size + size > BUFFER_SIZE) {
+            flush();
+            if(size > BUFFER_SIZE) {
+                m_Writer(data, size);
+                return;
+            }
         }
+        memcpy(m_Buffer + m_Size, data, size);
+        m_Size += size;
     }
-    return data.substr(s, it - s);
-}
 
-inline bool isSpace(uint8_t c) {
-    PROFILE_FUNCTION();
-    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
-}
+    void write(const char *data) {
+        write(data, strlen(data));
+    }
 
-inline void skipSpaces(const char *data, uint32_t &it) {
-    PROFILE_FUNCTION();
-    while(isSpace(data[it])) {
-        it++;
+    void write(const string &data) {
+        write(data.c_str(), data.size());
     }
-}
 
-inline bool isDigit(uint8_t c) {
-    PROFILE_FUNCTION();
-    return c >= '0' && c <= '9';
-}
+    void put(char c) {
+        if(m_Size == BUFFER_SIZE) {
+            flush();
+        }
+        m_Buffer[m_Size++] = c;
+    }
 
-enum States {
-    objectBegin = 1,
-    objectEnd,
-    arrayBegin,
-    arrayEnd,
-    propertyNext,
-    propertyName,
-    propertyValue
+    void indent(int32_t count) {
+        for(int32_t i = 0; i < count; i++) {
+            put('\t');
+        }
+    }
+
+    void newLine(int32_t tab) {
+        if(tab > -1) {
+            put('\n');
+        }
+    }
+
+    void flush() {
+        if(m_Size > 0) {
+            m_Writer(m_Buffer, m_Size);
+            m_Size = 0;
+        }
+    }
+
+protected:
+    const Json::Writer     &m_Writer;
+
+    uint32_t                m_Size;
+
+    char                    m_Buffer[BUFFER_SIZE];
 };
+
+static void writeValue(JsonStream &stream, const Variant &data, int32_t tab) {
+    int32_t next    = (tab > -1) ? tab + 1 : tab;
+    uint32_t type   = data.type();
+    switch(type) {
+        case MetaType::BOOLEAN: {
+            stream.write(data.toBool() ? J_TRUE : J_FALSE);
+        } break;
+        case MetaType::INTEGER: {
+            char buffer[16];
+            stream.write(buffer, snprintf(buffer, sizeof(buffer), "%d", data.toInt()));
+        } break;
+        case MetaType::FLOAT: {
+            char buffer[64];
+            stream.write(buffer, snprintf(buffer, sizeof(buffer), "%f", data.toFloat()));
+        } break;
+        case MetaType::STRING: {
+            stream.put('"');
+            stream.write(*(reinterpret_cast<const string *>(data.data())));
+            stream.put('"');
+        } break;
+        case MetaType::VARIANTLIST: {
+            const VariantList &list = *(reinterpret_cast<const VariantList *>(data.data()));
+            stream.put('[');
+            stream.newLine(tab);
+            uint32_t i  = 1;
+            for(auto &it: list) {
+                stream.indent(tab + 1);
+                writeValue(stream, it, next);
+                if(i < list.size()) {
+                    stream.put(',');
+                }
+                stream.newLine(tab);
+                i++;
+            }
+            stream.indent(tab);
+            stream.put(']');
+        } break;
+        default: {
+            stream.put('{');
+            stream.newLine(tab);
+            if(type >= MetaType::VECTOR2 && type < MetaType::USERTYPE) {
+                stream.indent(tab + 1);
+                stream.put('"');
+                stream.write(MetaType::name(type));
+                stream.write("\":");
+                stream.newLine(tab);
+                stream.indent(tab + 1);
+                writeValue(stream, data.toList(), next);
+                stream.newLine(tab);
+            } else {
+                VariantMap local;
+                const VariantMap *map = &local;
+                if(type == MetaType::VARIANTMAP) {
+                    map = reinterpret_cast<const VariantMap *>(data.data());
+                } else {
+                    local = data.toMap();
+                }
+                uint32_t i = 1;
+                for(auto &it: *map) {
+                    stream.indent(tab + 1);
+                    stream.put('"');
+                    stream.write(it.first);
+                    stream.write((tab > -1) ? "\": " : "\":");
+                    writeValue(stream, it.second, next);
+                    if(i < map->size()) {
+                        stream.put(',');
+                    }
+                    stream.newLine(tab);
+                    i++;
+                }
+            }
+            stream.indent(tab);
+            stream.put('}');
+        } break;
+    }
+}
 /*!
     \class Json
     \brief JSON format parser.
@@ -97,6 +377,9 @@ enum States {
     This class implements Json parser with Variant based DOM structure input/output.
     It allows to serialize and deserialize object structures represented in Variant DOM structure.
 
+    The parser makes a single pass over the text and builds containers in place, nested containers are tracked without recursion.
+    The writer streams the text in chunks to a Writer function, so large documents can be saved to a file without building the whole string in memory.
+
     Example:
     \code
         VariantMap dictionary;
@@ -110,193 +393,56 @@ enum States {
         VariantMap result = Json::load(data).toMap(); // Resotoring it back
     \endcode
 */
+/*!
+    \typedef Json::Writer
+
+    Function which receives the serialized text chunk by chunk.
+*/
 /*!
     Returns deserialized string \a data as Variant based DOM structure.
 */
 Variant Json::load(const string &data) {
+    return load(data.c_str(), data.size());
+}
+/*!
+    Returns deserialized \a data with \a size bytes as Variant based DOM structure.
+    The \a data is not required to be null terminated.
+    Returns invalid Variant in case of malformed data.
+*/
+Variant Json::load(const char *data, uint32_t size) {
     PROFILE_FUNCTION();
-    Variant result;
-
-    VariantStack s;
-    NameStack    n;
-    string name;
-    States state = propertyValue;
-    uint32_t it  = 0;
-    while(it < data.length()) {
-        skipSpaces(data.c_str(), it);
-        switch(data[it]) {
-            case '{': {
-                VariantMap map;
-                s.push(map);
-                n.push(name);
-                name  = "";
-                state = propertyName;
-            } break;
-            case '}': {
-                result = s.top();
-                s.pop();
-                if(!s.empty()) {
-                    appendProperty(s, result, n.top());
-                }
-                n.pop();
-                state = propertyName;
-            } break;
-            case '[': {
-                if(state == propertyValue) {
-                    VariantList list;
-                    s.push(list);
-                    n.push(name);
-                    name    = "";
-                }
-            } break;
-            case ']': {
-                result = s.top();
-                s.pop();
-                if(!s.empty()) {
-                    appendProperty(s, result, n.top());
-                }
-                n.pop();
-                state = propertyName;
-            } break;
-            case ':': {
-                state   = propertyValue;
-            } break;
-            case ',': {
-                if(s.top().type() == MetaType::VARIANTLIST) {
-                    state = propertyValue;
-                } else {
-                    state = propertyName;
-                    name = "";
-                }
-            } break;
-            case '"': {
-                string str = readString(data, it);
-                if(state == propertyName) {
-                    name = str;
-                } else {
-                    appendProperty(s, str, name);
-                }
-            } break;
-            case '0':
-            case '1':
-            case '2':
-            case '3':
-            case '4':
-            case '5':
-            case '6':
-            case '7':
-            case '8':
-            case '9':
-            case '-': {
-                uint32_t st = it;
-                bool number = false;
-                while(it < data.length()) {
-                    char c  = data[++it];
-                    if(!isDigit(c) && c != '.') {
-                        break;
-                    }
-                    if(c == '.') {
-                        number = true;
-                    }
-                }
-                if(state == propertyValue) {
-                    Variant v(data.substr(st, it - st));
-                    appendProperty(s, (number) ? Variant(v.toFloat()) : Variant(v.toInt()), name);
-                }
-                it--;
-            } break;
-            case 't': {
-                if(data.substr(it, 4) == J_TRUE) {
-                    if(state == propertyValue) {
-                        appendProperty(s, true, name);
-                    }
-                    it += 3;
-                }
-            } break;
-            case 'f': {
-                if(data.substr(it, 5) == J_FALSE) {
-                    if(state == propertyValue) {
-                        appendProperty(s, false, name);
-                    }
-                    it += 4;
-                }
-            } break;
-            case 'n': {
-                if(data.substr(it, 4) == J_NULL) {
-                    if(state == propertyValue) {
-                        appendProperty(s, static_cast<void *>(nullptr), name);
-                    }
-                    it += 3;
-                }
-            } break;
-            default: {
-                return result;
-            }
-        }
-        it++;
+    if(data == nullptr || size == 0) {
+        return Variant();
     }
-    return result;
+    JsonParser parser(data, size);
+    return parser.parse();
 }
 /*!
     Returns serialized \a data as string.
     Argument \a tab is used as JSON tabulation formatting offset (-1 for one line JSON)
 */
 string Json::save(const Variant &data, int32_t tab) {
-    PROFILE_FUNCTION();
     string result;
-    uint32_t type   = data.type();
-    switch(type) {
-        case MetaType::BOOLEAN:
-        case MetaType::FLOAT:
-        case MetaType::INTEGER: {
-            result += data.toString();
-        } break;
-        case MetaType::STRING: {
-            result += '"' + data.toString() + '"';
-        } break;
-        case MetaType::VARIANTLIST: {
-            result += "[";
-            result += FORMAT;
-            uint32_t i  = 1;
-            VariantList list = data.toList();
-            for(auto &it: list) {
-                result.append(tab + 1, '\t');
-                result += save(it, (tab > -1) ? tab + 1 : tab);
-                result += ((i < list.size()) ? "," : "");
-                result += FORMAT;
-                i++;
-            }
-            if(tab > -1) {
-                result.append(tab, '\t');
-            }
-            result += "]";
-        } break;
-        default: {
-            result += "{";
-            result += FORMAT;
-            uint32_t i = 1;
-            if(type >= MetaType::VECTOR2 && type < MetaType::USERTYPE) {
-                result.append(tab + 1, '\t');
-                result += (string("\"") + MetaType::name(type) + "\":");
-                result += FORMAT;
-                result.append(tab + 1, '\t');
-                result += save(data.toList(), (tab > -1) ? tab + 1 : tab);
-                result += FORMAT;
-            } else {
-                VariantMap map = data.toMap();
-                for(auto &it: map) {
-                    result.append(tab + 1, '\t');
-                    result += "\"" + it.first + "\":" + ((tab > -1) ? " " : "") + save(it.second, (tab > -1) ? tab + 1 : tab);
-                    result += ((i < map.size()) ? "," : "");
-                    result += FORMAT;
-                    i++;
-                }
-            }
-            if(tab > -1) {
-                result.append(tab, '\t');
-            }
-            result += "}";
-        } break;
-    }
+    save(data, [&result](const char *chunk, uint32_t size) {
+        result.append(chunk, size);
+    }, tab);
     return result;
 }
+/*!
+    Serializes \a data and passes the text to \a writer in chunks.
+    Argument \a tab is used as JSON tabulation formatting offset (-1 for one line JSON)
+
+    Example:
+    \code
+        _FILE *fp = file->fopen("settings.json", "w");
+        Json::save(data, [file, fp](const char *chunk, uint32_t size) {
+            file->fwrite(chunk, size, 1, fp);
+        }, 0);
+        file->fclose(fp);
+    \endcode
+*/
+void Json::save(const Variant &data, const Writer &writer, int32_t tab) {
+    PROFILE_FUNCTION();
+    JsonStream stream(writer);
+    writeValue(stream, data, tab);
+}
@@ -139,7 +139,20 @@ MethodCallEvent::MethodCallEvent(int32_t method, Object *sender, const Variant &
         Event(MethodCall),
         m_pSender(sender),
         m_Method(method),
-        m_Args(args) {
+        m_Args(args),
+        m_pArgs(&m_Args) {
+    PROFILE_FUNCTION();
+}
+/*!
+    Constructs MethodCallEvent which refers to the \a args of the \a method call from \a sender without copying them.
+    Used for the direct calls.
+    \note The \a args must outlive the event.
+*/
+MethodCallEvent::MethodCallEvent(int32_t method, Object *sender, const Variant *args) :
+        Event(MethodCall),
+        m_pSender(sender),
+        m_Method(method),
+        m_pArgs(args) {
     PROFILE_FUNCTION();
 }
 /*!
@@ -161,5 +174,5 @@ int32_t MethodCallEvent::method() const {
 */
 const Variant *MethodCallEvent::args() const {
     PROFILE_FUNCTION();
-    return &m_Args;
+    return m_pArgs;
 }
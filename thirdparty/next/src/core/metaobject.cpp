@@ -3,6 +3,44 @@
 #include "core/object.h"
 
 #include <cstring>
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+
+static uint32_t nameHash(const char *name) {
+    // FNV-1a
+    uint32_t result = 2166136261U;
+    while(*name) {
+        result ^= static_cast<uint8_t>(*name);
+        result *= 16777619U;
+        name++;
+    }
+    return result;
+}
+
+typedef unordered_map<string, uint32_t> TypeIdMap;
+
+static mutex &typeIdMutex() {
+    static mutex result;
+    return result;
+}
+
+static TypeIdMap &typeIds() {
+    static TypeIdMap result;
+    return result;
+}
+
+static uint32_t registerTypeId(const char *name) {
+    lock_guard<mutex> locker(typeIdMutex());
+    TypeIdMap &ids = typeIds();
+    auto it = ids.find(name);
+    if(it != ids.end()) {
+        return it->second;
+    }
+    uint32_t result = static_cast<uint32_t>(ids.size()) + 1;
+    ids[name] = result;
+    return result;
+}
 /*!
     \class MetaObject
     \brief The MetaObject provides an interface to retrieve information about Object at runtime.
@@ -32,17 +70,34 @@ MetaObject::MetaObject(const char *name, const MetaObject *super, const Construc
         m_pEnums(enums),
         m_MethodCount(0),
         m_PropCount(0),
-        m_EnumCount(0) {
+        m_EnumCount(0),
+        m_MethodOffset((super) ? super->methodCount() : 0),
+        m_PropOffset((super) ? super->propertyCount() : 0) {
     PROFILE_FUNCTION();
     while(methods && methods[m_MethodCount].name) {
+        m_Signatures.push_back(MetaMethod(methods + m_MethodCount).signature());
+        m_MethodHashes.push_back(nameHash(m_Signatures.back().c_str()));
         m_MethodCount++;
     }
     while(props && props[m_PropCount].type) {
+        m_PropertyIndex.push_back(make_pair(nameHash(props[m_PropCount].name), m_PropOffset + m_PropCount));
         m_PropCount++;
     }
+    // Own properties go first to shadow the properties of super classes with the same name
+    if(super) {
+        m_PropertyIndex.insert(m_PropertyIndex.end(), super->m_PropertyIndex.begin(), super->m_PropertyIndex.end());
+    }
+    stable_sort(m_PropertyIndex.begin(), m_PropertyIndex.end(), [](const pair<uint32_t, int> &left, const pair<uint32_t, int> &right) {
+        return left.first < right.first;
+    });
     while(enums && enums[m_EnumCount].name) {
         m_EnumCount++;
     }
+    // Own type goes first, the root class is the last one
+    m_Hierarchy.push_back(registerTypeId(name));
+    if(super) {
+        m_Hierarchy.insert(m_Hierarchy.end(), super->m_Hierarchy.begin(), super->m_Hierarchy.end());
+    }
 }
 /*!
     Returns the name of the object type.
@@ -71,17 +126,7 @@ Object *MetaObject::createInstance() const {
 */
 int MetaObject::indexOfMethod(const char *signature) const {
     PROFILE_FUNCTION();
-    const MetaObject *s = this;
-
-    while(s) {
-        for(int i = 0; i < s->m_MethodCount; ++i) {
-            if(MetaMethod(s->m_pMethods + i).signature() == signature) {
-                return i + s->methodOffset();
-            }
-        }
-        s = s->m_pSuper;
-    }
-    return -1;
+    return findMethod(signature, -1);
 }
 /*!
     Returns index of class signal by provided \a signature; otherwise returns -1.
@@ -89,18 +134,7 @@ int MetaObject::indexOfMethod(const char *signature) const {
 */
 int MetaObject::indexOfSignal(const char *signature) const {
     PROFILE_FUNCTION();
-    const MetaObject *s = this;
-
-    while(s) {
-        for(int i = 0; i < s->m_MethodCount; ++i) {
-            MetaMethod m(s->m_pMethods + i);
-            if(m.type() == MetaMethod::Signal && m.signature() == signature) {
-                return i + s->methodOffset();
-            }
-        }
-        s = s->m_pSuper;
-    }
-    return -1;
+    return findMethod(signature, MetaMethod::Signal);
 }
 /*!
     Returns index of class slot by provided \a signature; otherwise returns -1.
@@ -108,18 +142,7 @@ int MetaObject::indexOfSignal(const char *signature) const {
 */
 int MetaObject::indexOfSlot(const char *signature) const {
     PROFILE_FUNCTION();
-    const MetaObject *s = this;
-
-    while(s) {
-        for(int i = 0; i < s->m_MethodCount; ++i) {
-            MetaMethod m(s->m_pMethods + i);
-            if(m.type() == MetaMethod::Slot && m.signature() == signature) {
-                return i + s->methodOffset();
-            }
-        }
-        s = s->m_pSuper;
-    }
-    return -1;
+    return findMethod(signature, MetaMethod::Slot);
 }
 /*!
     Returns MetaMethod object by provided \a index of method.
@@ -127,7 +150,7 @@ int MetaObject::indexOfSlot(const char *signature) const {
 */
 MetaMethod MetaObject::method(int index) const {
     PROFILE_FUNCTION();
-    int i = index - methodOffset();
+    int i = index - m_MethodOffset;
     if(i < 0 && m_pSuper) {
         return m_pSuper->method(index);
     }
@@ -142,52 +165,55 @@ MetaMethod MetaObject::method(int index) const {
 */
 int MetaObject::methodCount() const {
     PROFILE_FUNCTION();
-    int count = m_MethodCount;
-    const MetaObject *s = m_pSuper;
-    while(s) {
-        count += s->m_MethodCount;
-        s = s->m_pSuper;
-    }
-    return count;
+    return m_MethodOffset + m_MethodCount;
 }
 /*!
     Returns the first index of method for current class. The offset is the sum of all methods in parent classes.
 */
 int MetaObject::methodOffset() const {
     PROFILE_FUNCTION();
-    int offset = 0;
-    const MetaObject *s = m_pSuper;
-    while(s) {
-        offset += s->m_MethodCount;
-        s = s->m_pSuper;
-    }
-    return offset;
+    return m_MethodOffset;
 }
 /*!
     Returns index of class property by provided \a name; otherwise returns -1.
     \note This method looks through class hierarchy.
+
+    Property names of the whole hierarchy are hashed once on the MetaObject construction, so the lookup doesn't go through all properties.
+
+    \sa findProperty()
 */
 int MetaObject::indexOfProperty(const char *name) const {
     PROFILE_FUNCTION();
-    const MetaObject *s = this;
-
-    while(s) {
-        for(int i = 0; i < s->m_PropCount; ++i) {
-            if(strcmp(s->m_pProperties[i].name, name) == 0) {
-                return i + s->propertyOffset();
-            }
+    uint32_t hash = nameHash(name);
+    auto it = lower_bound(m_PropertyIndex.begin(), m_PropertyIndex.end(), hash, [](const pair<uint32_t, int> &left, uint32_t right) {
+        return left.first < right;
+    });
+    for(; it != m_PropertyIndex.end() && it->first == hash; ++it) {
+        if(strcmp(property(it->second).name(), name) == 0) {
+            return it->second;
         }
-        s = s->m_pSuper;
     }
     return -1;
 }
+/*!
+    Returns MetaProperty object by provided property \a name; otherwise returns invalid MetaProperty.
+    \note This method looks through class hierarchy.
+
+    The returned MetaProperty can be stored and used to read or write the property of any object of this class without further lookups.
+
+    \sa indexOfProperty(), MetaProperty::isValid()
+*/
+MetaProperty MetaObject::findProperty(const char *name) const {
+    PROFILE_FUNCTION();
+    return property(indexOfProperty(name));
+}
 /*!
     Returns MetaProperty object by provided \a index of property.
     \note This method looks through class hierarchy.
 */
 MetaProperty MetaObject::property(int index) const {
     PROFILE_FUNCTION();
-    int i = index - propertyOffset();
+    int i = index - m_PropOffset;
     if(i < 0 && m_pSuper) {
         return m_pSuper->property(index);
     }
@@ -201,26 +227,14 @@ MetaProperty MetaObject::property(int index) const {
 */
 int MetaObject::propertyCount() const {
     PROFILE_FUNCTION();
-    int count = m_PropCount;
-    const MetaObject *s = m_pSuper;
-    while(s) {
-        count  += s->m_PropCount;
-        s = s->m_pSuper;
-    }
-    return count;
+    return m_PropOffset + m_PropCount;
 }
 /*!
     Returns the first index of property for current class. The offset is the sum of all properties in parent classes.
 */
 int MetaObject::propertyOffset() const {
     PROFILE_FUNCTION();
-    int offset = 0;
-    const MetaObject *s = m_pSuper;
-    while(s) {
-        offset += s->m_PropCount;
-        s = s->m_pSuper;
-    }
-    return offset;
+    return m_PropOffset;
 }
 /*!
     Returns index of class enumerator by provided \a name; otherwise returns -1.
@@ -266,6 +280,26 @@ int MetaObject::enumeratorOffset() const {
     return 0;
 }
 
+/*!
+    \internal
+    Returns index of class method by provided \a signature and method \a type; otherwise returns -1.
+    In case of \a type is negative the method of any type will be returned.
+    Signatures are hashed once on the MetaObject construction, so this method doesn't allocate any memory.
+*/
+int MetaObject::findMethod(const char *signature, int type) const {
+    uint32_t hash = nameHash(signature);
+    const MetaObject *s = this;
+
+    while(s) {
+        for(int i = 0; i < s->m_MethodCount; ++i) {
+            if(s->m_MethodHashes[i] == hash && (type < 0 || s->m_pMethods[i].type == type) && s->m_Signatures[i] == signature) {
+                return i + s->m_MethodOffset;
+            }
+        }
+        s = s->m_pSuper;
+    }
+    return -1;
+}
 /*!
     Checks the abillity to cast the current object to \a type.
     \note This method tries to go through inheritance to find a common parent class.
@@ -284,3 +318,57 @@ bool MetaObject::canCastTo(const char *type) const {
     }
     return false;
 }
+/*!
+    Checks the abillity to cast the current object to type with \a id.
+    This is the fast version of canCastTo() which compares compact type identifiers instead of the class names.
+
+    Returns true if object can be cast to the type; otherwise returns false.
+
+    \sa typeId()
+*/
+bool MetaObject::canCastTo(uint32_t id) const {
+    PROFILE_FUNCTION();
+    for(auto it : m_Hierarchy) {
+        if(it == id) {
+            return true;
+        }
+    }
+    return false;
+}
+/*!
+    Returns the compact identifier of the object type.
+    Identifiers are assigned sequentially at runtime starting from 1, types with the same name share the same identifier.
+*/
+uint32_t MetaObject::typeId() const {
+    PROFILE_FUNCTION();
+    return m_Hierarchy.front();
+}
+/*!
+    Returns the compact identifier of the type with \a name or 0 if no MetaObject with this name was created yet.
+    Identifiers of the registered types never change, so they are cached per thread and the repeated lookups don't lock the registry.
+
+    \sa typeId()
+*/
+uint32_t MetaObject::typeId(const char *name) {
+    PROFILE_FUNCTION();
+    static thread_local TypeIdMap cache;
+    auto it = cache.find(name);
+    if(it != cache.end()) {
+        return it->second;
+    }
+
+    uint32_t result = 0;
+    {
+        lock_guard<mutex> locker(typeIdMutex());
+        TypeIdMap &ids = typeIds();
+        auto id = ids.find(name);
+        if(id != ids.end()) {
+            result = id->second;
+        }
+    }
+    // Unknown types aren't cached, they can be registered later
+    if(result != 0) {
+        cache[name] = result;
+    }
+    return result;
+}
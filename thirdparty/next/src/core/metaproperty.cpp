@@ -23,6 +23,11 @@
 
     Callback which contain address to setter method of property.
 */
+/*!
+    \typedef MetaProperty::CopyMem
+
+    Callback which copies property value from one object to another using getter and setter methods directly.
+*/
 /*!
     \fn template<typename T> void MetaProperty::write(void *object, const T &value) const
 
@@ -79,6 +84,29 @@ void MetaProperty::write(void *object, const Variant &value) const {
         m_pTable->writeproperty(object, *this, value);
     }
 }
+/*!
+    Returns true if the property value can be copied between objects directly without Variant conversion; otherwise returns false.
+    Properties of trivially copyable non pointer types declared with A_PROPERTY() are trivial.
+*/
+bool MetaProperty::isTrivial() const {
+    PROFILE_FUNCTION();
+    return (m_pTable->copier != nullptr);
+}
+/*!
+    Copies the property value from the \a source object to the \a destination object.
+    Both objects must have the type which declares this property.
+    Trivial properties are copied directly through the getter and setter, all others are copied through the Variant.
+
+    \sa isTrivial()
+*/
+void MetaProperty::copy(const void *source, void *destination) const {
+    PROFILE_FUNCTION();
+    if(m_pTable->copier) {
+        m_pTable->copier(source, destination);
+    } else {
+        write(destination, read(source));
+    }
+}
 /*!
     Returns property information table.
 */
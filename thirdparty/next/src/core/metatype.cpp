@@ -99,6 +99,28 @@ bool toString(void *to, const void *from, const uint32_t fromType) {
     return result;
 }
 
+bool toByteArray(void *to, const void *from, const uint32_t fromType) {
+    PROFILE_FUNCTION();
+    bool result = true;
+    ByteArray *r = static_cast<ByteArray *>(to);
+    switch(fromType) {
+        case MetaType::BYTEBUFFER: { *r = static_cast<const ByteBuffer *>(from)->toByteArray(); } break;
+        default:      { result    = false; } break;
+    }
+    return result;
+}
+
+bool toByteBuffer(void *to, const void *from, const uint32_t fromType) {
+    PROFILE_FUNCTION();
+    bool result = true;
+    ByteBuffer *r = static_cast<ByteBuffer *>(to);
+    switch(fromType) {
+        case MetaType::BYTEARRAY: { *r = ByteBuffer(*static_cast<const ByteArray *>(from)); } break;
+        default:      { result    = false; } break;
+    }
+    return result;
+}
+
 bool toList(void *to, const void *from, const uint32_t fromType) {
     PROFILE_FUNCTION();
     bool result = true;
@@ -270,6 +292,7 @@ static MetaType::TypeMap s_Types = {
     {MetaType::VARIANTMAP,  DECLARE_BUILT_TYPE(VariantMap)},
     {MetaType::VARIANTLIST, DECLARE_BUILT_TYPE(VariantList)},
     {MetaType::BYTEARRAY,   DECLARE_BUILT_TYPE(ByteArray)},
+    {MetaType::BYTEBUFFER,  DECLARE_BUILT_TYPE(ByteBuffer)},
     {MetaType::VECTOR2,     DECLARE_BUILT_TYPE(Vector2)},
     {MetaType::VECTOR3,     DECLARE_BUILT_TYPE(Vector3)},
     {MetaType::VECTOR4,     DECLARE_BUILT_TYPE(Vector4)},
@@ -296,6 +319,10 @@ static ConverterMap s_Converters= {
                             {MetaType::INTEGER,     &toString},
                             {MetaType::FLOAT,       &toString}}},
 
+    {MetaType::BYTEARRAY,  {{MetaType::BYTEBUFFER,  &toByteArray}}},
+
+    {MetaType::BYTEBUFFER, {{MetaType::BYTEARRAY,   &toByteBuffer}}},
+
     {MetaType::VARIANTLIST,{{MetaType::VECTOR2,     &toList},
                             {MetaType::VECTOR3,     &toList},
                             {MetaType::VECTOR4,     &toList},
@@ -334,6 +361,7 @@ static NameMap s_Names = {
     {"map",             MetaType::VARIANTMAP},
     {"list",            MetaType::VARIANTLIST},
     {"AByteArray",      MetaType::BYTEARRAY},
+    {"ByteBuffer",      MetaType::BYTEBUFFER},
     {"Vector2",         MetaType::VECTOR2},
     {"Vector3",         MetaType::VECTOR3},
     {"Vector4",         MetaType::VECTOR4},
@@ -529,7 +557,7 @@ uint32_t MetaType::type(const char *name) {
 */
 uint32_t MetaType::type(const type_info &type) {
     PROFILE_FUNCTION();
-    for(auto it : s_Types) {
+    for(auto &it : s_Types) {
         if(it.second.index() == type_index(type) ) {
             return it.first;
         }
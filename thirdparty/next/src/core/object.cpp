@@ -1,7 +1,11 @@
 #include "core/objectsystem.h"
 #include "core/uri.h"
+#include "core/objectpool.h"
 
 #include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <unordered_map>
 
 /*!
     \module Core
@@ -46,8 +50,13 @@ public:
         m_pParent(nullptr),
         m_pCurrentSender(nullptr),
         m_pSystem(nullptr),
+        m_pEvents(nullptr),
         m_UUID(0),
-        m_Cloned(0) {
+        m_Cloned(0),
+        m_Pending(false),
+        m_pNextPending(nullptr),
+        m_pIndexNext{nullptr, nullptr},
+        m_pIndexPrev{nullptr, nullptr} {
 
     }
 
@@ -61,6 +70,204 @@ public:
         return false;
     }
 
+    void addReceiver(const Object::Link &link) {
+        m_lRecievers.push_back(link);
+        m_Signals[link.signal].push_back(&m_lRecievers.back());
+    }
+
+    Object::LinkList::iterator removeReceiver(Object::LinkList::iterator it) {
+        auto signal = m_Signals.find(it->signal);
+        if(signal != m_Signals.end()) {
+            // The vector is kept even if empty, it can be iterated by emitSignal() at this moment
+            vector<Object::Link *> &links = signal->second;
+            links.erase(remove(links.begin(), links.end(), &(*it)), links.end());
+        }
+        return m_lRecievers.erase(it);
+    }
+
+    void pushEvent(Event *event) {
+        Event *head = m_pEvents.load(memory_order_relaxed);
+        do {
+            event->m_pNext = head;
+        } while(!m_pEvents.compare_exchange_weak(head, event, memory_order_release, memory_order_relaxed));
+    }
+
+    Event *takeEvents() {
+        // Events are stored in reverse order of posting
+        Event *event = m_pEvents.exchange(nullptr, memory_order_acquire);
+        Event *result = nullptr;
+        while(event) {
+            Event *next = event->m_pNext;
+            event->m_pNext = result;
+            result = event;
+            event = next;
+        }
+        return result;
+    }
+
+    static Event *nextEvent(Event *event) {
+        return event->m_pNext;
+    }
+
+    static void deleteEvents(Event *event) {
+        while(event) {
+            Event *next = event->m_pNext;
+            delete event;
+            event = next;
+        }
+    }
+
+    enum IndexKey {
+        UUID   = 0,
+        Cloned
+    };
+
+    typedef unordered_map<uint32_t, Object *> IndexMap;
+
+    struct Index {
+        mutex m_Mutex;
+        IndexMap m_Heads[2];
+    };
+
+    static Index &index() {
+        // Never destroyed, objects can outlive the static storage
+        static Index *index = new Index;
+        return *index;
+    }
+
+    static uint32_t indexId(const Object *object, int key) {
+        return (key == UUID) ? object->p_ptr->m_UUID : object->p_ptr->m_Cloned;
+    }
+    // The newest object is linked to the head, so recently created objects are found first
+    static void link(Index &index, Object *object, int key) {
+        uint32_t id = indexId(object, key);
+        if(id != 0) {
+            ObjectPrivate *d = object->p_ptr;
+            Object *&head = index.m_Heads[key][id];
+            d->m_pIndexPrev[key] = nullptr;
+            d->m_pIndexNext[key] = head;
+            if(head) {
+                head->p_ptr->m_pIndexPrev[key] = object;
+            }
+            head = object;
+        }
+    }
+
+    static void unlink(Index &index, Object *object, int key) {
+        uint32_t id = indexId(object, key);
+        if(id != 0) {
+            ObjectPrivate *d = object->p_ptr;
+            Object *next = d->m_pIndexNext[key];
+            Object *prev = d->m_pIndexPrev[key];
+            if(next) {
+                next->p_ptr->m_pIndexPrev[key] = prev;
+            }
+            if(prev) {
+                prev->p_ptr->m_pIndexNext[key] = next;
+            } else {
+                auto it = index.m_Heads[key].find(id);
+                if(it != index.m_Heads[key].end() && it->second == object) {
+                    if(next) {
+                        it->second = next;
+                    } else {
+                        index.m_Heads[key].erase(it);
+                    }
+                }
+            }
+            d->m_pIndexNext[key] = nullptr;
+            d->m_pIndexPrev[key] = nullptr;
+        }
+    }
+
+    static void setIndexId(Object *object, int key, uint32_t id) {
+        Index &i = index();
+        lock_guard<mutex> locker(i.m_Mutex);
+        unlink(i, object, key);
+        if(key == UUID) {
+            object->p_ptr->m_UUID = id;
+        } else {
+            object->p_ptr->m_Cloned = id;
+        }
+        link(i, object, key);
+    }
+
+    static Object::ObjectList cloneObjects(Object *object, uint32_t count, Object *parent) {
+        PROFILE_FUNCTION();
+        Object::ObjectList list;
+        enumObjects(object, list);
+
+        vector<Object *> objects(list.begin(), list.end());
+        size_t size = objects.size();
+        // Objects are enumerated in pre-order, each parent is placed before its children
+        unordered_map<const Object *, uint32_t> indices;
+        indices.reserve(size);
+        vector<int32_t> parents(size, -1);
+        for(uint32_t i = 0; i < size; i++) {
+            indices[objects[i]] = i;
+            if(i > 0) {
+                parents[i] = static_cast<int32_t>(indices[objects[i]->parent()]);
+            }
+        }
+
+        Object::ObjectList result;
+        vector<Object *> clones(size);
+        for(uint32_t c = 0; c < count; c++) {
+            for(uint32_t i = 0; i < size; i++) {
+                Object *it = objects[i];
+                // Each created object already has own unique UUID
+                Object *clone = ObjectPool::create(it->metaObject());
+                clone->setClonedFrom((it->p_ptr->m_Cloned != 0) ? it->p_ptr->m_Cloned : it->p_ptr->m_UUID);
+                clone->setParent((parents[i] < 0) ? parent : clones[parents[i]]);
+                clone->setSystem(it->p_ptr->m_pSystem);
+                clone->setName(it->name());
+
+                clones[i] = clone;
+            }
+
+            for(uint32_t i = 0; i < size; i++) {
+                Object *it = objects[i];
+                Object *clone = clones[i];
+
+                const MetaObject *meta = it->metaObject();
+                const MetaObject *cloneMeta = clone->metaObject();
+                for(int p = 0; p < meta->propertyCount(); p++) {
+                    MetaProperty rp = meta->property(p);
+                    MetaProperty lp = cloneMeta->property(p);
+                    if(rp.type().flags() & MetaType::BASE_OBJECT) {
+                        Variant data = rp.read(it);
+                        Object *ro = *(reinterpret_cast<Object **>(data.data()));
+
+                        auto ri = indices.find(ro);
+                        if(ri != indices.end()) {
+                            ro = clones[ri->second];
+                        }
+
+                        lp.write(clone, Variant(data.userType(), &ro));
+                    } else if(rp.isTrivial() && rp.table() == lp.table()) {
+                        rp.copy(it, clone);
+                    } else {
+                        lp.write(clone, rp.read(it));
+                    }
+                }
+                for(auto item : it->p_ptr->m_lSenders) {
+                    MetaMethod signal = item.sender->metaObject()->method(item.signal);
+                    MetaMethod method = clone->metaObject()->method(item.method);
+                    Object::connect(item.sender, (to_string(1) + signal.signature()).c_str(),
+                                    clone, (to_string((method.type() == MetaMethod::Signal) ? 1 : 2) + method.signature()).c_str());
+                }
+                for(auto item : it->p_ptr->m_lRecievers) {
+                    MetaMethod signal = clone->metaObject()->method(item.signal);
+                    MetaMethod method = item.receiver->metaObject()->method(item.method);
+                    Object::connect(clone, (to_string(1) + signal.signature()).c_str(),
+                                    item.receiver, (to_string((method.type() == MetaMethod::Signal) ? 1 : 2) + method.signature()).c_str());
+                }
+            }
+
+            result.push_back(clones.front());
+        }
+        return result;
+    }
+
     static void enumObjects(Object *object, Object::ObjectList &list) {
         PROFILE_FUNCTION();
         list.push_back(object);
@@ -77,17 +284,26 @@ public:
     Object::LinkList m_lRecievers;
     Object::LinkList m_lSenders;
 
+    typedef unordered_map<int32_t, vector<Object::Link *>> SignalMap;
+    SignalMap m_Signals;
+
     mutex m_Mutex;
 
     Object *m_pCurrentSender;
 
-    typedef queue<Event *> EventQueue;
-    EventQueue m_EventQueue;
-
     ObjectSystem *m_pSystem;
+    Object::ObjectList::iterator m_SystemPosition;
+
+    atomic<Event *> m_pEvents;
 
     uint32_t m_UUID;
     uint32_t m_Cloned;
+
+    atomic<bool> m_Pending;
+    Object *m_pNextPending;
+
+    Object *m_pIndexNext[2];
+    Object *m_pIndexPrev[2];
 };
 
 
@@ -283,7 +499,7 @@ public:
     By default Object create without parent to assign the parent object use setParent().
 */
 Object::Object() :
-        p_ptr(new ObjectPrivate) {
+        p_ptr(createPrivate<ObjectPrivate>()) {
     PROFILE_FUNCTION();
 
     setUUID(ObjectSystem::generateUUID());
@@ -294,23 +510,28 @@ Object::~Object() {
 
     emitSignal(_SIGNAL(destroyed()));
 
-    if(p_ptr->m_pSystem) {
-        p_ptr->m_pSystem->removeObject(this);
+    {
+        ObjectPrivate::Index &index = ObjectPrivate::index();
+        lock_guard<mutex> locker(index.m_Mutex);
+        ObjectPrivate::unlink(index, this, ObjectPrivate::UUID);
+        ObjectPrivate::unlink(index, this, ObjectPrivate::Cloned);
     }
 
-    {
-        lock_guard<mutex> locker(p_ptr->m_Mutex);
-        while(!p_ptr->m_EventQueue.empty()) {
-            delete p_ptr->m_EventQueue.front();
-            p_ptr->m_EventQueue.pop();
+    if(p_ptr->m_pSystem) {
+        if(p_ptr->m_Pending.load(memory_order_acquire)) {
+            p_ptr->m_pSystem->removePending(this);
         }
+        p_ptr->m_pSystem->m_ObjectList.erase(p_ptr->m_SystemPosition);
+        p_ptr->m_pSystem->removeObject(this);
     }
 
+    ObjectPrivate::deleteEvents(p_ptr->takeEvents());
+
     for(auto it : p_ptr->m_lSenders) {
         lock_guard<mutex> locker(it.sender->p_ptr->m_Mutex);
         for(auto rcv = it.sender->p_ptr->m_lRecievers.begin(); rcv != it.sender->p_ptr->m_lRecievers.end(); ) {
             if(*rcv == it) {
-                rcv = it.sender->p_ptr->m_lRecievers.erase(rcv);
+                rcv = it.sender->p_ptr->removeReceiver(rcv);
             } else {
                 rcv++;
             }
@@ -334,6 +555,7 @@ Object::~Object() {
     {
         lock_guard<mutex> locker(p_ptr->m_Mutex);
         p_ptr->m_lRecievers.clear();
+        p_ptr->m_Signals.clear();
     }
 
     for(const auto &it : p_ptr->m_mChildren) {
@@ -349,7 +571,20 @@ Object::~Object() {
         p_ptr->m_pParent->removeChild(this);
     }
 
-    delete p_ptr;
+    destroyPrivate(p_ptr);
+}
+/*!
+    Allocates memory of \a size bytes for the new object.
+    Objects created by ObjectSystem::objectCreate() are placed in the ObjectPool of their type, the others are allocated in the heap.
+*/
+void *Object::operator new(size_t size) {
+    return ObjectPool::allocate(size);
+}
+/*!
+    Returns memory pointed by \a pointer to the ObjectPool or to the heap.
+*/
+void Object::operator delete(void *pointer) {
+    ObjectPool::free(pointer);
 }
 /*!
     Returns new instance of Object class.
@@ -392,78 +627,23 @@ const MetaObject *Object::metaObject() const {
 
     Connections will be recreated with the same objects as original.
 
-    \sa connect()
+    \sa connect(), cloneBatch()
 */
 Object *Object::clone(Object *parent) {
     PROFILE_FUNCTION();
+    return ObjectPrivate::cloneObjects(this, 1, parent).front();
+}
+/*!
+    Creates \a count clones of this object with the \a parent in one batch.
+    Returns the list of clones.
 
-    ObjectList list;
-    ObjectPrivate::enumObjects(this, list);
-
-    std::list<pair<Object *, Object *>> array;
-
-    for(auto it : list) {
-        const MetaObject *meta = it->metaObject();
-        Object *result = meta->createInstance();
-        result->p_ptr->m_UUID = ObjectSystem::generateUUID();
-
-        result->p_ptr->m_Cloned = it->p_ptr->m_Cloned;
-        if(result->p_ptr->m_Cloned == 0) {
-            result->p_ptr->m_Cloned = it->p_ptr->m_UUID;
-        }
-
-        Object *p = parent;
-        for(auto item : array) {
-            uint32_t uuid = (it->parent()->clonedFrom() != 0) ? it->parent()->clonedFrom() : it->parent()->uuid();
-            if(item.second->clonedFrom() == uuid) {
-                p = item.second;
-                break;
-            }
-        }
-        result->setParent(p);
-        result->setSystem(it->p_ptr->m_pSystem);
-        result->setName(it->name());
-
-        array.push_back(pair<Object *, Object *>(it, result));
-    }
-
-    for(auto it : array) {
-        const MetaObject *meta = it.first->metaObject();
-
-        for(int i = 0; i < meta->propertyCount(); i++) {
-            MetaProperty rp = meta->property(i);
-            MetaProperty lp = it.second->metaObject()->property(i);
-            Variant data = rp.read(it.first);
-            if(rp.type().flags() & MetaType::BASE_OBJECT) {
-                Object *ro = *(reinterpret_cast<Object **>(data.data()));
+    The hierarchy of this object is analyzed only once for all clones, which makes this method preferable to spawn many instances of the same prefab.
 
-                for(auto item : array) {
-                    if(item.first == ro) {
-                        ro = item.second;
-                        break;
-                    }
-                }
-
-                data = Variant(data.userType(), &ro);
-            }
-            lp.write(it.second, data);
-        }
-        lock_guard<mutex>(it.first->p_ptr->m_Mutex);
-        for(auto item : it.first->p_ptr->m_lSenders) {
-            MetaMethod signal = item.sender->metaObject()->method(item.signal);
-            MetaMethod method = it.second->metaObject()->method(item.method);
-            connect(item.sender, (to_string(1) + signal.signature()).c_str(),
-                    it.second, (to_string((method.type() == MetaMethod::Signal) ? 1 : 2) + method.signature()).c_str());
-        }
-        for(auto item : it.first->p_ptr->m_lRecievers) {
-            MetaMethod signal = it.second->metaObject()->method(item.signal);
-            MetaMethod method = item.receiver->metaObject()->method(item.method);
-            connect(it.second, (to_string(1) + signal.signature()).c_str(),
-                    item.receiver, (to_string((method.type() == MetaMethod::Signal) ? 1 : 2) + method.signature()).c_str());
-        }
-    }
-
-    return array.front().second;
+    \sa clone()
+*/
+Object::ObjectList Object::cloneBatch(uint32_t count, Object *parent) {
+    PROFILE_FUNCTION();
+    return ObjectPrivate::cloneObjects(this, count, parent);
 }
 /*!
     Returns the UUID of cloned object.
@@ -562,7 +742,7 @@ bool Object::connect(Object *sender, const char *signal, Object *receiver, const
             if(!sender->p_ptr->isLinkExist(link)) {
                 {
                     lock_guard<mutex> locker(sender->p_ptr->m_Mutex);
-                    sender->p_ptr->m_lRecievers.push_back(link);
+                    sender->p_ptr->addReceiver(link);
                 }
                 {
                     lock_guard<mutex> locker(receiver->p_ptr->m_Mutex);
@@ -620,7 +800,7 @@ void Object::disconnect(Object *sender, const char *signal, Object *receiver, co
                                 data.receiver->p_ptr->m_Mutex.unlock();
                             }
 
-                            snd = sender->p_ptr->m_lRecievers.erase(snd);
+                            snd = sender->p_ptr->removeReceiver(snd);
                             continue;
                         }
                     }
@@ -768,7 +948,7 @@ void Object::removeChild(Object *child) {
 /*!
     Send specific \a signal with \a args for all connected receivers.
 
-    For now it places signal directly to receivers queues.
+    Receivers from the same thread are called directly, others receive the call through their event queues.
     In case of another signal connected as method this signal will be emitted immediately.
 
     \note Receiver should be in event loop to process incoming message.
@@ -777,23 +957,42 @@ void Object::removeChild(Object *child) {
 */
 void Object::emitSignal(const char *signal, const Variant &args) {
     PROFILE_FUNCTION();
-    int32_t index = metaObject()->indexOfSignal(&signal[1]);
-    lock_guard<mutex>(p_ptr->m_Mutex);
-    for(auto &it : p_ptr->m_lRecievers) {
-        Link *link = &(it);
-        if(link->signal == index) {
-            const MetaMethod &method = link->receiver->metaObject()->method(link->method);
-            if(method.isValid()) {
-                if(method.type() == MetaMethod::Signal) {
-                    link->receiver->emitSignal(string(char(method.type() + 0x30) + method.signature()).c_str(), args);
-                } else {
-                    if(p_ptr->m_pSystem->compareTreads(link->receiver->p_ptr->m_pSystem)) { // Direct call
-                        MethodCallEvent e(link->method, link->sender, args);
-                        link->receiver->methodCallEvent(&e);
-                    } else { // Queued Connection
-                        link->receiver->postEvent(new MethodCallEvent(link->method, link->sender, args));
-                    }
-                    link = nullptr;
+    if(p_ptr->m_lRecievers.empty()) {
+        return;
+    }
+    emitSignal(metaObject()->indexOfSignal(&signal[1]), args);
+}
+/*!
+    Sends signal with \a index in MetaObject methods table and \a args to all connected receivers.
+    This is the fastest way to emit a signal, the index can be retrieved once by MetaObject::indexOfSignal() and reused.
+
+    Receivers from the same thread are called directly without memory allocations.
+
+    \sa emitSignal()
+*/
+void Object::emitSignal(int32_t index, const Variant &args) {
+    PROFILE_FUNCTION();
+    auto it = p_ptr->m_Signals.find(index);
+    if(it == p_ptr->m_Signals.end()) {
+        return;
+    }
+    // Receivers can be connected or disconnected during the call
+    vector<Link *> &links = it->second;
+    for(size_t i = 0; i < links.size(); i++) {
+        Link *link = links[i];
+        Object *receiver = link->receiver;
+        const MetaMethod &method = receiver->metaObject()->method(link->method);
+        if(method.isValid()) {
+            if(method.type() == MetaMethod::Signal) {
+                receiver->emitSignal(link->method, args);
+            } else {
+                ObjectSystem *system = p_ptr->m_pSystem;
+                ObjectSystem *target = receiver->p_ptr->m_pSystem;
+                if(system == nullptr || target == nullptr || system->compareTreads(target)) { // Direct call
+                    MethodCallEvent e(link->method, link->sender, &args);
+                    receiver->methodCallEvent(&e);
+                } else { // Queued Connection
+                    receiver->postEvent(new MethodCallEvent(link->method, link->sender, args));
                 }
             }
         }
@@ -801,42 +1000,45 @@ void Object::emitSignal(const char *signal, const Variant &args) {
 }
 /*!
     Place event to internal \a event queue to be processed in event loop.
+    The object will be visited by its ObjectSystem during the next ObjectSystem::processEvents() call.
 */
 void Object::postEvent(Event *event) {
     PROFILE_FUNCTION();
-    lock_guard<mutex> locker(p_ptr->m_Mutex);
-    p_ptr->m_EventQueue.push(event);
+    p_ptr->pushEvent(event);
+
+    ObjectSystem *system = p_ptr->m_pSystem;
+    if(system && !p_ptr->m_Pending.exchange(true, memory_order_acq_rel)) {
+        system->addPending(this);
+    }
 }
 
 void Object::processEvents() {
     PROFILE_FUNCTION();
 
-    while(!p_ptr->m_EventQueue.empty()) {
-        Event *e = nullptr;
-        {
-            lock_guard<mutex> locker(p_ptr->m_Mutex);
-            e = p_ptr->m_EventQueue.front();
-            p_ptr->m_EventQueue.pop();
-        }
-
-        switch (e->type()) {
-            case Event::MethodCall: {
-                methodCallEvent(reinterpret_cast<MethodCallEvent *>(e));
-            } break;
-            case Event::Destroy: {
-                if(p_ptr->m_pSystem) {
-                    p_ptr->m_pSystem->suspendObject(this);
+    Event *e = p_ptr->takeEvents();
+    while(e) {
+        while(e) {
+            Event *next = ObjectPrivate::nextEvent(e);
+
+            switch (e->type()) {
+                case Event::MethodCall: {
+                    methodCallEvent(reinterpret_cast<MethodCallEvent *>(e));
+                } break;
+                case Event::Destroy: {
+                    delete e;
+                    ObjectPrivate::deleteEvents(next);
+                    delete this;
+                    return;
                 }
-
-                delete e;
-                delete this;
-                return;
+                default: {
+                    event(e);
+                } break;
             }
-            default: {
-                event(e);
-            } break;
+            delete e;
+            e = next;
         }
-        delete e;
+        // Handle events which were posted during processing
+        e = p_ptr->takeEvents();
     }
 }
 /*!
@@ -911,10 +1113,9 @@ bool Object::isComponent() const {
 */
 Variant Object::property(const char *name) const {
     PROFILE_FUNCTION();
-    const MetaObject *meta = metaObject();
-    int index = meta->indexOfProperty(name);
-    if(index > -1) {
-        return meta->property(index).read(this);
+    MetaProperty property = metaObject()->findProperty(name);
+    if(property.isValid()) {
+        return property.read(this);
     }
     return Variant();
 }
@@ -929,10 +1130,9 @@ Variant Object::property(const char *name) const {
 */
 void Object::setProperty(const char *name, const Variant &value) {
     PROFILE_FUNCTION();
-    const MetaObject *meta = metaObject();
-    int index = meta->indexOfProperty(name);
-    if(index > -1) {
-        meta->property(index).write(this, value);
+    MetaProperty property = metaObject()->findProperty(name);
+    if(property.isValid()) {
+        property.write(this, value);
     }
 }
 /*!
@@ -963,22 +1163,122 @@ void Object::methodCallEvent(MethodCallEvent *event) {
     }
     p_ptr->m_pCurrentSender = nullptr;
 }
+/*!
+    \fn template<typename T, typename... Args> T *Object::createPrivate(Args &&... args)
+
+    Creates the private implementation of type T with \a args for this object.
+    In case of the object is created by the ObjectPool, the private implementation is placed in the same memory slot right after the object.
+    \note This method must be called only from the constructor. The result must be released with destroyPrivate().
+
+    \code
+        MyComponent::MyComponent() :
+                p_ptr(createPrivate<MyComponentPrivate>()) {
+        }
+
+        MyComponent::~MyComponent() {
+            destroyPrivate(p_ptr);
+        }
+    \endcode
+*/
+/*!
+    \fn template<typename T> void Object::destroyPrivate(T *pointer)
+
+    Destroys the private implementation pointed by \a pointer which was created by createPrivate().
+*/
+/*!
+    Allocates memory of \a size bytes for the private implementation of this object.
+
+    \sa createPrivate()
+*/
+void *Object::allocatePrivate(size_t size) const {
+    return ObjectPool::allocatePrivate(this, size);
+}
+/*!
+    Releases memory of private implementation pointed by \a pointer.
+
+    \sa destroyPrivate()
+*/
+void Object::freePrivate(void *pointer) {
+    ObjectPool::freePrivate(pointer);
+}
 /*!
     \internal
 */
 void Object::clearCloneRef() {
-    p_ptr->m_Cloned = 0;
+    setClonedFrom(0);
 }
 
 void Object::setUUID(uint32_t id) {
     PROFILE_FUNCTION();
-    p_ptr->m_UUID = id;
+    ObjectPrivate::setIndexId(this, ObjectPrivate::UUID, id);
+}
+
+void Object::setClonedFrom(uint32_t id) {
+    PROFILE_FUNCTION();
+    ObjectPrivate::setIndexId(this, ObjectPrivate::Cloned, id);
+}
+/*!
+    \internal
+    Looks up the global index for objects with the \a id as UUID or as clonedFrom() and appends all of them accepted by the \a filter to the \a result.
+    Objects with matching UUID are appended first, the most recently indexed objects are appended first within each group.
+*/
+void Object::findIndexed(uint32_t id, const function<bool(Object *)> &filter, ObjectList &result) {
+    PROFILE_FUNCTION();
+    if(id == 0) {
+        return;
+    }
+
+    ObjectPrivate::Index &index = ObjectPrivate::index();
+    lock_guard<mutex> locker(index.m_Mutex);
+    for(int key = ObjectPrivate::UUID; key <= ObjectPrivate::Cloned; key++) {
+        auto it = index.m_Heads[key].find(id);
+        if(it == index.m_Heads[key].end()) {
+            continue;
+        }
+        for(Object *object = it->second; object; object = object->p_ptr->m_pIndexNext[key]) {
+            if(filter(object)) {
+                result.push_back(object);
+            }
+        }
+    }
 }
 
 void Object::setSystem(ObjectSystem *system) {
     PROFILE_FUNCTION();
+    if(p_ptr->m_pSystem) {
+        p_ptr->m_pSystem->m_ObjectList.erase(p_ptr->m_SystemPosition);
+    }
     p_ptr->m_pSystem = system;
-    p_ptr->m_pSystem->addObject(this);
+    p_ptr->m_SystemPosition = p_ptr->m_pSystem->addObject(this);
+
+    bool empty = (p_ptr->m_pEvents.load(memory_order_acquire) == nullptr);
+    if(!empty && !p_ptr->m_Pending.exchange(true, memory_order_acq_rel)) {
+        system->addPending(this);
+    }
+}
+/*!
+    \internal
+    Returns the next object in the list of objects with pending events.
+*/
+Object *Object::nextPending() const {
+    return p_ptr->m_pNextPending;
+}
+/*!
+    \internal
+    Sets the \a next object in the list of objects with pending events.
+*/
+void Object::setNextPending(Object *next) {
+    p_ptr->m_pNextPending = next;
+}
+/*!
+    \internal
+    Unlinks the object from the list of objects with pending events and returns the next object in this list.
+*/
+Object *Object::takePending() {
+    Object *next = p_ptr->m_pNextPending;
+    p_ptr->m_pNextPending = nullptr;
+    p_ptr->m_Pending.store(false, memory_order_release);
+    return next;
 }
 /*!
     \internal
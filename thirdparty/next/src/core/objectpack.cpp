@@ -0,0 +1,528 @@
+#include "core/objectpack.h"
+
+#include "core/bson.h"
+
+#include "math/amath.h"
+
+#include <cstring>
+#include <map>
+#include <unordered_map>
+
+#define PACK_VERSION 1
+
+static const uint8_t gIdentifier[4] = {'N', 'P', 'A', 'K'};
+
+static uint32_t fieldSize(uint32_t type) {
+    switch(type) {
+        case MetaType::INVALID:     return 0;
+        case MetaType::BOOLEAN:
+        case MetaType::INTEGER:
+        case MetaType::FLOAT:
+        case MetaType::STRING:      return sizeof(uint32_t);
+        case MetaType::VECTOR2:     return sizeof(Vector2);
+        case MetaType::VECTOR3:     return sizeof(Vector3);
+        case MetaType::VECTOR4:     return sizeof(Vector4);
+        case MetaType::QUATERNION:  return sizeof(Quaternion);
+        case MetaType::MATRIX3:     return sizeof(Matrix3);
+        case MetaType::MATRIX4:     return sizeof(Matrix4);
+        default: break;
+    }
+    // Offset and size of BSON encoded value
+    return sizeof(uint32_t) * 2;
+}
+
+static bool isKnownType(uint32_t type) {
+    // User types are never stored, see ObjectPack::save()
+    return (type <= MetaType::BYTEBUFFER) || (type >= MetaType::VECTOR2 && type <= MetaType::RAY) || (type == MetaType::OBJECT);
+}
+
+template<typename T>
+static void append(ByteArray &data, const T *values, uint32_t count) {
+    if(count) {
+        const int8_t *ptr = reinterpret_cast<const int8_t *>(values);
+        data.insert(data.end(), ptr, ptr + sizeof(T) * count);
+    }
+}
+/*!
+    \class ObjectPack
+    \brief Cooked binary representation of serialized objects hierarchy.
+    \since Next 1.0
+    \inmodule Core
+
+    ObjectPack stores the same data as the Variant representation returned by ObjectSystem::toVariant() but in a form which is cheap to instantiate.
+    All class names, object names, property names and connection signatures are kept once in the string table.
+    Objects of the same class with the same set of properties share a schema, which describes the names, types and offsets of the property values.
+    Property values of each schema are packed in fixed size blocks, one block per object, so they are read in place without parsing.
+    Values of variable size types, like lists, maps and binary data, and the user data of objects are stored as BSON documents.
+
+    The pack is validated once when opened, after that ObjectSystem::toObject() resolves every class and property only once per schema.
+
+    Example:
+    \code
+        ByteArray data = ObjectPack::save(ObjectSystem::toVariant(object)); // Cooking the objects hierarchy
+        ....
+        ObjectPack pack(ByteBuffer(std::move(data)));
+        if(pack.isValid()) {
+            Object *result = ObjectSystem::toObject(pack);
+        }
+    \endcode
+
+    \sa ObjectSystem, Bson
+*/
+/*!
+    Constructs a pack from the cooked \a data.
+    Binary fields of the objects share the memory of \a data.
+*/
+ObjectPack::ObjectPack(const ByteBuffer &data) :
+        m_Buffer(data),
+        m_pStrings(nullptr),
+        m_pChars(nullptr),
+        m_pSchemas(nullptr),
+        m_pProperties(nullptr),
+        m_pObjects(nullptr),
+        m_pLinks(nullptr),
+        m_pBlocks(nullptr),
+        m_pBlobs(nullptr),
+        m_Valid(false) {
+
+    memset(&m_Header, 0, sizeof(Header));
+    // Tables are read in place, so they must be properly aligned
+    if(reinterpret_cast<uintptr_t>(m_Buffer.data()) % alignof(uint32_t) != 0) {
+        m_Buffer = ByteBuffer(m_Buffer.toByteArray());
+    }
+    m_Valid = open();
+}
+/*!
+    Returns true if the pack is well formed; otherwise returns false.
+*/
+bool ObjectPack::isValid() const {
+    return m_Valid;
+}
+/*!
+    Returns the number of objects in the pack.
+*/
+uint32_t ObjectPack::count() const {
+    return m_Valid ? m_Header.objects : 0;
+}
+/*!
+    Returns the Variant representation of all objects in the pack.
+    The result is the same as ObjectSystem::toVariant() produces and can be passed to ObjectSystem::toObject().
+*/
+Variant ObjectPack::toVariant() const {
+    PROFILE_FUNCTION();
+    if(!m_Valid) {
+        return Variant();
+    }
+    VariantList result;
+    for(uint32_t i = 0; i < m_Header.objects; i++) {
+        result.push_back(object(i));
+    }
+    return result;
+}
+/*!
+    Returns the cooked representation of \a objects, the list of serialized objects returned by ObjectSystem::toVariant().
+    Properties with user types are skipped because ObjectSystem::toObject() never restores them.
+*/
+ByteArray ObjectPack::save(const Variant &objects) {
+    PROFILE_FUNCTION();
+    ByteArray result;
+
+    const VariantList *list = reinterpret_cast<const VariantList *>(objects.data());
+    if(objects.type() != MetaType::VARIANTLIST || list == nullptr) {
+        return result;
+    }
+
+    vector<string> strings;
+    unordered_map<string, uint32_t> indices;
+    auto intern = [&strings, &indices](const string &value) {
+        auto it = indices.find(value);
+        if(it != indices.end()) {
+            return it->second;
+        }
+        uint32_t index = strings.size();
+        indices[value] = index;
+        strings.push_back(value);
+        return index;
+    };
+
+    vector<Schema> schemas;
+    vector<Property> properties;
+    vector<vector<uint32_t>> members;
+    map<vector<uint32_t>, uint32_t> signatures;
+
+    vector<Entry> entries;
+    vector<VariantMap> values;
+    vector<Link> links;
+    ByteArray blobs;
+
+    entries.reserve(list->size());
+    values.reserve(list->size());
+    for(auto &it : *list) {
+        VariantList o = it.toList();
+        if(o.size() < 5) {
+            continue;
+        }
+        auto i = o.begin();
+
+        Entry entry;
+        uint32_t type = intern((*i).toString());
+        i++;
+        entry.uuid = static_cast<uint32_t>((*i).toInt());
+        i++;
+        entry.parent = static_cast<uint32_t>((*i).toInt());
+        i++;
+        entry.name = intern((*i).toString());
+        i++;
+
+        // Objects with the same class and set of properties share the schema
+        VariantMap fields;
+        vector<uint32_t> signature = {type};
+        for(auto &prop : (*i).toMap()) {
+            uint32_t t = prop.second.type();
+            if(t < MetaType::USERTYPE) {
+                signature.push_back(intern(prop.first));
+                signature.push_back(t);
+                fields[prop.first] = prop.second;
+            }
+        }
+        auto s = signatures.find(signature);
+        if(s == signatures.end()) {
+            Schema schema;
+            schema.type = type;
+            schema.first = properties.size();
+            schema.count = (signature.size() - 1) / 2;
+            schema.stride = 0;
+            for(uint32_t p = 1; p < signature.size(); p += 2) {
+                Property property;
+                property.name = signature[p];
+                property.type = signature[p + 1];
+                property.offset = schema.stride;
+                schema.stride += fieldSize(property.type);
+                properties.push_back(property);
+            }
+            s = signatures.insert(make_pair(signature, schemas.size())).first;
+            schemas.push_back(schema);
+            members.push_back(vector<uint32_t>());
+        }
+        entry.schema = s->second;
+        entry.block = 0;
+        members[entry.schema].push_back(entries.size());
+        i++;
+
+        entry.first = links.size();
+        if(i != o.end()) {
+            for(auto &l : (*i).toList()) {
+                VariantList args = l.toList();
+                if(args.size() == 4) {
+                    auto f = args.begin();
+                    Link link;
+                    link.sender = static_cast<uint32_t>((*f).toInt());
+                    f++;
+                    link.signal = intern((*f).toString());
+                    f++;
+                    link.receiver = static_cast<uint32_t>((*f).toInt());
+                    f++;
+                    link.method = intern((*f).toString());
+                    links.push_back(link);
+                }
+            }
+            i++;
+        }
+        entry.count = links.size() - entry.first;
+
+        entry.data = 0;
+        entry.size = 0;
+        if(i != o.end() && !(*i).toMap().empty()) {
+            ByteArray data = Bson::save(*i);
+            entry.data = blobs.size();
+            entry.size = data.size();
+            blobs.insert(blobs.end(), data.begin(), data.end());
+        }
+
+        entries.push_back(entry);
+        values.push_back(fields);
+    }
+
+    // Property blocks of the objects are grouped by schema
+    ByteArray blocks;
+    for(uint32_t s = 0; s < schemas.size(); s++) {
+        const Schema &schema = schemas[s];
+        for(auto index : members[s]) {
+            Entry &entry = entries[index];
+            entry.block = blocks.size();
+            blocks.resize(blocks.size() + schema.stride);
+
+            auto value = values[index].begin();
+            for(uint32_t p = schema.first; p < schema.first + schema.count; p++, value++) {
+                const Property &property = properties[p];
+                int8_t *field = &blocks[entry.block + property.offset];
+                switch(property.type) {
+                    case MetaType::INVALID: break;
+                    case MetaType::BOOLEAN: {
+                        uint32_t v = value->second.toBool() ? 1 : 0;
+                        memcpy(field, &v, sizeof(v));
+                    } break;
+                    case MetaType::INTEGER: {
+                        int32_t v = value->second.toInt();
+                        memcpy(field, &v, sizeof(v));
+                    } break;
+                    case MetaType::FLOAT: {
+                        float v = value->second.toFloat();
+                        memcpy(field, &v, sizeof(v));
+                    } break;
+                    case MetaType::STRING: {
+                        uint32_t v = intern(value->second.toString());
+                        memcpy(field, &v, sizeof(v));
+                    } break;
+                    case MetaType::VECTOR2:
+                    case MetaType::VECTOR3:
+                    case MetaType::VECTOR4:
+                    case MetaType::QUATERNION:
+                    case MetaType::MATRIX3:
+                    case MetaType::MATRIX4: {
+                        memcpy(field, value->second.data(), fieldSize(property.type));
+                    } break;
+                    default: {
+                        ByteArray data = Bson::save(VariantList({value->second}));
+                        uint32_t v[2] = {static_cast<uint32_t>(blobs.size()), static_cast<uint32_t>(data.size())};
+                        memcpy(field, v, sizeof(v));
+                        blobs.insert(blobs.end(), data.begin(), data.end());
+                    } break;
+                }
+            }
+        }
+    }
+
+    vector<uint32_t> offsets;
+    offsets.reserve(strings.size());
+    ByteArray chars;
+    for(auto &it : strings) {
+        offsets.push_back(chars.size());
+        chars.insert(chars.end(), it.c_str(), it.c_str() + it.size() + 1);
+    }
+    chars.resize((chars.size() + sizeof(uint32_t) - 1) & ~(sizeof(uint32_t) - 1), 0);
+
+    Header header;
+    memcpy(header.identifier, gIdentifier, sizeof(gIdentifier));
+    header.version = PACK_VERSION;
+    header.strings = offsets.size();
+    header.chars = chars.size();
+    header.schemas = schemas.size();
+    header.properties = properties.size();
+    header.objects = entries.size();
+    header.links = links.size();
+    header.blocks = blocks.size();
+    header.blobs = blobs.size();
+
+    result.reserve(sizeof(Header) + offsets.size() * sizeof(uint32_t) + chars.size() + schemas.size() * sizeof(Schema) +
+                   properties.size() * sizeof(Property) + entries.size() * sizeof(Entry) + links.size() * sizeof(Link) +
+                   blocks.size() + blobs.size());
+
+    append(result, &header, 1);
+    append(result, offsets.data(), offsets.size());
+    append(result, chars.data(), chars.size());
+    append(result, schemas.data(), schemas.size());
+    append(result, properties.data(), properties.size());
+    append(result, entries.data(), entries.size());
+    append(result, links.data(), links.size());
+    append(result, blocks.data(), blocks.size());
+    append(result, blobs.data(), blobs.size());
+
+    return result;
+}
+/*!
+    \internal
+    Reads the header, locates the tables and validates all references between them.
+*/
+bool ObjectPack::open() {
+    PROFILE_FUNCTION();
+    const int8_t *data = m_Buffer.data();
+    uint64_t size = m_Buffer.size();
+    if(data == nullptr || size < sizeof(Header)) {
+        return false;
+    }
+    memcpy(&m_Header, data, sizeof(Header));
+    if(memcmp(m_Header.identifier, gIdentifier, sizeof(gIdentifier)) != 0 || m_Header.version != PACK_VERSION) {
+        return false;
+    }
+    if(m_Header.chars % sizeof(uint32_t) != 0 || m_Header.blocks % sizeof(uint32_t) != 0) {
+        return false;
+    }
+
+    uint64_t offset = sizeof(Header);
+    m_pStrings = reinterpret_cast<const uint32_t *>(data + offset);
+    offset += uint64_t(m_Header.strings) * sizeof(uint32_t);
+    m_pChars = reinterpret_cast<const char *>(data + offset);
+    offset += m_Header.chars;
+    m_pSchemas = reinterpret_cast<const Schema *>(data + offset);
+    offset += uint64_t(m_Header.schemas) * sizeof(Schema);
+    m_pProperties = reinterpret_cast<const Property *>(data + offset);
+    offset += uint64_t(m_Header.properties) * sizeof(Property);
+    m_pObjects = reinterpret_cast<const Entry *>(data + offset);
+    offset += uint64_t(m_Header.objects) * sizeof(Entry);
+    m_pLinks = reinterpret_cast<const Link *>(data + offset);
+    offset += uint64_t(m_Header.links) * sizeof(Link);
+    m_pBlocks = data + offset;
+    offset += m_Header.blocks;
+    m_pBlobs = data + offset;
+    offset += m_Header.blobs;
+    if(offset != size) {
+        return false;
+    }
+
+    // Every string must be terminated inside the table
+    if(m_Header.strings > 0 && (m_Header.chars == 0 || m_pChars[m_Header.chars - 1] != '\0')) {
+        return false;
+    }
+    for(uint32_t i = 0; i < m_Header.strings; i++) {
+        if(m_pStrings[i] >= m_Header.chars) {
+            return false;
+        }
+    }
+    for(uint32_t i = 0; i < m_Header.schemas; i++) {
+        const Schema &schema = m_pSchemas[i];
+        if(schema.type >= m_Header.strings || uint64_t(schema.first) + schema.count > m_Header.properties) {
+            return false;
+        }
+        for(uint32_t p = schema.first; p < schema.first + schema.count; p++) {
+            const Property &property = m_pProperties[p];
+            if(property.name >= m_Header.strings || !isKnownType(property.type) ||
+               uint64_t(property.offset) + fieldSize(property.type) > schema.stride) {
+                return false;
+            }
+        }
+    }
+    for(uint32_t i = 0; i < m_Header.objects; i++) {
+        const Entry &entry = m_pObjects[i];
+        if(entry.schema >= m_Header.schemas || entry.name >= m_Header.strings ||
+           uint64_t(entry.block) + m_pSchemas[entry.schema].stride > m_Header.blocks ||
+           uint64_t(entry.first) + entry.count > m_Header.links ||
+           uint64_t(entry.data) + entry.size > m_Header.blobs) {
+            return false;
+        }
+    }
+    for(uint32_t i = 0; i < m_Header.links; i++) {
+        const Link &link = m_pLinks[i];
+        if(link.signal >= m_Header.strings || link.method >= m_Header.strings) {
+            return false;
+        }
+    }
+    return true;
+}
+/*!
+    \internal
+    Returns the string with \a index from the string table.
+*/
+const char *ObjectPack::text(uint32_t index) const {
+    if(index < m_Header.strings) {
+        return m_pChars + m_pStrings[index];
+    }
+    return "";
+}
+/*!
+    \internal
+    Returns the value of \a property stored in the block of \a entry.
+*/
+Variant ObjectPack::value(const Entry &entry, const Property &property) const {
+    const int8_t *field = m_pBlocks + entry.block + property.offset;
+    switch(property.type) {
+        case MetaType::INVALID: break;
+        case MetaType::BOOLEAN: {
+            uint32_t v;
+            memcpy(&v, field, sizeof(v));
+            return Variant(v != 0);
+        }
+        case MetaType::INTEGER: {
+            int32_t v;
+            memcpy(&v, field, sizeof(v));
+            return Variant(v);
+        }
+        case MetaType::FLOAT: {
+            float v;
+            memcpy(&v, field, sizeof(v));
+            return Variant(v);
+        }
+        case MetaType::STRING: {
+            uint32_t v;
+            memcpy(&v, field, sizeof(v));
+            return Variant(text(v));
+        }
+        case MetaType::VECTOR2:
+        case MetaType::VECTOR3:
+        case MetaType::VECTOR4:
+        case MetaType::QUATERNION:
+        case MetaType::MATRIX3:
+        case MetaType::MATRIX4: {
+            return Variant(property.type, field);
+        }
+        default: {
+            uint32_t v[2];
+            memcpy(v, field, sizeof(v));
+            Variant list = blob(v[0], v[1], MetaType::VARIANTLIST);
+            if(list.type() == MetaType::VARIANTLIST) {
+                const VariantList &values = *(reinterpret_cast<const VariantList *>(list.data()));
+                if(!values.empty()) {
+                    return values.front();
+                }
+            }
+        } break;
+    }
+    return Variant();
+}
+/*!
+    \internal
+    Returns the BSON document of \a size bytes located at \a offset in the blobs section with expected \a type of container.
+*/
+Variant ObjectPack::blob(uint32_t offset, uint32_t size, MetaType::Type type) const {
+    if(size == 0 || uint64_t(offset) + size > m_Header.blobs) {
+        return Variant(type);
+    }
+    uint32_t start = static_cast<uint32_t>(m_pBlobs - m_Buffer.data()) + offset;
+    return Bson::load(m_Buffer.slice(start, size), type);
+}
+/*!
+    \internal
+    Returns the user data of \a entry.
+*/
+VariantMap ObjectPack::userData(const Entry &entry) const {
+    if(entry.size == 0) {
+        return VariantMap();
+    }
+    return blob(entry.data, entry.size, MetaType::VARIANTMAP).value<VariantMap>();
+}
+/*!
+    \internal
+    Returns the Variant representation of the object with \a index in the same form as Object::saveData() produces.
+*/
+VariantList ObjectPack::object(uint32_t index) const {
+    const Entry &entry = m_pObjects[index];
+    const Schema &schema = m_pSchemas[entry.schema];
+
+    VariantList result;
+    result.push_back(text(schema.type));
+    result.push_back(static_cast<int32_t>(entry.uuid));
+    result.push_back(static_cast<int32_t>(entry.parent));
+    result.push_back(text(entry.name));
+
+    VariantMap properties;
+    for(uint32_t p = schema.first; p < schema.first + schema.count; p++) {
+        const Property &property = m_pProperties[p];
+        properties[text(property.name)] = value(entry, property);
+    }
+    result.push_back(properties);
+
+    VariantList links;
+    for(uint32_t l = entry.first; l < entry.first + entry.count; l++) {
+        const Link &link = m_pLinks[l];
+        VariantList fields;
+        fields.push_back(static_cast<int32_t>(link.sender));
+        fields.push_back(text(link.signal));
+        fields.push_back(static_cast<int32_t>(link.receiver));
+        fields.push_back(text(link.method));
+        links.push_back(fields);
+    }
+    result.push_back(links);
+    result.push_back(userData(entry));
+
+    return result;
+}
@@ -0,0 +1,303 @@
+#include "core/objectpool.h"
+
+#include "core/object.h"
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <algorithm>
+#include <new>
+
+using namespace std;
+
+#define POOL_ALIGN      16
+#define POOL_SLAB_MIN   8
+#define POOL_SLAB_SIZE  (64 * 1024)
+
+inline static size_t aligned(size_t size) {
+    return (size + POOL_ALIGN - 1) & ~static_cast<size_t>(POOL_ALIGN - 1);
+}
+
+class TypePool;
+
+struct alignas(POOL_ALIGN) SlotHeader {
+    // Points to the next free slot while the slot is in the free list
+    TypePool               *m_pPool;
+
+    uint32_t                m_Used;
+};
+
+struct alignas(POOL_ALIGN) PrivateHeader {
+    uint32_t                m_Heap;
+};
+
+struct ConstructContext {
+    TypePool               *m_pRequest;
+
+    SlotHeader             *m_pSlot;
+
+    const void             *m_pObject;
+
+    size_t                  m_Size;
+
+    size_t                  m_Missing;
+};
+
+// Trivially destructible on purpose, the context is valid only during the object construction
+static thread_local ConstructContext s_Context = {nullptr, nullptr, nullptr, 0, 0};
+
+class TypePool {
+public:
+    TypePool() :
+            m_pFree(nullptr),
+            m_ObjectSize(0),
+            m_Tail(0),
+            m_Slab(POOL_SLAB_MIN),
+            m_Measured(false) {
+
+    }
+
+    bool isMeasured() const {
+        return m_Measured.load(memory_order_acquire);
+    }
+
+    void measure(size_t object, size_t tail) {
+        unique_lock<mutex> locker(m_Mutex);
+        if(!m_Measured.load(memory_order_relaxed)) {
+            m_ObjectSize = aligned(object);
+            m_Tail = tail;
+            m_Measured.store(true, memory_order_release);
+        }
+    }
+
+    SlotHeader *allocate(size_t size) {
+        if(aligned(size) != m_ObjectSize) {
+            return nullptr;
+        }
+        unique_lock<mutex> locker(m_Mutex);
+        if(m_pFree == nullptr) {
+            grow();
+        }
+        SlotHeader *slot = m_pFree;
+        m_pFree = reinterpret_cast<SlotHeader *>(slot->m_pPool);
+        slot->m_pPool = this;
+        slot->m_Used = 0;
+        return slot;
+    }
+
+    void free(SlotHeader *slot) {
+        unique_lock<mutex> locker(m_Mutex);
+        slot->m_pPool = reinterpret_cast<TypePool *>(m_pFree);
+        m_pFree = slot;
+    }
+
+    uint8_t *tail(SlotHeader *slot) const {
+        return reinterpret_cast<uint8_t *>(slot + 1) + m_ObjectSize + slot->m_Used;
+    }
+
+    size_t tailSize() const {
+        return m_Tail;
+    }
+
+    size_t slotSize() const {
+        return sizeof(SlotHeader) + m_ObjectSize + m_Tail;
+    }
+
+protected:
+    void grow() {
+        // Slabs are never returned to the system, its slots are reused by the objects of the same type
+        size_t size = slotSize();
+        uint8_t *slab = static_cast<uint8_t *>(::operator new(size * m_Slab));
+        for(uint32_t i = m_Slab; i > 0; i--) {
+            SlotHeader *slot = reinterpret_cast<SlotHeader *>(&slab[(i - 1) * size]);
+            slot->m_pPool = reinterpret_cast<TypePool *>(m_pFree);
+            m_pFree = slot;
+        }
+        m_Slab = min(m_Slab * 2, max(static_cast<uint32_t>(POOL_SLAB_MIN), static_cast<uint32_t>(POOL_SLAB_SIZE / size)));
+    }
+
+    mutex                   m_Mutex;
+
+    SlotHeader             *m_pFree;
+
+    size_t                  m_ObjectSize;
+
+    size_t                  m_Tail;
+
+    uint32_t                m_Slab;
+
+    atomic<bool>            m_Measured;
+};
+
+class ObjectPoolPrivate {
+public:
+    static ObjectPoolPrivate *instance() {
+        // Intentionally never destroyed, objects can be deleted during static destruction
+        static ObjectPoolPrivate *pool = new ObjectPoolPrivate;
+        return pool;
+    }
+
+    TypePool *pool(const MetaObject *meta) {
+        unique_lock<mutex> locker(m_Mutex);
+        TypePool *&result = m_Pools[meta];
+        if(result == nullptr) {
+            result = new TypePool;
+        }
+        return result;
+    }
+
+    TypePool *find(const MetaObject *meta) {
+        unique_lock<mutex> locker(m_Mutex);
+        auto it = m_Pools.find(meta);
+        if(it != m_Pools.end()) {
+            return it->second;
+        }
+        return nullptr;
+    }
+
+    mutex                   m_Mutex;
+
+    unordered_map<const MetaObject *, TypePool *> m_Pools;
+};
+
+class ContextGuard {
+public:
+    explicit ContextGuard(TypePool *pool) :
+            m_Saved(s_Context) {
+        s_Context.m_pRequest = pool;
+        s_Context.m_pSlot = nullptr;
+        s_Context.m_pObject = nullptr;
+        s_Context.m_Size = 0;
+        s_Context.m_Missing = 0;
+    }
+
+    ~ContextGuard() {
+        s_Context = m_Saved;
+    }
+
+    ConstructContext        m_Saved;
+};
+
+/*!
+    \class ObjectPool
+    \brief The ObjectPool class places the objects of the same type close to each other in memory.
+    \since Next 1.0
+    \inmodule Core
+
+    Each type created with create() has own pool of slabs, objects of the same type are allocated in the subsequent slots of the slabs.
+    Private implementations which are created by Object::createPrivate() during the construction of the object are placed in the same slot right after the object.
+    So iteration over the objects of the same type touches the memory sequentially instead of random jumps over the heap.
+
+    The size of slot is measured on the first instance of type, this instance is allocated in the heap.
+    The freed slots are reused by the next objects of the same type, slabs are never returned to the system.
+
+    Objects which are created with the operator new directly are allocated in the heap as before.
+
+    \sa ObjectSystem::objectCreate()
+*/
+/*!
+    Creates a new instance of type described by \a meta object in the pool of this type.
+*/
+Object *ObjectPool::create(const MetaObject *meta) {
+    TypePool *pool = ObjectPoolPrivate::instance()->pool(meta);
+
+    ContextGuard guard(pool);
+    Object *result = meta->createInstance();
+    if(!pool->isMeasured() && s_Context.m_pObject == result) {
+        pool->measure(s_Context.m_Size, s_Context.m_Missing);
+    }
+    return result;
+}
+/*!
+    Returns the size of slot in bytes for the type described by \a meta object.
+    Returns 0 in case of no instances of this type were created with the pool yet.
+*/
+size_t ObjectPool::slotSize(const MetaObject *meta) {
+    TypePool *pool = ObjectPoolPrivate::instance()->find(meta);
+    if(pool && pool->isMeasured()) {
+        return pool->slotSize();
+    }
+    return 0;
+}
+/*!
+    \internal
+    Allocates memory of \a size bytes for the object.
+    In case of the object is requested by create(), the memory is taken from the pool of type.
+*/
+void *ObjectPool::allocate(size_t size) {
+    ConstructContext &context = s_Context;
+    TypePool *pool = context.m_pRequest;
+    // Nested objects which are created in the constructor must be allocated in the heap
+    context.m_pRequest = nullptr;
+
+    SlotHeader *slot = nullptr;
+    if(pool && pool->isMeasured()) {
+        slot = pool->allocate(size);
+    }
+    if(slot == nullptr) {
+        slot = static_cast<SlotHeader *>(::operator new(sizeof(SlotHeader) + size));
+        slot->m_pPool = nullptr;
+        slot->m_Used = 0;
+    }
+    if(pool) {
+        context.m_pSlot = slot;
+        context.m_pObject = slot + 1;
+        context.m_Size = size;
+        context.m_Missing = 0;
+    }
+    return slot + 1;
+}
+/*!
+    \internal
+    Returns memory pointed by \a pointer to the pool or to the heap.
+*/
+void ObjectPool::free(void *pointer) {
+    if(pointer == nullptr) {
+        return;
+    }
+    SlotHeader *slot = static_cast<SlotHeader *>(pointer) - 1;
+    if(slot->m_pPool) {
+        slot->m_pPool->free(slot);
+    } else {
+        ::operator delete(slot);
+    }
+}
+/*!
+    \internal
+    Allocates memory of \a size bytes for the private implementation of \a owner object.
+    The memory is taken from the slot of \a owner in case of it's under construction and the slot has enough space.
+*/
+void *ObjectPool::allocatePrivate(const Object *owner, size_t size) {
+    size_t total = sizeof(PrivateHeader) + aligned(size);
+
+    ConstructContext &context = s_Context;
+    if(owner == context.m_pObject) {
+        SlotHeader *slot = context.m_pSlot;
+        TypePool *pool = slot->m_pPool;
+        if(pool && slot->m_Used + total <= pool->tailSize()) {
+            PrivateHeader *header = reinterpret_cast<PrivateHeader *>(pool->tail(slot));
+            header->m_Heap = 0;
+            slot->m_Used += static_cast<uint32_t>(total);
+            return header + 1;
+        }
+        context.m_Missing += total;
+    }
+
+    PrivateHeader *header = static_cast<PrivateHeader *>(::operator new(total));
+    header->m_Heap = 1;
+    return header + 1;
+}
+/*!
+    \internal
+    Releases memory of private implementation pointed by \a pointer.
+    The memory placed in the slot of owner is released together with the owner.
+*/
+void ObjectPool::freePrivate(void *pointer) {
+    if(pointer == nullptr) {
+        return;
+    }
+    PrivateHeader *header = static_cast<PrivateHeader *>(pointer) - 1;
+    if(header->m_Heap) {
+        ::operator delete(header);
+    }
+}
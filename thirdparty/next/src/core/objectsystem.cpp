@@ -1,16 +1,71 @@
 #include "core/objectsystem.h"
 
 #include "core/object.h"
+#include "core/objectpool.h"
 #include "core/invalid.h"
 #include "core/uri.h"
 #include "core/bson.h"
+#include "core/objectpack.h"
 #include "core/json.h"
 
 #include "math/amath.h"
 
+#include <algorithm>
+
 static ObjectSystem::FactoryMap s_Factories;
 static ObjectSystem::GroupMap   s_Groups;
 
+static Object *findInHierarchy(uint32_t uuid, Object *root) {
+    if(root->clonedFrom() == uuid || root->uuid() == uuid) {
+        return root;
+    }
+    for(auto &it : root->getChildren()) {
+        Object *result = findInHierarchy(uuid, it);
+        if(result) {
+            return result;
+        }
+    }
+    return nullptr;
+}
+
+static void ancestors(Object *object, Object *root, vector<Object *> &result) {
+    result.clear();
+    for(Object *it = object; it; it = it->parent()) {
+        result.push_back(it);
+        if(it == root) {
+            break;
+        }
+    }
+    reverse(result.begin(), result.end());
+}
+// Returns true if the first object is visited before the second one by the depth-first walk from the root
+static bool isPreceding(Object *first, Object *second, Object *root) {
+    vector<Object *> a;
+    vector<Object *> b;
+    ancestors(first, root, a);
+    ancestors(second, root, b);
+
+    size_t i = 0;
+    while(i < a.size() && i < b.size() && a[i] == b[i]) {
+        i++;
+    }
+    if(i == a.size()) { // The first object is an ancestor of the second one
+        return true;
+    }
+    if(i == b.size() || i == 0) {
+        return false;
+    }
+    for(auto it : a[i - 1]->getChildren()) {
+        if(it == a[i]) {
+            return true;
+        }
+        if(it == b[i]) {
+            return false;
+        }
+    }
+    return false;
+}
+
 /*!
     \class ObjectSystem
     \brief The ObjectSystem responds for object management.
@@ -58,7 +113,7 @@ static ObjectSystem::GroupMap   s_Groups;
     Constructs ObjectSystem.
 */
 ObjectSystem::ObjectSystem() :
-        m_SuspendObject(nullptr) {
+        m_pPendingList(nullptr) {
     PROFILE_FUNCTION();
 }
 /*!
@@ -81,11 +136,11 @@ ObjectSystem::~ObjectSystem() {
     }
     {
         deleteAllObjects();
-        m_SuspendObject = nullptr;
     }
 }
 /*!
     Updates all related objects.
+    Only the objects which received events since the previous call will be visited.
 */
 void ObjectSystem::processEvents() {
     PROFILE_FUNCTION();
@@ -94,18 +149,29 @@ void ObjectSystem::processEvents() {
 
     Object::processEvents();
 
-    auto it = m_ObjectList.begin();
-    while(it != m_ObjectList.end()) {
-        Object *o = *it;
-        o->processEvents();
+    {
+        lock_guard<mutex> locker(m_PendingMutex);
+        Object *object = m_pPendingList.exchange(nullptr, memory_order_acquire);
+        while(object) {
+            m_PendingBatch.push_back(object);
+            object = object->takePending();
+        }
+    }
 
-        if(m_SuspendObject != nullptr) {
-            m_SuspendObject = nullptr;
-            it = m_ObjectList.erase(it);
-        } else {
-            ++it;
+    // Objects are listed in reverse order of posting, any of them can be deleted from other thread meanwhile
+    for(size_t i = m_PendingBatch.size(); i > 0; i--) {
+        Object *object = nullptr;
+        {
+            lock_guard<mutex> locker(m_PendingMutex);
+            object = m_PendingBatch[i - 1];
+        }
+        if(object) {
+            object->processEvents();
         }
     }
+
+    lock_guard<mutex> locker(m_PendingMutex);
+    m_PendingBatch.clear();
 }
 /*!
     Returns true in case of other \a system execues in the same thread with current system; otherwise returns false.
@@ -134,10 +200,11 @@ Object *ObjectSystem::objectCreate(const string &uri, const string &name, Object
 }
 /*!
     The basic method to spawn a new object based on the provided \a meta object and \a parent object.
+    The object is allocated in the ObjectPool of its type.
     Returns a pointer to spawned object.
 */
 Object *ObjectSystem::instantiateObject(const MetaObject *meta, Object *parent) {
-    Object *object = meta->createInstance();
+    Object *object = ObjectPool::create(meta);
     object->setSystem(this);
     object->setParent(parent);
     return object;
@@ -224,6 +291,88 @@ Variant ObjectSystem::toVariant(const Object *object, bool force) {
 
     return result;
 }
+/*!
+    \internal
+    Returns the already loaded object with \a parentUuid from \a array or from the loaded prefab instances; otherwise returns \a root.
+*/
+Object *ObjectSystem::findParent(const ObjectMap &array, uint32_t parentUuid, Object *root) {
+    auto pt = array.find(parentUuid);
+    if(pt != array.end()) {
+        return pt->second;
+    }
+    if(parentUuid != 0 && !array.empty()) {
+        // The parent can be a child of already loaded prefab instance
+        auto loaded = [&array](Object *object) {
+            for(Object *it = object; it; it = it->parent()) {
+                auto ot = array.find(it->uuid());
+                if(ot != array.end() && ot->second == it) {
+                    return true;
+                }
+            }
+            return false;
+        };
+        Object::ObjectList candidates;
+        Object::findIndexed(parentUuid, loaded, candidates);
+        Object *obj = nullptr;
+        if(candidates.size() == 1) {
+            obj = candidates.front();
+        } else if(candidates.size() > 1) {
+            // Keep the order of lookup when the id is ambiguous
+            for(auto &item : array) {
+                obj = findInHierarchy(parentUuid, item.second);
+                if(obj) {
+                    break;
+                }
+            }
+        }
+        if(obj) {
+            return obj;
+        }
+    }
+    return root;
+}
+
+/*!
+    \internal
+    Returns the placeholder which keeps serialized \a data of an object with unknown type.
+*/
+Object *ObjectSystem::createInvalid(const VariantList &data, const string &name, uint32_t uuid, Object *parent) {
+    // Create a dummy object to keep all fields
+    Invalid *invalid = new Invalid();
+    invalid->loadData(data);
+    Object *object = invalid;
+    if(parent) {
+        object->setSystem(parent->system());
+    }
+    object->setUUID(uuid);
+    object->setName(name);
+    object->setParent(parent);
+    return object;
+}
+
+static void writeProperty(Object *object, const MetaObject *meta, const char *name, const Variant &value) {
+    if(value.type() < MetaType::USERTYPE) {
+        MetaProperty property = meta->findProperty(name);
+        if(property.isValid()) {
+            property.write(object, value);
+        }
+    }
+}
+
+static void connectObjects(const unordered_map<uint32_t, Object *> &array, uint32_t senderUuid, const string &signal, uint32_t receiverUuid, const string &method) {
+    Object *sender = nullptr;
+    Object *receiver = nullptr;
+
+    auto s = array.find(senderUuid);
+    if(s != array.end()) {
+        sender  = (*s).second;
+    }
+    s = array.find(receiverUuid);
+    if(s != array.end()) {
+        receiver  = (*s).second;
+    }
+    Object::connect(sender, signal.c_str(), receiver, method.c_str());
+}
 /*!
     Returns object deserialized from \a variant based representation.
     The Variant representation can be loaded from BSON or JSON formats or retrieved from memory.
@@ -233,13 +382,20 @@ Object *ObjectSystem::toObject(const Variant &variant, Object *root) {
     PROFILE_FUNCTION();
     Object *result  = nullptr;
 
-    typedef unordered_map<uint32_t, Object *> ObjectMap;
     ObjectMap array;
 
+    const VariantList *list = reinterpret_cast<const VariantList *>(variant.data());
+    if(variant.type() != MetaType::VARIANTLIST || list == nullptr) {
+        return nullptr;
+    }
+    const VariantList &objects = *list;
+
     // Create all declared objects
-    VariantList objects = variant.value<VariantList>();
     for(auto &it : objects) {
-        VariantList o  = it.value<VariantList>();
+        if(it.type() != MetaType::VARIANTLIST) {
+            continue;
+        }
+        const VariantList &o  = *(reinterpret_cast<const VariantList *>(it.data()));
         if(o.size() >= 5) {
             auto i = o.begin();
             string type = (*i).toString();
@@ -247,14 +403,7 @@ Object *ObjectSystem::toObject(const Variant &variant, Object *root) {
             uint32_t uuid = static_cast<uint32_t>((*i).toInt());
             i++;
 
-            Object *parent = root;
-            for(auto item : array) {
-                Object *obj = findObject(static_cast<uint32_t>((*i).toInt()), item.second);
-                if(obj) {
-                    parent = obj;
-                    break;
-                }
-            }
+            Object *parent = findParent(array, static_cast<uint32_t>((*i).toInt()), root);
 
             i++;
             string name = (*i).toString();
@@ -263,27 +412,15 @@ Object *ObjectSystem::toObject(const Variant &variant, Object *root) {
             Object *object = objectCreate(type, name, parent);
             if(object) {
                 object->setUUID(uuid);
-                array[uuid] = object;
             } else {
-                // Create a dummy object to keep all fields
-                Invalid *invalid = new Invalid();
-                invalid->loadData(o);
-                object = invalid;
-                if(parent) {
-                    object->setSystem(parent->system());
-                }
-                object->setUUID(uuid);
-                object->setName(name);
-                object->setParent(parent);
-
-                array[uuid] = object;
+                object = createInvalid(o, name, uuid, parent);
             }
+            array[uuid] = object;
 
             i++;
             i++;
             // Load user data
-            VariantMap &user = *(reinterpret_cast<VariantMap *>((*i).data()));
-            object->loadObjectData(user);
+            object->loadObjectData(*(reinterpret_cast<const VariantMap *>((*i).data())));
 
             if(result == nullptr && object->parent() == root) {
                 result = object;
@@ -292,7 +429,10 @@ Object *ObjectSystem::toObject(const Variant &variant, Object *root) {
     }
 
     for(auto &it : objects) {
-        VariantList &o  = *(reinterpret_cast<VariantList *>(it.data()));
+        if(it.type() != MetaType::VARIANTLIST) {
+            continue;
+        }
+        const VariantList &o  = *(reinterpret_cast<const VariantList *>(it.data()));
         if(o.size() >= 5) {
             auto i = o.begin();
             i++;
@@ -310,53 +450,258 @@ Object *ObjectSystem::toObject(const Variant &variant, Object *root) {
             }
 
             // Load base properties
-            VariantMap &properties = *(reinterpret_cast<VariantMap *>((*i).data()));
+            const VariantMap &properties = *(reinterpret_cast<const VariantMap *>((*i).data()));
+            const MetaObject *meta = object->metaObject();
             for(const auto &prop : properties) {
-                Variant v  = prop.second;
-                if(v.type() < MetaType::USERTYPE) {
-                    object->setProperty(prop.first.c_str(), v);
-                }
+                writeProperty(object, meta, prop.first.c_str(), prop.second);
             }
             i++;
             // Restore connections
-            VariantList &links = *(reinterpret_cast<VariantList *>((*i).data()));
+            const VariantList &links = *(reinterpret_cast<const VariantList *>((*i).data()));
             for(const auto &link : links) {
-                VariantList &list = *(reinterpret_cast<VariantList *>(link.data()));
-                Object *sender = nullptr;
-                Object *receiver = nullptr;
+                const VariantList &list = *(reinterpret_cast<const VariantList *>(link.data()));
                 if(list.size() == 4) {
                     auto l  = list.begin();
-                    auto s  = array.find(static_cast<uint32_t>((*l).toInt()));
-                    if(s != array.end()) {
-                        sender  = (*s).second;
-                    }
+                    uint32_t sender = static_cast<uint32_t>((*l).toInt());
                     l++;
-
                     string signal = (*l).toString();
                     l++;
-
-                    s = array.find(static_cast<uint32_t>((*l).toInt()));
-                    if(s != array.end()) {
-                        receiver  = (*s).second;
-                    }
+                    uint32_t receiver = static_cast<uint32_t>((*l).toInt());
                     l++;
-
                     string method = (*l).toString();
-                    l++;
 
-                    connect(sender, signal.c_str(), receiver, method.c_str());
+                    connectObjects(array, sender, signal, receiver, method);
                 }
             }
 
             i++;
             // Load user data
-            VariantMap &user = *(reinterpret_cast<VariantMap *>((*i).data()));
-            object->loadUserData(user);
+            object->loadUserData(*(reinterpret_cast<const VariantMap *>((*i).data())));
+        }
+    }
+
+    return result;
+}
+/*!
+    Returns object deserialized directly from BSON \a document.
+    Unlike toObject(const Variant &) this function doesn't build the Variant representation of the whole document.
+    Object fields are read in place, only user data of each object is converted to VariantMap right before it's passed to the object.
+    Deserialization will try to restore objects hierarchy with \a root as parent, its properties and connections.
+*/
+Object *ObjectSystem::toObject(const BsonReader &document, Object *root) {
+    PROFILE_FUNCTION();
+    Object *result  = nullptr;
+
+    ObjectMap array;
+
+    // Create all declared objects
+    BsonReader objects(document);
+    while(objects.next()) {
+        BsonReader o(objects);
+        if(!o.enter()) {
+            continue;
+        }
+        string type;
+        string name;
+        uint32_t uuid = 0;
+        uint32_t parentUuid = 0;
+
+        uint32_t index = 0;
+        while(o.next()) {
+            switch(index) {
+                case 0: type = o.toString(); break;
+                case 1: uuid = static_cast<uint32_t>(o.toInt()); break;
+                case 2: parentUuid = static_cast<uint32_t>(o.toInt()); break;
+                case 3: name = o.toString(); break;
+                default: break;
+            }
+            index++;
+            if(index == 4) {
+                break;
+            }
+        }
+        if(index < 4) {
+            continue;
+        }
+
+        Object *parent = findParent(array, parentUuid, root);
+
+        Object *object = objectCreate(type, name, parent);
+        if(object) {
+            object->setUUID(uuid);
+        } else {
+            object = createInvalid(objects.toVariant().value<VariantList>(), name, uuid, parent);
+        }
+        array[uuid] = object;
+
+        // Skip properties and connections to load user data
+        if(o.next() && o.next() && o.next()) {
+            object->loadObjectData(o.toVariant().value<VariantMap>());
+        }
+
+        if(result == nullptr && object->parent() == root) {
+            result = object;
+        }
+    }
+    if(!objects.isValid()) {
+        return result;
+    }
+
+    objects = document;
+    while(objects.next()) {
+        BsonReader o(objects);
+        if(!o.enter()) {
+            continue;
+        }
+        if(!(o.next() && o.next())) {
+            continue;
+        }
+        uint32_t uuid = static_cast<uint32_t>(o.toInt());
+        if(!(o.next() && o.next() && o.next())) {
+            continue;
+        }
+
+        Object *object = nullptr;
+        auto ot  = array.find(uuid);
+        if(ot != array.end()) {
+            object = (*ot).second;
+        } else {
+            return nullptr;
+        }
+
+        // Load base properties
+        if(o.enter()) {
+            const MetaObject *meta = object->metaObject();
+            while(o.next()) {
+                writeProperty(object, meta, o.name(), o.toVariant());
+            }
+            o.leave();
+        }
+        // Restore connections
+        if(o.next() && o.enter()) {
+            while(o.next()) {
+                BsonReader l(o);
+                if(!l.enter()) {
+                    continue;
+                }
+                uint32_t sender = 0;
+                uint32_t receiver = 0;
+                string signal;
+                string method;
+                uint32_t index = 0;
+                while(l.next()) {
+                    switch(index) {
+                        case 0: sender = static_cast<uint32_t>(l.toInt()); break;
+                        case 1: signal = l.toString(); break;
+                        case 2: receiver = static_cast<uint32_t>(l.toInt()); break;
+                        case 3: method = l.toString(); break;
+                        default: break;
+                    }
+                    index++;
+                }
+                if(index == 4) {
+                    connectObjects(array, sender, signal, receiver, method);
+                }
+            }
+            o.leave();
+        }
+        // Load user data
+        if(o.next()) {
+            object->loadUserData(o.toVariant().value<VariantMap>());
         }
     }
 
     return result;
 }
+/*!
+    Returns object deserialized from cooked \a pack.
+    Classes and properties are resolved once per schema of the pack, property values are read in place from the packed blocks.
+    Deserialization will try to restore objects hierarchy with \a root as parent, its properties and connections.
+*/
+Object *ObjectSystem::toObject(const ObjectPack &pack, Object *root) {
+    PROFILE_FUNCTION();
+    Object *result  = nullptr;
+
+    if(!pack.isValid()) {
+        return nullptr;
+    }
+    const ObjectPack::Header &header = pack.m_Header;
+
+    // Resolve classes and properties of all schemas
+    vector<FactoryPair *> factories(header.schemas, nullptr);
+    vector<MetaProperty> properties(header.properties, MetaProperty(nullptr));
+    for(uint32_t s = 0; s < header.schemas; s++) {
+        const ObjectPack::Schema &schema = pack.m_pSchemas[s];
+        FactoryPair *pair = metaFactory(pack.text(schema.type));
+        if(pair) {
+            factories[s] = pair;
+            for(uint32_t p = schema.first; p < schema.first + schema.count; p++) {
+                const ObjectPack::Property &property = pack.m_pProperties[p];
+                if(property.type < MetaType::USERTYPE) {
+                    properties[p] = pair->first->findProperty(pack.text(property.name));
+                }
+            }
+        }
+    }
+
+    ObjectMap array;
+    array.reserve(header.objects);
+    vector<Object *> objects(header.objects, nullptr);
+    // User data is decoded from BSON once and used by both passes
+    vector<VariantMap> userData(header.objects);
+
+    // Create all declared objects
+    for(uint32_t i = 0; i < header.objects; i++) {
+        const ObjectPack::Entry &entry = pack.m_pObjects[i];
+
+        Object *parent = findParent(array, entry.parent, root);
+        string name(pack.text(entry.name));
+
+        Object *object = nullptr;
+        FactoryPair *pair = factories[entry.schema];
+        if(pair) {
+            object = pair->second->instantiateObject(pair->first, parent);
+            object->setType(pack.text(pack.m_pSchemas[entry.schema].type));
+            object->setName(name);
+            object->setUUID(entry.uuid);
+        } else {
+            object = createInvalid(pack.object(i), name, entry.uuid, parent);
+        }
+        array[entry.uuid] = object;
+        objects[i] = object;
+
+        userData[i] = pack.userData(entry);
+        object->loadObjectData(userData[i]);
+
+        if(result == nullptr && object->parent() == root) {
+            result = object;
+        }
+    }
+
+    for(uint32_t i = 0; i < header.objects; i++) {
+        const ObjectPack::Entry &entry = pack.m_pObjects[i];
+        const ObjectPack::Schema &schema = pack.m_pSchemas[entry.schema];
+        Object *object = objects[i];
+
+        // Load base properties
+        for(uint32_t p = schema.first; p < schema.first + schema.count; p++) {
+            const MetaProperty &property = properties[p];
+            if(property.isValid()) {
+                property.write(object, pack.value(entry, pack.m_pProperties[p]));
+            }
+        }
+        // Restore connections
+        for(uint32_t l = entry.first; l < entry.first + entry.count; l++) {
+            const ObjectPack::Link &link = pack.m_pLinks[l];
+            connectObjects(array, link.sender, pack.text(link.signal), link.receiver, pack.text(link.method));
+        }
+        // Load user data
+        object->loadUserData(userData[i]);
+        userData[i] = VariantMap();
+    }
+
+    return result;
+}
 /*!
     Returns the new unique ID based on random number generator.
 */
@@ -390,40 +735,88 @@ Object *ObjectSystem::findRoot(Object *object) {
 }
 /*!
     Returns object with \a uuid or which was clonned from this.
-    This algorithm recursively going down from the \a root object
+    The object is searched in the global index of objects and must be the \a root object or one of its descendants.
+    If \a root is nullptr any object with \a uuid will be returned.
+    Only the candidates located under the \a root are accepted, if there are several of them the first one in the depth-first order from the \a root is returned.
+    Objects with matching UUID take precedence over clones in case of \a root is nullptr.
     If the object doesn't exist in the hierarchy this method returns nullptr.
 */
 Object *ObjectSystem::findObject(uint32_t uuid, Object *root) {
-    if(root->clonedFrom() == uuid || root->uuid() == uuid) {
-        return root;
-    }
-    for(auto &it : root->getChildren()) {
-        Object *result = findObject(uuid, it);
-        if(result) {
-            return result;
+    PROFILE_FUNCTION();
+    auto inside = [root](Object *object) {
+        if(root == nullptr) {
+            return true;
+        }
+        for(Object *it = object; it; it = it->parent()) {
+            if(it == root) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    Object::ObjectList candidates;
+    Object::findIndexed(uuid, inside, candidates);
+
+    Object *result = nullptr;
+    for(auto it : candidates) {
+        if(result == nullptr || (root && isPreceding(it, result, root))) {
+            result = it;
         }
     }
-    return nullptr;
+    return result;
 }
 /*!
-    Adds an \a object to main pull of objects in ObjectSystem
+    Adds an \a object to main pull of objects in ObjectSystem.
+    Returns the position of the \a object in the pull, the object uses it to leave the pull in constant time.
 */
-void ObjectSystem::addObject(Object *object) {
+Object::ObjectList::iterator ObjectSystem::addObject(Object *object) {
     PROFILE_FUNCTION();
-    m_ObjectList.push_back(object);
+    return m_ObjectList.insert(m_ObjectList.end(), object);
 }
 /*!
     \internal
+    Called when the \a object is destroyed, the object has already left the pull of objects.
+    Can be called from any thread.
 */
 void ObjectSystem::removeObject(Object *object) {
     PROFILE_FUNCTION();
-    if(m_SuspendObject == nullptr) {
-        m_ObjectList.remove(object);
+    lock_guard<mutex> locker(m_PendingMutex);
+    for(auto &it : m_PendingBatch) {
+        if(it == object) {
+            it = nullptr;
+        }
     }
 }
 /*!
     \internal
+    Adds the \a object to the list of objects with pending events.
+    Can be called from any thread. Each object must be added only once until it will be processed.
 */
-void ObjectSystem::suspendObject(Object *object) {
-    m_SuspendObject = object;
+void ObjectSystem::addPending(Object *object) {
+    Object *head = m_pPendingList.load(memory_order_relaxed);
+    do {
+        object->setNextPending(head);
+    } while(!m_pPendingList.compare_exchange_weak(head, object, memory_order_release, memory_order_relaxed));
+}
+/*!
+    \internal
+    Removes the \a object from the list of objects with pending events.
+    Can be called from any thread, the list is not collected while the object is searched in it.
+*/
+void ObjectSystem::removePending(Object *object) {
+    lock_guard<mutex> locker(m_PendingMutex);
+    Object *head = object;
+    if(m_pPendingList.compare_exchange_strong(head, object->nextPending(), memory_order_acquire, memory_order_acquire)) {
+        return;
+    }
+    // The object is not a head of the list, new pending objects can be added only in front of it
+    while(head) {
+        Object *next = head->nextPending();
+        if(next == object) {
+            head->setNextPending(object->nextPending());
+            return;
+        }
+        head = next;
+    }
 }
@@ -2,106 +2,501 @@
 
 #include <thread>
 #include <condition_variable>
-#include <set>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <vector>
+#include <memory>
 
-class ThreadPoolPrivate {
+#define QUEUE_SIZE  4096
+#define SPIN_COUNT  64
+#define PADDING     64
+
+class JobPrivate {
 public:
-    ThreadPoolPrivate() :
-            m_ActiveThreads(0) {
-        PROFILE_FUNCTION();
+    JobPrivate() :
+            m_pRange(nullptr),
+            m_pParent(nullptr),
+            m_Begin(0),
+            m_End(0),
+            m_Grain(1),
+            m_Unfinished(1),
+            m_Dependencies(1),
+            m_References(1),
+            m_Completed(false) {
+        m_Lock.clear();
     }
 
-    Object *takeTask() {
-        PROFILE_FUNCTION();
-        if(!m_Tasks.empty()) {
-            Object *object = m_Tasks.front();
-            m_Tasks.pop();
-            return object;
+    void retain() {
+        m_References.fetch_add(1, memory_order_relaxed);
+    }
+
+    void release() {
+        if(m_References.fetch_sub(1, memory_order_acq_rel) == 1) {
+            delete this;
         }
-        if(m_ActiveThreads > 0) {
-            --m_ActiveThreads;
-            m_Variable.notify_one();
+    }
+
+    void lock() {
+        while(m_Lock.test_and_set(memory_order_acquire)) {
+            this_thread::yield();
+        }
+    }
+
+    void unlock() {
+        m_Lock.clear(memory_order_release);
+    }
+
+    ThreadPool::JobFunction         m_Function;
+
+    ThreadPool::RangeFunction       m_RangeFunction;
+
+    const ThreadPool::RangeFunction *m_pRange;
+
+    JobPrivate                     *m_pParent;
+
+    uint32_t                        m_Begin;
+
+    uint32_t                        m_End;
+
+    uint32_t                        m_Grain;
+
+    vector<JobPrivate *>            m_Continuations;
+
+    atomic<int32_t>                 m_Unfinished;
+
+    atomic<int32_t>                 m_Dependencies;
+
+    atomic<int32_t>                 m_References;
+
+    atomic_flag                     m_Lock;
+
+    bool                            m_Completed;
+};
+
+class WorkQueue {
+public:
+    WorkQueue() :
+            m_Top(0),
+            m_Bottom(0),
+            m_Buffer(new atomic<JobPrivate *>[QUEUE_SIZE]) {
+
+    }
+
+    bool push(JobPrivate *job) {
+        int64_t b = m_Bottom.load(memory_order_relaxed);
+        int64_t t = m_Top.load(memory_order_acquire);
+        if(b - t >= QUEUE_SIZE) {
+            return false;
+        }
+        m_Buffer[b & (QUEUE_SIZE - 1)].store(job, memory_order_release);
+        m_Bottom.store(b + 1, memory_order_release);
+        return true;
+    }
+
+    JobPrivate *pop() {
+        int64_t b = m_Bottom.load(memory_order_relaxed) - 1;
+        m_Bottom.store(b, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        int64_t t = m_Top.load(memory_order_relaxed);
+        if(t <= b) {
+            JobPrivate *job = m_Buffer[b & (QUEUE_SIZE - 1)].load(memory_order_relaxed);
+            if(t == b) {
+                if(!m_Top.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed)) {
+                    job = nullptr;
+                }
+                m_Bottom.store(b + 1, memory_order_relaxed);
+            }
+            return job;
+        }
+        m_Bottom.store(b + 1, memory_order_relaxed);
+        return nullptr;
+    }
+
+    JobPrivate *steal() {
+        int64_t t = m_Top.load(memory_order_acquire);
+        atomic_thread_fence(memory_order_seq_cst);
+        int64_t b = m_Bottom.load(memory_order_acquire);
+        if(t < b) {
+            JobPrivate *job = m_Buffer[t & (QUEUE_SIZE - 1)].load(memory_order_acquire);
+            if(m_Top.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed)) {
+                return job;
+            }
         }
         return nullptr;
     }
 
+    bool isEmpty() const {
+        return m_Bottom.load(memory_order_acquire) <= m_Top.load(memory_order_acquire);
+    }
+
+protected:
+    atomic<int64_t>                 m_Top;
+
+    char                            m_Padding[PADDING];
+
+    atomic<int64_t>                 m_Bottom;
+
+    unique_ptr<atomic<JobPrivate *>[]> m_Buffer;
+};
+
+class ThreadPoolPrivate {
+public:
     class APoolWorker {
     public:
         explicit APoolWorker    (ThreadPoolPrivate *pool);
 
-        ~APoolWorker            ();
+        void                    start                       ();
+
+        void                    stop                        ();
 
         void                    exec                        ();
 
-        void                    run                         (Object *object);
+        WorkQueue               m_Queue;
 
-        bool                    isFree                      ();
+        ThreadPoolPrivate      *m_pPool;
 
-    protected:
-        bool                    m_Enabled;
+        atomic<bool>            m_Enabled;
 
         thread                  m_Thread;
+    };
+
+public:
+    ThreadPoolPrivate() :
+            m_Epoch(0),
+            m_Injected(0),
+            m_Sleeping(0),
+            m_Active(0) {
+        PROFILE_FUNCTION();
+    }
 
-        condition_variable      m_Variable;
+    static void processEvents(Object &object) {
+        object.processEvents();
+    }
 
-        Object                 *m_pTask;
+    static uint32_t random() {
+        static thread_local uint32_t seed = hash<thread::id>()(this_thread::get_id()) | 1;
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        return seed;
+    }
 
-        ThreadPoolPrivate      *m_pPool;
-    };
+    APoolWorker *currentWorker() const;
+
+    void submit(JobPrivate *job) {
+        if(job->m_pParent == nullptr) {
+            m_Active.fetch_add(1, memory_order_relaxed);
+        }
+        schedule(job);
+    }
+
+    void schedule(JobPrivate *job) {
+        if(job->m_Dependencies.fetch_sub(1, memory_order_acq_rel) == 1) {
+            push(job);
+        }
+    }
+
+    void push(JobPrivate *job) {
+        APoolWorker *worker = currentWorker();
+        if(worker == nullptr || !worker->m_Queue.push(job)) {
+            lock_guard<mutex> locker(m_QueueMutex);
+            m_Tasks.push_back(job);
+            m_Injected.fetch_add(1, memory_order_relaxed);
+        }
+        wake();
+    }
+
+    void wake() {
+        atomic_thread_fence(memory_order_seq_cst);
+        if(m_Sleeping.load(memory_order_relaxed) > 0) {
+            lock_guard<mutex> locker(m_Mutex);
+            ++m_Epoch;
+            m_Variable.notify_one();
+        }
+    }
+
+    bool hasWork() const {
+        if(m_Injected.load(memory_order_relaxed) > 0) {
+            return true;
+        }
+        for(auto it : m_Workers) {
+            if(!it->m_Queue.isEmpty()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    JobPrivate *takeJob(APoolWorker *worker) {
+        JobPrivate *job = nullptr;
+        if(worker) {
+            job = worker->m_Queue.pop();
+        }
+        if(job == nullptr && m_Injected.load(memory_order_relaxed) > 0) {
+            lock_guard<mutex> locker(m_QueueMutex);
+            if(!m_Tasks.empty()) {
+                job = m_Tasks.front();
+                m_Tasks.pop_front();
+                m_Injected.fetch_sub(1, memory_order_relaxed);
+            }
+        }
+        if(job == nullptr) {
+            job = stealJob(worker);
+        }
+        return job;
+    }
+
+    JobPrivate *stealJob(APoolWorker *worker) {
+        uint32_t count = m_Workers.size();
+        if(count == 0) {
+            return nullptr;
+        }
+        uint32_t offset = random();
+        for(uint32_t i = 0; i < count; i++) {
+            APoolWorker *victim = m_Workers[(offset + i) % count];
+            if(victim != worker) {
+                JobPrivate *job = victim->m_Queue.steal();
+                if(job) {
+                    return job;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    bool help(APoolWorker *worker) {
+        JobPrivate *job = takeJob(worker);
+        if(job) {
+            execute(job);
+            return true;
+        }
+        return false;
+    }
+
+    void execute(JobPrivate *job) {
+        if(job->m_pRange) {
+            uint32_t begin = job->m_Begin;
+            uint32_t end = job->m_End;
+            while(end - begin > job->m_Grain) {
+                uint32_t middle = begin + (end - begin) / 2;
+
+                JobPrivate *child = new JobPrivate;
+                child->m_pRange = job->m_pRange;
+                child->m_Grain = job->m_Grain;
+                child->m_Begin = middle;
+                child->m_End = end;
+                child->m_pParent = job;
+
+                job->retain();
+                job->m_Unfinished.fetch_add(1, memory_order_relaxed);
+
+                submit(child);
+                end = middle;
+            }
+            (*job->m_pRange)(begin, end);
+        } else if(job->m_Function) {
+            job->m_Function();
+        }
+        finish(job);
+    }
+
+    void finish(JobPrivate *job) {
+        if(job->m_Unfinished.fetch_sub(1, memory_order_acq_rel) != 1) {
+            return;
+        }
+        vector<JobPrivate *> continuations;
+        job->lock();
+        job->m_Completed = true;
+        continuations.swap(job->m_Continuations);
+        job->unlock();
+
+        for(auto it : continuations) {
+            schedule(it);
+            it->release();
+        }
+
+        JobPrivate *parent = job->m_pParent;
+        if(parent) {
+            finish(parent);
+            parent->release();
+        } else if(m_Active.fetch_sub(1, memory_order_acq_rel) == 1) {
+            lock_guard<mutex> locker(m_Mutex);
+            m_DoneVariable.notify_all();
+        }
+        job->release();
+    }
+
+    void stopWorkers() {
+        for(auto it : m_Workers) {
+            it->m_Enabled = false;
+        }
+        {
+            lock_guard<mutex> locker(m_Mutex);
+            ++m_Epoch;
+            m_Variable.notify_all();
+        }
+        for(auto it : m_Workers) {
+            it->stop();
+        }
+        for(auto it : m_Workers) {
+            JobPrivate *job = it->m_Queue.pop();
+            while(job) {
+                lock_guard<mutex> locker(m_QueueMutex);
+                m_Tasks.push_back(job);
+                m_Injected.fetch_add(1, memory_order_relaxed);
+                job = it->m_Queue.pop();
+            }
+            delete it;
+        }
+        m_Workers.clear();
+    }
 
 public:
     condition_variable          m_Variable;
 
+    condition_variable          m_DoneVariable;
+
     mutex                       m_Mutex;
 
-    set<APoolWorker *>          m_Workers;
+    mutex                       m_QueueMutex;
 
-    queue<Object *>             m_Tasks;
+    vector<APoolWorker *>       m_Workers;
 
-    int32_t                     m_ActiveThreads;
+    deque<JobPrivate *>         m_Tasks;
+
+    uint32_t                    m_Epoch;
+
+    atomic<int32_t>             m_Injected;
+
+    atomic<int32_t>             m_Sleeping;
+
+    atomic<int32_t>             m_Active;
 };
 
+static thread_local ThreadPoolPrivate::APoolWorker *t_pWorker = nullptr;
+
+ThreadPoolPrivate::APoolWorker *ThreadPoolPrivate::currentWorker() const {
+    if(t_pWorker && t_pWorker->m_pPool == this) {
+        return t_pWorker;
+    }
+    return nullptr;
+}
+
 ThreadPoolPrivate::APoolWorker::APoolWorker(ThreadPoolPrivate *pool) :
-        m_Enabled(true),
-        m_pTask(nullptr),
-        m_pPool(pool) {
+        m_pPool(pool),
+        m_Enabled(true) {
+    PROFILE_FUNCTION();
+}
+
+void ThreadPoolPrivate::APoolWorker::start() {
     PROFILE_FUNCTION();
     m_Thread    = thread(&APoolWorker::exec, this);
 }
 
-ThreadPoolPrivate::APoolWorker::~APoolWorker() {
+void ThreadPoolPrivate::APoolWorker::stop() {
     PROFILE_FUNCTION();
-    m_Enabled   = false;
-    m_Variable.notify_one();
-    m_Thread.join();
+    if(m_Thread.joinable()) {
+        m_Thread.join();
+    }
 }
 
 void ThreadPoolPrivate::APoolWorker::exec() {
     PROFILE_FUNCTION();
-    while(m_Enabled) {
-        unique_lock<mutex> locker(m_pPool->m_Mutex);
-        m_Variable.wait(locker, [&]() { return (m_pTask != nullptr) || !m_Enabled; });
+    t_pWorker = this;
+
+    uint32_t idle = 0;
+    while(m_Enabled.load(memory_order_relaxed)) {
+        JobPrivate *job = m_pPool->takeJob(this);
+        if(job) {
+            m_pPool->execute(job);
+            idle = 0;
+            continue;
+        }
+        if(++idle < SPIN_COUNT) {
+            this_thread::yield();
+            continue;
+        }
+        idle = 0;
 
-        if(m_pTask) {
-            locker.unlock();
-            m_pTask->processEvents();
-            locker.lock();
+        unique_lock<mutex> locker(m_pPool->m_Mutex);
+        m_pPool->m_Sleeping.fetch_add(1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        if(!m_pPool->hasWork()) {
+            uint32_t epoch = m_pPool->m_Epoch;
+            m_pPool->m_Variable.wait(locker, [&]() { return (epoch != m_pPool->m_Epoch) || !m_Enabled; });
         }
-        m_pTask = m_pPool->takeTask();
-        m_Variable.notify_one();
+        m_pPool->m_Sleeping.fetch_sub(1, memory_order_relaxed);
     }
+
+    t_pWorker = nullptr;
 }
+/*!
+    \class Job
+    \brief The Job class is a lightweight handle to a unit of work scheduled in the ThreadPool.
+
+    \since Next 1.0
+    \inmodule Core
+
+    Job handles are reference counted and can be freely copied.
+    The work itself is owned by the ThreadPool and will be released after completion when no handles left.
+
+    \sa ThreadPool::createJob()
+*/
+/*!
+    Constructs an invalid Job handle.
+*/
+Job::Job() :
+        p_ptr(nullptr) {
 
-void ThreadPoolPrivate::APoolWorker::run(Object *object) {
-    PROFILE_FUNCTION();
-    ++m_pPool->m_ActiveThreads;
-    m_pTask = object;
-    m_Variable.notify_one();
 }
+/*!
+    \internal
+*/
+Job::Job(JobPrivate *job) :
+        p_ptr(job) {
 
-bool ThreadPoolPrivate::APoolWorker::isFree() {
-    PROFILE_FUNCTION();
-    return (m_pTask == nullptr);
+}
+/*!
+    Constructs a copy of \a job handle.
+*/
+Job::Job(const Job &job) :
+        p_ptr(job.p_ptr) {
+    if(p_ptr) {
+        p_ptr->retain();
+    }
+}
+
+Job::~Job() {
+    if(p_ptr) {
+        p_ptr->release();
+    }
+}
+/*!
+    Assigns the \a job handle to this handle.
+*/
+Job &Job::operator=(const Job &job) {
+    if(job.p_ptr) {
+        job.p_ptr->retain();
+    }
+    if(p_ptr) {
+        p_ptr->release();
+    }
+    p_ptr = job.p_ptr;
+    return *this;
+}
+/*!
+    Returns true if handle points to a job; otherwise returns false.
+*/
+bool Job::isValid() const {
+    return (p_ptr != nullptr);
+}
+/*!
+    Returns true if job and all its children were executed; otherwise returns false.
+    \note Invalid handle is always finished.
+*/
+bool Job::isFinished() const {
+    return (p_ptr == nullptr) || (p_ptr->m_Unfinished.load(memory_order_acquire) == 0);
 }
 /*!
     \class ThreadPool
@@ -109,6 +504,36 @@ bool ThreadPoolPrivate::APoolWorker::isFree() {
 
     \since Next 1.0
     \inmodule Core
+
+    Each worker thread owns a queue of jobs. Jobs spawned by worker are placed to its own queue without any locks,
+    idle workers steal the jobs from the queues of busy workers.
+    Threads which do not belong to pool are placing jobs to a shared queue.
+
+    Jobs can be organized to the trees via the parent job, a parent job is finished only after all of its children.
+    Jobs can also depend on other jobs, a dependent job will be executed only after all of its dependencies are finished.
+
+    \code
+        ThreadPool pool;
+
+        Job physics = pool.createJob([]() { ... });
+        Job animation = pool.createJob([]() { ... });
+        pool.addDependency(animation, physics);
+
+        pool.run(animation);
+        pool.run(physics);
+
+        pool.wait(animation);
+    \endcode
+*/
+/*!
+    \typedef ThreadPool::JobFunction
+
+    Callback which will be executed by the job.
+*/
+/*!
+    \typedef ThreadPool::RangeFunction
+
+    Callback which will be executed for each sub range [begin, end) in parallelFor().
 */
 ThreadPool::ThreadPool() :
         p_ptr(new ThreadPoolPrivate) {
@@ -119,25 +544,119 @@ ThreadPool::ThreadPool() :
 
 ThreadPool::~ThreadPool() {
     PROFILE_FUNCTION();
-    for(auto it : p_ptr->m_Workers) {
-        delete it;
+    p_ptr->stopWorkers();
+    for(auto it : p_ptr->m_Tasks) {
+        it->release();
     }
-    p_ptr->m_Workers.clear();
+    p_ptr->m_Tasks.clear();
+
+    delete p_ptr;
 }
 /*!
     Pushes an \a object to thread pool.
-    In case of any free worker available executes task immediately.
+    The Object::processEvents() of the \a object will be called by the first free worker.
 */
 void ThreadPool::start(Object &object) {
     PROFILE_FUNCTION();
-    unique_lock<mutex> locker(p_ptr->m_Mutex);
-    for(auto it : p_ptr->m_Workers) {
-        if(it->isFree()) {
-            it->run(&object);
-            return;
+    run(createJob([&object]() { ThreadPoolPrivate::processEvents(object); }));
+}
+/*!
+    Creates a new job to execute the \a function and returns a handle to it.
+    Job will not be executed until run() will be called.
+
+    In case of valid \a parent provided, the parent job will be finished only after this job.
+    \note The children must be created before the parent job finished (usually in the function of the parent).
+*/
+Job ThreadPool::createJob(const JobFunction &function, const Job &parent) {
+    PROFILE_FUNCTION();
+    JobPrivate *job = new JobPrivate;
+    job->m_Function = function;
+
+    JobPrivate *p = parent.p_ptr;
+    if(p) {
+        p->retain();
+        p->m_Unfinished.fetch_add(1, memory_order_relaxed);
+        job->m_pParent = p;
+    }
+    return Job(job);
+}
+/*!
+    Declares that the \a job can't be executed until the \a dependency will be finished.
+    \note This method must be called before the run() for the \a job.
+*/
+void ThreadPool::addDependency(const Job &job, const Job &dependency) {
+    PROFILE_FUNCTION();
+    JobPrivate *j = job.p_ptr;
+    JobPrivate *d = dependency.p_ptr;
+    if(j == nullptr || d == nullptr) {
+        return;
+    }
+    d->lock();
+    if(!d->m_Completed) {
+        j->retain();
+        j->m_Dependencies.fetch_add(1, memory_order_relaxed);
+        d->m_Continuations.push_back(j);
+    }
+    d->unlock();
+}
+/*!
+    Creates and runs a new job which executes the \a function right after the \a job is finished.
+    Returns a handle to the continuation.
+*/
+Job ThreadPool::continueWith(const Job &job, const JobFunction &function) {
+    PROFILE_FUNCTION();
+    Job result = createJob(function);
+    addDependency(result, job);
+    run(result);
+    return result;
+}
+/*!
+    Schedules the \a job to execution. The job will be executed as soon as all of its dependencies will be finished.
+    \note Each job must be scheduled only once.
+*/
+void ThreadPool::run(const Job &job) {
+    PROFILE_FUNCTION();
+    JobPrivate *j = job.p_ptr;
+    if(j) {
+        j->retain();
+        p_ptr->submit(j);
+    }
+}
+/*!
+    Waits for the \a job to be finished.
+    Calling thread doesn't sleep, it executes available jobs from the pool instead.
+    \note The \a job must be scheduled by run() before.
+*/
+void ThreadPool::wait(const Job &job) {
+    PROFILE_FUNCTION();
+    ThreadPoolPrivate::APoolWorker *worker = p_ptr->currentWorker();
+    uint32_t idle = 0;
+    while(!job.isFinished()) {
+        if(p_ptr->help(worker)) {
+            idle = 0;
+        } else if(++idle < SPIN_COUNT) {
+            this_thread::yield();
+        } else {
+            this_thread::sleep_for(chrono::microseconds(50));
         }
     }
-    p_ptr->m_Tasks.push(&object);
+}
+/*!
+    Runs the \a function for the range [0, \a count) splitted to sub ranges not bigger than \a grain.
+    Sub ranges are executed in parallel.
+    Returns a handle to the root job which will be finished when the whole range processed.
+*/
+Job ThreadPool::parallelFor(uint32_t count, uint32_t grain, const RangeFunction &function) {
+    PROFILE_FUNCTION();
+    JobPrivate *job = new JobPrivate;
+    job->m_RangeFunction = function;
+    job->m_pRange = &job->m_RangeFunction;
+    job->m_End = count;
+    job->m_Grain = (grain > 0) ? grain : 1;
+
+    Job result(job);
+    run(result);
+    return result;
 }
 /*!
     Returns the max number of threads allocated to work.
@@ -148,44 +667,43 @@ uint32_t ThreadPool::maxThreads() const {
 }
 /*!
     Sets the max \a number of threads allocated to work.
+    \note Must not be called while jobs are executing.
 */
 void ThreadPool::setMaxThreads(uint32_t number) {
     PROFILE_FUNCTION();
-    uint32_t current    = p_ptr->m_Workers.size();
-    if(current < number) {
-        for(uint32_t i = 0; i < number - current; i++) {
-            ThreadPoolPrivate::APoolWorker *worker = new ThreadPoolPrivate::APoolWorker(p_ptr);
-            Object *object     = p_ptr->takeTask();
-            if(object) {
-                worker->run(object);
-            }
-            p_ptr->m_Workers.insert(worker);
-        }
-    } else if(current > number) {
-        for(uint32_t i = 0; i < current - number; i++) {
-            auto it = p_ptr->m_Workers.end();
-            --it;
-            ThreadPoolPrivate::APoolWorker *worker = (*it);
-            p_ptr->m_Workers.erase(it);
-            delete worker;
-        }
+    if(p_ptr->m_Workers.size() == number) {
+        return;
+    }
+    p_ptr->stopWorkers();
+
+    for(uint32_t i = 0; i < number; i++) {
+        p_ptr->m_Workers.push_back(new ThreadPoolPrivate::APoolWorker(p_ptr));
+    }
+    for(auto it : p_ptr->m_Workers) {
+        it->start();
     }
 }
 /*!
-    Waits up to \a msecs milliseconds for all threads to exit and removes all threads from the thread pool.
-    Returns true if all threads were removed; otherwise it returns false.
-    If \a msecs is -1 (the default), the timeout is ignored (waits for the last thread to exit).
+    Waits up to \a msecs milliseconds for all scheduled jobs to be finished.
+    Returns true if all jobs were finished; otherwise it returns false.
+    If \a msecs is -1 (the default), the timeout is ignored (waits for the last job to be finished).
+    Calling thread helps to execute the jobs while waiting.
 */
 bool ThreadPool::waitForDone(int32_t msecs) {
     PROFILE_FUNCTION();
-    unique_lock<mutex> locker(p_ptr->m_Mutex);
-    if(msecs < 0) {
-        while(true) {
-            p_ptr->m_Variable.wait(locker, [&]() { return (p_ptr->m_Tasks.empty() && p_ptr->m_ActiveThreads == 0); });
-            break;
+    auto deadline = chrono::steady_clock::now() + chrono::milliseconds(msecs);
+    ThreadPoolPrivate::APoolWorker *worker = p_ptr->currentWorker();
+    while(p_ptr->m_Active.load(memory_order_acquire) > 0) {
+        if(p_ptr->help(worker)) {
+            continue;
+        }
+        if(msecs > -1 && chrono::steady_clock::now() >= deadline) {
+            return false;
         }
+        unique_lock<mutex> locker(p_ptr->m_Mutex);
+        p_ptr->m_DoneVariable.wait_for(locker, chrono::milliseconds(1), [&]() { return p_ptr->m_Active.load() == 0; });
     }
-    return (p_ptr->m_Tasks.empty() && p_ptr->m_ActiveThreads == 0);
+    return true;
 }
 /*!
     Returns the optimal thread count for the current system.
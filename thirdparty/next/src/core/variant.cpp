@@ -1,5 +1,12 @@
 #include "core/variant.h"
 
+#include <cstring>
+#include <type_traits>
+
+static_assert(sizeof(Ray) <= sizeof(Matrix4), "Ray doesn't fit the inline storage of Variant");
+static_assert(std::is_trivially_copyable<Matrix4>::value && std::is_trivially_copyable<Ray>::value,
+              "Inline Variant types must be trivially copyable");
+
 Variant::SharedPrivate::SharedPrivate(void *value) :
         ptr(value),
         ref(1) {
@@ -20,6 +27,9 @@ Variant::Data::Data() :
 
     Variant can contain values with common data types and return information about this types.
     Also Variant can convert cantained values to another data types using MetaType::convert function.
+
+    Math types (from Vector2 up to Matrix4 and Ray) are stored inside of Variant itself and never allocate memory.
+    Other types are allocated on the heap and shared between copies of Variant.
     Example:
     \code
         Variant variant; // This variant invalid for now
@@ -80,6 +90,9 @@ Variant::Variant() {
 Variant::Variant(MetaType::Type type) {
     PROFILE_FUNCTION();
     mData.type = type;
+    if(isInline(type)) {
+        MetaType::construct(type, mData.so);
+    }
 }
 /*!
     Constructs a new variant with a boolean \a value.
@@ -119,82 +132,134 @@ Variant::Variant(float value) {
 */
 Variant::Variant(const char *value) {
     PROFILE_FUNCTION();
-    *this   = fromValue<string>(value);
+    mData.type = MetaType::STRING;
+    mData.ptr = new string(value);
 }
 /*!
     Constructs a new variant with a string \a value.
 */
 Variant::Variant(const string &value) {
     PROFILE_FUNCTION();
-    *this   = fromValue<string>(value);
+    mData.type = MetaType::STRING;
+    mData.ptr = new string(value);
 }
 /*!
     Constructs a new variant with a map of variants \a value.
 */
 Variant::Variant(const VariantMap &value) {
     PROFILE_FUNCTION();
-    *this   = fromValue<VariantMap>(value);
+    mData.type = MetaType::VARIANTMAP;
+    mData.ptr = new VariantMap(value);
 }
 /*!
     Constructs a new variant with a list of variants \a value.
 */
 Variant::Variant(const VariantList &value) {
     PROFILE_FUNCTION();
-    *this   = fromValue<VariantList>(value);
+    mData.type = MetaType::VARIANTLIST;
+    mData.ptr = new VariantList(value);
 }
 /*!
     Constructs a new variant with a ByteArray \a value.
 */
 Variant::Variant(const ByteArray &value) {
     PROFILE_FUNCTION();
-    *this   = fromValue<ByteArray>(value);
+    mData.type = MetaType::BYTEARRAY;
+    mData.ptr = new ByteArray(value);
+}
+/*!
+    Constructs a new variant with a ByteBuffer \a value.
+    The variant shares the memory of \a value and doesn't copy the bytes.
+*/
+Variant::Variant(const ByteBuffer &value) {
+    PROFILE_FUNCTION();
+    mData.type = MetaType::BYTEBUFFER;
+    mData.ptr = new ByteBuffer(value);
+}
+/*!
+    Constructs a new variant and moves a string \a value into it.
+*/
+Variant::Variant(string &&value) {
+    PROFILE_FUNCTION();
+    mData.type = MetaType::STRING;
+    mData.ptr = new string(std::move(value));
+}
+/*!
+    Constructs a new variant and moves a map of variants \a value into it.
+*/
+Variant::Variant(VariantMap &&value) {
+    PROFILE_FUNCTION();
+    mData.type = MetaType::VARIANTMAP;
+    mData.ptr = new VariantMap(std::move(value));
+}
+/*!
+    Constructs a new variant and moves a list of variants \a value into it.
+*/
+Variant::Variant(VariantList &&value) {
+    PROFILE_FUNCTION();
+    mData.type = MetaType::VARIANTLIST;
+    mData.ptr = new VariantList(std::move(value));
+}
+/*!
+    Constructs a new variant and moves a ByteArray \a value into it.
+*/
+Variant::Variant(ByteArray &&value) {
+    PROFILE_FUNCTION();
+    mData.type = MetaType::BYTEARRAY;
+    mData.ptr = new ByteArray(std::move(value));
 }
 /*!
     Constructs a new variant with a Vector2 \a value.
 */
 Variant::Variant(const Vector2 &value) {
     PROFILE_FUNCTION();
-    *this   = fromValue<Vector2>(value);
+    mData.type = MetaType::VECTOR2;
+    memcpy(mData.so, &value, sizeof(Vector2));
 }
 /*!
     Constructs a new variant with a Vector3 \a value.
 */
 Variant::Variant(const Vector3 &value) {
     PROFILE_FUNCTION();
-    *this   = fromValue<Vector3>(value);
+    mData.type = MetaType::VECTOR3;
+    memcpy(mData.so, &value, sizeof(Vector3));
 }
 /*!
     Constructs a new variant with a Vector4 \a value.
 */
 Variant::Variant(const Vector4 &value) {
     PROFILE_FUNCTION();
-    *this   = fromValue<Vector4>(value);
+    mData.type = MetaType::VECTOR4;
+    memcpy(mData.so, &value, sizeof(Vector4));
 }
 /*!
     Constructs a new variant with a Quaternion \a value.
 */
 Variant::Variant(const Quaternion &value) {
     PROFILE_FUNCTION();
-    *this   = fromValue<Quaternion>(value);
+    mData.type = MetaType::QUATERNION;
+    memcpy(mData.so, &value, sizeof(Quaternion));
 }
 /*!
     Constructs a new variant with a Matrix3 \a value.
 */
 Variant::Variant(const Matrix3 &value) {
     PROFILE_FUNCTION();
-    *this   = fromValue<Matrix3>(value);
+    mData.type = MetaType::MATRIX3;
+    memcpy(mData.so, &value, sizeof(Matrix3));
 }
 /*!
     Constructs a new variant with a Matrix4 \a value.
 */
 Variant::Variant(const Matrix4 &value) {
     PROFILE_FUNCTION();
-    *this   = fromValue<Matrix4>(value);
+    mData.type = MetaType::MATRIX4;
+    memcpy(mData.so, &value, sizeof(Matrix4));
 }
 /*!
     Constructs a new variant of \a type and initialized with \a copy value.
 */
-Variant::Variant(uint32_t type, void *copy) {
+Variant::Variant(uint32_t type, const void *copy) {
     PROFILE_FUNCTION();
     mData.type = type;
 
@@ -202,10 +267,16 @@ Variant::Variant(uint32_t type, void *copy) {
         return;
     }
     switch(type) {
-        case MetaType::BOOLEAN: mData.b = *reinterpret_cast<bool *>(copy); break;
-        case MetaType::INTEGER: mData.i = *reinterpret_cast<int *>(copy); break;
-        case MetaType::FLOAT: mData.f = *reinterpret_cast<float *>(copy); break;
-        default: mData.ptr = MetaType::create(type, copy); break;
+        case MetaType::BOOLEAN: mData.b = *reinterpret_cast<const bool *>(copy); break;
+        case MetaType::INTEGER: mData.i = *reinterpret_cast<const int *>(copy); break;
+        case MetaType::FLOAT: mData.f = *reinterpret_cast<const float *>(copy); break;
+        default: {
+            if(isInline(type)) {
+                memcpy(mData.so, copy, MetaType::size(type));
+            } else {
+                mData.ptr = MetaType::create(type, copy);
+            }
+        } break;
     }
 }
 
@@ -220,24 +291,35 @@ Variant::Variant(const Variant &value) {
     PROFILE_FUNCTION();
     *this = value;
 }
+/*!
+    Constructs a variant by moving the contents of \a value.
+    The \a value becomes an invalid variant.
+*/
+Variant::Variant(Variant &&value) noexcept {
+    PROFILE_FUNCTION();
+    mData = value.mData;
+    value.mData = Data();
+}
 /*!
     Assigns the \a value of the variant to this variant.
 */
 Variant &Variant::operator=(const Variant &value) {
     PROFILE_FUNCTION();
+    if(this == &value) {
+        return *this;
+    }
     clear();
     mData.type  = value.mData.type;
     if(mData.type < MetaType::STRING) {
         mData.ptr = value.mData.ptr;
+    } else if(isInline(mData.type)) {
+        memcpy(mData.so, value.mData.so, sizeof(mData.so));
     } else {
         if(value.mData.is_shared) {
             mData = value.mData;
             ++mData.shared->ref;
         } else { // Make shared
             mData.is_shared = true;
-            if(value.mData.ptr == nullptr) {
-                mData.is_shared = true;
-            }
             if(value.mData.ptr == nullptr) {
                 value.mData.ptr = MetaType::create(mData.type, value.mData.ptr);
             }
@@ -250,6 +332,19 @@ Variant &Variant::operator=(const Variant &value) {
     }
     return *this;
 }
+/*!
+    Moves the contents of \a value to this variant.
+    The \a value becomes an invalid variant.
+*/
+Variant &Variant::operator=(Variant &&value) noexcept {
+    PROFILE_FUNCTION();
+    if(this != &value) {
+        clear();
+        mData = value.mData;
+        value.mData = Data();
+    }
+    return *this;
+}
 /*!
     Compares a this variant with variant \a right value.
     Returns true if variants are equal; otherwise returns false.
@@ -257,11 +352,12 @@ Variant &Variant::operator=(const Variant &value) {
 bool Variant::operator==(const Variant &right) const {
     PROFILE_FUNCTION();
     if(mData.type == right.mData.type) {
-        if(mData.type < MetaType::STRING) {
-            return MetaType::compare(&mData.ptr, &right.mData.ptr, mData.type);
-        } else {
-            return MetaType::compare(data(), right.data(), mData.type);
-        }
+        return MetaType::compare(pointer(), right.pointer(), mData.type);
+    }
+    // Binary payloads are equal regardless of how they are stored
+    if((mData.type == MetaType::BYTEARRAY || mData.type == MetaType::BYTEBUFFER) &&
+       (right.mData.type == MetaType::BYTEARRAY || right.mData.type == MetaType::BYTEBUFFER)) {
+        return (toByteBuffer() == right.toByteBuffer());
     }
     return false;
 }
@@ -277,16 +373,18 @@ bool Variant::operator!=(const Variant &right) const {
     Frees used resources and make this variant an invalid.
 */
 void Variant::clear() {
-    if(mData.type >= MetaType::STRING) {
+    if(mData.type >= MetaType::STRING && !isInline(mData.type)) {
         if(mData.is_shared) {
             --mData.shared->ref;
             if(mData.shared->ref == 0) {
                 MetaType::destroy(mData.type, mData.shared->ptr);
+                delete mData.shared;
             }
-        } else {
+        } else if(mData.ptr) {
             MetaType::destroy(mData.type, mData.ptr);
         }
     }
+    mData.is_shared = false;
     mData.type = 0;
     mData.ptr  = nullptr;
 }
@@ -314,13 +412,7 @@ uint32_t Variant::userType() const {
 */
 void *Variant::data() const {
     PROFILE_FUNCTION();
-    if(mData.is_shared) {
-        return mData.shared->ptr;
-    }
-    if(mData.type < MetaType::STRING) {
-        return &mData.b;
-    }
-    return mData.ptr;
+    return pointer();
 }
 /*!
     Returns true if variant value is valid; otherwise return false.
@@ -408,6 +500,20 @@ const ByteArray Variant::toByteArray() const {
     PROFILE_FUNCTION();
     return value<ByteArray>();
 }
+/*!
+    Returns variant as a ByteBuffer value if variant has a type MetaType::BYTEBUFFER.
+    Otherwise it tries to convert existing value to a ByteBuffer.
+
+    \sa value, canConvert, MetaType::convert
+*/
+const ByteBuffer Variant::toByteBuffer() const {
+    PROFILE_FUNCTION();
+    if(mData.type == MetaType::BYTEBUFFER) {
+        const void *ptr = pointer();
+        return (ptr) ? *reinterpret_cast<const ByteBuffer *>(ptr) : ByteBuffer();
+    }
+    return value<ByteBuffer>();
+}
 /*!
     Returns variant as a Vector2 value if variant has a type MetaType::VECTOR2.
     Otherwise it tries to convert existing value to a Vector2.
@@ -416,6 +522,9 @@ const ByteArray Variant::toByteArray() const {
 */
 const Vector2 Variant::toVector2() const {
     PROFILE_FUNCTION();
+    if(mData.type == MetaType::VECTOR2) {
+        return *reinterpret_cast<const Vector2 *>(mData.so);
+    }
     return value<Vector2>();
 }
 /*!
@@ -426,6 +535,9 @@ const Vector2 Variant::toVector2() const {
 */
 const Vector3 Variant::toVector3() const {
     PROFILE_FUNCTION();
+    if(mData.type == MetaType::VECTOR3) {
+        return *reinterpret_cast<const Vector3 *>(mData.so);
+    }
     return value<Vector3>();
 }
 /*!
@@ -436,6 +548,9 @@ const Vector3 Variant::toVector3() const {
 */
 const Vector4 Variant::toVector4() const {
     PROFILE_FUNCTION();
+    if(mData.type == MetaType::VECTOR4) {
+        return *reinterpret_cast<const Vector4 *>(mData.so);
+    }
     return value<Vector4>();
 }
 /*!
@@ -446,6 +561,9 @@ const Vector4 Variant::toVector4() const {
 */
 const Quaternion Variant::toQuaternion() const {
     PROFILE_FUNCTION();
+    if(mData.type == MetaType::QUATERNION) {
+        return *reinterpret_cast<const Quaternion *>(mData.so);
+    }
     return value<Quaternion>();
 }
 /*!
@@ -456,6 +574,9 @@ const Quaternion Variant::toQuaternion() const {
 */
 const Matrix3 Variant::toMatrix3() const {
     PROFILE_FUNCTION();
+    if(mData.type == MetaType::MATRIX3) {
+        return *reinterpret_cast<const Matrix3 *>(mData.so);
+    }
     return value<Matrix3>();
 }
 /*!
@@ -466,5 +587,8 @@ const Matrix3 Variant::toMatrix3() const {
 */
 const Matrix4 Variant::toMatrix4() const {
     PROFILE_FUNCTION();
+    if(mData.type == MetaType::MATRIX4) {
+        return *reinterpret_cast<const Matrix4 *>(mData.so);
+    }
     return value<Matrix4>();
 }
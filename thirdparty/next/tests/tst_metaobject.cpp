@@ -122,6 +122,16 @@ void Meta_property() {
     QCOMPARE(property.isValid(), true);
     QCOMPARE(property.type().name(), "int");
 
+    QCOMPARE(meta->indexOfProperty("unknown"), -1);
+    QCOMPARE(meta->findProperty("unknown").isValid(), false);
+
+    MetaProperty vec = meta->findProperty("vec");
+    QCOMPARE(vec.isValid(), true);
+    QCOMPARE(meta->indexOfProperty("vec"), 2);
+    vec.write(&obj, Vector2(3.0f, 4.0f));
+    QCOMPARE(obj.getVector().x, 3.0f);
+    QCOMPARE(vec.read(&obj).toVector2().y, 4.0f);
+
     SecondObject::unregisterClassFactory(&objectSystem);
 }
 
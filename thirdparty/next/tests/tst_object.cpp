@@ -19,6 +19,31 @@
 
 #include "tst_common.h"
 
+#include <thread>
+#include <atomic>
+
+class EventCounter : public TestObject {
+public:
+    EventCounter() :
+            m_Counter(0) {
+
+    }
+
+    void post() {
+        postEvent(new Event(Event::UserType));
+    }
+
+    bool event(Event *e) override {
+        if(e->type() == Event::UserType) {
+            m_Counter++;
+            return true;
+        }
+        return false;
+    }
+
+    int m_Counter;
+};
+
 class ObjectTest : public QObject {
     Q_OBJECT
 private slots:
@@ -200,6 +225,162 @@ void Clone_object() {
     delete obj1;
 }
 
+void Clone_batch() {
+    ObjectSystem objectSystem;
+    TestObject::registerClassFactory(&objectSystem);
+
+    const MetaObject *meta = TestObject::metaClass();
+    QCOMPARE(meta->property(meta->indexOfProperty("IntProperty")).isTrivial(), true);
+    QCOMPARE(meta->property(meta->indexOfProperty("vec")).isTrivial(), true);
+    QCOMPARE(meta->property(meta->indexOfProperty("slot")).isTrivial(), false);
+    QCOMPARE(meta->property(meta->indexOfProperty("resource")).isTrivial(), false);
+
+    TestObject *obj1 = ObjectSystem::objectCreate<TestObject>("MainObject");
+    TestObject *obj2 = ObjectSystem::objectCreate<TestObject>("TestComponent2", obj1);
+
+    obj1->setIntProperty(42);
+    obj1->setSlot(true);
+    obj2->setVector(Vector2(10.0, 20.0));
+
+    Object::ObjectList clones = obj1->cloneBatch(3);
+    QCOMPARE(int(clones.size()), 3);
+    for(auto it : clones) {
+        TestObject *clone = dynamic_cast<TestObject *>(it);
+        QCOMPARE((clone != nullptr && clone != obj1), true);
+        QCOMPARE(compare(*clone, *obj1), true);
+        QCOMPARE(clone->clonedFrom(), obj1->uuid());
+        QCOMPARE(clone->intProperty(), 42);
+        QCOMPARE(clone->getSlot(), true);
+
+        TestObject *child = clone->findChild<TestObject *>();
+        QCOMPARE((child != nullptr), true);
+        QCOMPARE(child->getVector(), Vector2(10.0, 20.0));
+    }
+    QCOMPARE((clones.front()->uuid() != clones.back()->uuid()), true);
+
+    for(auto it : clones) {
+        delete it;
+    }
+    delete obj1;
+}
+
+void Post_events_multithread() {
+    const int threads = 8;
+    const int events = 10000;
+
+    EventCounter receiver;
+
+    vector<thread> producers;
+    for(int i = 0; i < threads; i++) {
+        producers.push_back(thread([&receiver]() {
+            for(int e = 0; e < events; e++) {
+                receiver.post();
+            }
+        }));
+    }
+    for(auto &it : producers) {
+        it.join();
+    }
+    receiver.processEvents();
+
+    QCOMPARE(receiver.m_Counter, threads * events);
+}
+
+void Post_events_concurrent_processing() {
+    const int threads = 8;
+    const int events = 2000;
+    const int receivers = 16;
+
+    vector<EventCounter *> objects;
+    for(int i = 0; i < receivers; i++) {
+        objects.push_back(new EventCounter);
+    }
+
+    atomic<bool> done(false);
+    thread consumer([&objects, &done]() {
+        while(!done.load()) {
+            for(auto it : objects) {
+                it->processEvents();
+            }
+        }
+    });
+
+    vector<thread> producers;
+    for(int i = 0; i < threads; i++) {
+        producers.push_back(thread([&objects]() {
+            for(int e = 0; e < events; e++) {
+                for(auto it : objects) {
+                    it->post();
+                }
+            }
+        }));
+    }
+    for(auto &it : producers) {
+        it.join();
+    }
+    done = true;
+    consumer.join();
+
+    int total = 0;
+    for(auto it : objects) {
+        it->processEvents();
+        total += it->m_Counter;
+    }
+    QCOMPARE(total, threads * events * receivers);
+
+    for(auto it : objects) {
+        it->post();
+        delete it;
+    }
+}
+
+void Emit_signal_by_index() {
+    TestObject obj1;
+    TestObject obj2;
+
+    Object::connect(&obj1, _SIGNAL(signal(int)), &obj2, _SLOT(setSlot(int)));
+
+    int32_t index = obj1.metaObject()->indexOfSignal("signal(int)");
+    QCOMPARE((index > -1), true);
+
+    obj1.emitSignal(index, 1);
+    QCOMPARE(obj2.m_bSlot, 1);
+
+    Object::disconnect(&obj1, _SIGNAL(signal(int)), &obj2, _SLOT(setSlot(int)));
+    obj1.emitSignal(index, 0);
+    QCOMPARE(obj2.m_bSlot, 1);
+}
+
+void Benchmark_emit_signal_data() {
+    QTest::addColumn<int>("receivers");
+
+    QTest::newRow("0") << 0;
+    QTest::newRow("1") << 1;
+    QTest::newRow("8") << 8;
+}
+
+void Benchmark_emit_signal() {
+    QFETCH(int, receivers);
+
+    TestObject sender;
+    vector<TestObject *> objects;
+    for(int i = 0; i < receivers; i++) {
+        TestObject *receiver = new TestObject;
+        Object::connect(&sender, _SIGNAL(signal(int)), receiver, _SLOT(setSlot(int)));
+        objects.push_back(receiver);
+    }
+
+    QBENCHMARK {
+        for(int i = 0; i < 1000; i++) {
+            sender.emitSignal(_SIGNAL(signal(int)), i);
+        }
+    }
+
+    for(auto it : objects) {
+        delete it;
+    }
+}
+
 } REGISTER(ObjectTest)
 
 #include "tst_object.moc"
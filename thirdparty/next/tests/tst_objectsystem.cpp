@@ -1,9 +1,11 @@
 #include "tst_common.h"
 
 #include "objectsystem.h"
+#include "objectpool.h"
 
 #include "json.h"
 #include "bson.h"
+#include "objectpack.h"
 
 class SecondObject : public TestObject {
     A_REGISTER(SecondObject, TestObject, Test)
@@ -20,6 +22,62 @@ class TestObjectEx : public TestObject {
     A_NOPROPERTIES()
 };
 
+class EventObject : public TestObject {
+    A_REGISTER(EventObject, TestObject, Test)
+
+    A_NOMETHODS()
+    A_NOPROPERTIES()
+
+public:
+    EventObject() :
+            m_Counter(0) {
+
+    }
+
+    void post() {
+        postEvent(new Event(Event::UserType));
+    }
+
+    bool event(Event *e) override {
+        if(e->type() == Event::UserType) {
+            m_Counter++;
+            return true;
+        }
+        return false;
+    }
+
+    int m_Counter;
+};
+
+class PoolObjectPrivate {
+public:
+    PoolObjectPrivate() :
+            m_Value(1) {
+
+    }
+
+    int m_Value;
+};
+
+class PoolObject : public TestObject {
+    A_REGISTER(PoolObject, TestObject, Test)
+
+    A_NOMETHODS()
+    A_NOPROPERTIES()
+
+public:
+    PoolObject() :
+            p_ptr(createPrivate<PoolObjectPrivate>()) {
+
+    }
+
+    ~PoolObject() {
+        destroyPrivate(p_ptr);
+    }
+
+    PoolObjectPrivate *p_ptr;
+};
+
 class ObjectSystemTest : public QObject {
     Q_OBJECT
 private slots:
@@ -119,6 +177,325 @@ void Serialize_Desirialize_Object() {
     delete obj1;
 }
 
+void Desirialize_Object_From_Bson_Reader() {
+    ObjectSystem objectSystem;
+    TestObject::registerClassFactory(&objectSystem);
+
+    TestObject *obj1 = ObjectSystem::objectCreate<TestObject>("MainObject");
+    TestObject *obj2 = ObjectSystem::objectCreate<TestObject>("TestComponent2", obj1);
+    obj2->setVector(Vector2(3.0f, 4.0f));
+    obj2->setIntProperty(5);
+
+    QCOMPARE(Object::connect(obj1, _SIGNAL(signal(int)), obj2, _SLOT(setSlot(int))), true);
+
+    ByteBuffer bytes(Bson::save(ObjectSystem::toVariant(obj1)));
+    Object *result  = ObjectSystem::toObject(BsonReader(bytes));
+
+    QCOMPARE((result != nullptr), true);
+    QCOMPARE(compare(*obj1, *result), true);
+    QCOMPARE((obj1->getReceivers().size() == result->getReceivers().size()), true);
+    QCOMPARE((obj1->uuid() == result->uuid()), true);
+
+    delete result;
+    delete obj1;
+}
+
+void Desirialize_Object_From_Pack() {
+    ObjectSystem objectSystem;
+    TestObject::registerClassFactory(&objectSystem);
+
+    TestObject *obj1 = ObjectSystem::objectCreate<TestObject>("MainObject");
+    TestObject *obj2 = ObjectSystem::objectCreate<TestObject>("TestComponent2", obj1);
+    TestObject *obj3 = ObjectSystem::objectCreate<TestObject>("TestComponent3", obj2);
+    obj2->setVector(Vector2(3.0f, 4.0f));
+    obj2->setIntProperty(5);
+
+    QCOMPARE(Object::connect(obj1, _SIGNAL(signal(int)), obj2, _SLOT(setSlot(int))), true);
+    QCOMPARE(Object::connect(obj2, _SIGNAL(signal(int)), obj3, _SLOT(setSlot(int))), true);
+
+    Variant data = ObjectSystem::toVariant(obj1);
+    ObjectPack pack(ByteBuffer(ObjectPack::save(data)));
+    QCOMPARE(pack.isValid(), true);
+    QCOMPARE(pack.count(), 3U);
+    QCOMPARE(pack.toVariant(), data);
+
+    Object *result  = ObjectSystem::toObject(pack);
+
+    QCOMPARE((result != nullptr), true);
+    QCOMPARE(compare(*obj1, *result), true);
+    QCOMPARE((obj1->getReceivers().size() == result->getReceivers().size()), true);
+    QCOMPARE((obj1->uuid() == result->uuid()), true);
+
+    ByteArray broken = ObjectPack::save(data);
+    broken.resize(broken.size() - 1);
+    QCOMPARE(ObjectPack(ByteBuffer(broken)).isValid(), false);
+    QCOMPARE((ObjectSystem::toObject(ObjectPack(ByteBuffer(broken))) == nullptr), true);
+
+    // The type of the first property is located after the header, the string table and the schemas
+    broken = ObjectPack::save(data);
+    uint32_t header[10];
+    memcpy(header, broken.data(), sizeof(header));
+    uint32_t offset = sizeof(header) + header[2] * sizeof(uint32_t) + header[3] + header[4] * sizeof(uint32_t) * 4 + sizeof(uint32_t);
+    for(uint32_t type : {uint32_t(MetaType::USERTYPE), uint32_t(MetaType::USERTYPE + 1), 20U}) {
+        memcpy(&broken[offset], &type, sizeof(type));
+        QCOMPARE(ObjectPack(ByteBuffer(broken)).isValid(), false);
+    }
+
+    delete result;
+    delete obj1;
+}
+
+void Process_Pending_Events() {
+    ObjectSystem objectSystem;
+    EventObject::registerClassFactory(&objectSystem);
+
+    EventObject *obj1 = ObjectSystem::objectCreate<EventObject>();
+    EventObject *obj2 = ObjectSystem::objectCreate<EventObject>();
+    EventObject *obj3 = ObjectSystem::objectCreate<EventObject>();
+
+    obj1->post();
+    obj1->post();
+    obj3->post();
+
+    objectSystem.processEvents();
+    QCOMPARE(obj1->m_Counter, 2);
+    QCOMPARE(obj2->m_Counter, 0);
+    QCOMPARE(obj3->m_Counter, 1);
+
+    obj2->post();
+    obj3->post();
+    delete obj3;
+
+    objectSystem.processEvents();
+    QCOMPARE(obj1->m_Counter, 2);
+    QCOMPARE(obj2->m_Counter, 1);
+
+    obj1->deleteLater();
+    objectSystem.processEvents();
+
+    delete obj2;
+}
+
+void Pool_Placement() {
+    ObjectSystem objectSystem;
+    PoolObject::registerClassFactory(&objectSystem);
+
+    vector<PoolObject *> objects;
+    for(int i = 0; i < 8; i++) {
+        objects.push_back(ObjectSystem::objectCreate<PoolObject>());
+    }
+
+    size_t slot = ObjectPool::slotSize(PoolObject::metaClass());
+    QCOMPARE((slot > sizeof(PoolObject) + sizeof(PoolObjectPrivate)), true);
+
+    // The first instance is used to measure the slot and allocated in the heap
+    for(int i = 2; i < 8; i++) {
+        uint8_t *object = reinterpret_cast<uint8_t *>(objects[i]);
+        uint8_t *data = reinterpret_cast<uint8_t *>(objects[i]->p_ptr);
+        QCOMPARE((data > object && data < object + slot), true);
+        QCOMPARE(size_t(object - reinterpret_cast<uint8_t *>(objects[i - 1])), slot);
+        QCOMPARE(objects[i]->p_ptr->m_Value, 1);
+    }
+
+    PoolObject *object = objects[5];
+    delete object;
+    objects[5] = ObjectSystem::objectCreate<PoolObject>();
+    QCOMPARE(objects[5], object);
+
+    PoolObject local;
+    QCOMPARE(local.p_ptr->m_Value, 1);
+
+    for(auto it : objects) {
+        delete it;
+    }
+}
+
+void Find_Object() {
+    ObjectSystem objectSystem;
+    TestObject::registerClassFactory(&objectSystem);
+
+    TestObject *root = ObjectSystem::objectCreate<TestObject>();
+    TestObject *child = ObjectSystem::objectCreate<TestObject>("Child", root);
+    TestObject *leaf = ObjectSystem::objectCreate<TestObject>("Leaf", child);
+
+    QCOMPARE(ObjectSystem::findObject(leaf->uuid(), root), leaf);
+    QCOMPARE(ObjectSystem::findObject(leaf->uuid()), leaf);
+    QCOMPARE(ObjectSystem::findObject(root->uuid(), child), static_cast<Object *>(nullptr));
+
+    Object *clone = root->clone();
+    Object *cloneLeaf = ObjectSystem::findObject(leaf->uuid(), clone);
+    QCOMPARE((cloneLeaf != nullptr && cloneLeaf != leaf), true);
+    QCOMPARE(cloneLeaf->clonedFrom(), leaf->uuid());
+    QCOMPARE(ObjectSystem::findObject(leaf->uuid(), root), leaf);
+
+    cloneLeaf->setParent(root);
+    QCOMPARE(ObjectSystem::findObject(leaf->uuid(), clone), static_cast<Object *>(nullptr));
+
+    uint32_t uuid = ObjectSystem::generateUUID();
+    ObjectSystem::replaceUUID(child, uuid);
+    QCOMPARE(ObjectSystem::findObject(uuid, root), child);
+
+    uint32_t id = leaf->uuid();
+    delete leaf;
+    QCOMPARE(ObjectSystem::findObject(id, child), static_cast<Object *>(nullptr));
+    QCOMPARE(ObjectSystem::findObject(id, root), cloneLeaf);
+
+    delete clone;
+    delete root;
+}
+
+void Find_Object_In_Crowd() {
+    ObjectSystem objectSystem;
+    TestObject::registerClassFactory(&objectSystem);
+
+    TestObject *root = ObjectSystem::objectCreate<TestObject>();
+    TestObject *child = ObjectSystem::objectCreate<TestObject>("Child", root);
+    TestObject *leaf = ObjectSystem::objectCreate<TestObject>("Leaf", child);
+
+    // More clones than the index checked before
+    vector<Object *> clones;
+    for(int i = 0; i < 100; i++) {
+        clones.push_back(root->clone());
+    }
+    for(auto it : clones) {
+        Object *result = ObjectSystem::findObject(leaf->uuid(), it);
+        QCOMPARE((result != nullptr && result->parent() != nullptr && result->parent()->parent() == it), true);
+        QCOMPARE(result->clonedFrom(), leaf->uuid());
+    }
+    QCOMPARE(ObjectSystem::findObject(leaf->uuid(), root), leaf);
+
+    // The first match in the depth-first order is returned, not the most recent one
+    Object *first = clones.front();
+    Object *firstLeaf = ObjectSystem::findObject(leaf->uuid(), first);
+    clones.back()->setParent(first);
+    QCOMPARE(ObjectSystem::findObject(leaf->uuid(), first), firstLeaf);
+    clones.pop_back();
+
+    for(auto it : clones) {
+        delete it;
+    }
+    delete root;
+}
+
+void Benchmark_Load_Map_data() {
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("5k") << 5000;
+    QTest::newRow("50k") << 50000;
+}
+
+void Benchmark_Load_Map() {
+    QFETCH(int, count);
+
+    ObjectSystem objectSystem;
+    TestObject::registerClassFactory(&objectSystem);
+
+    vector<Object *> objects;
+    objects.reserve(count);
+    objects.push_back(ObjectSystem::objectCreate<TestObject>("Map"));
+    for(int i = 1; i < count; i++) {
+        objects.push_back(ObjectSystem::objectCreate<TestObject>("", objects[(i - 1) / 8]));
+    }
+    Variant map = ObjectSystem::toVariant(objects.front());
+    delete objects.front();
+
+    QBENCHMARK {
+        Object *result = ObjectSystem::toObject(map);
+        QCOMPARE((result != nullptr), true);
+        delete result;
+    }
+}
+
+void Benchmark_Load_Map_Bson_data() {
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("5k") << 5000;
+    QTest::newRow("50k") << 50000;
+}
+
+void Benchmark_Load_Map_Bson() {
+    QFETCH(int, count);
+
+    ObjectSystem objectSystem;
+    TestObject::registerClassFactory(&objectSystem);
+
+    vector<Object *> objects;
+    objects.reserve(count);
+    objects.push_back(ObjectSystem::objectCreate<TestObject>("Map"));
+    for(int i = 1; i < count; i++) {
+        objects.push_back(ObjectSystem::objectCreate<TestObject>("", objects[(i - 1) / 8]));
+    }
+    ByteBuffer map(Bson::save(ObjectSystem::toVariant(objects.front())));
+    delete objects.front();
+
+    QBENCHMARK {
+        Object *result = ObjectSystem::toObject(BsonReader(map));
+        QCOMPARE((result != nullptr), true);
+        delete result;
+    }
+}
+
+void Benchmark_Load_Map_Pack_data() {
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("5k") << 5000;
+    QTest::newRow("50k") << 50000;
+}
+
+void Benchmark_Load_Map_Pack() {
+    QFETCH(int, count);
+
+    ObjectSystem objectSystem;
+    TestObject::registerClassFactory(&objectSystem);
+
+    vector<Object *> objects;
+    objects.reserve(count);
+    objects.push_back(ObjectSystem::objectCreate<TestObject>("Map"));
+    for(int i = 1; i < count; i++) {
+        objects.push_back(ObjectSystem::objectCreate<TestObject>("", objects[(i - 1) / 8]));
+    }
+    ByteBuffer map(ObjectPack::save(ObjectSystem::toVariant(objects.front())));
+    delete objects.front();
+
+    QBENCHMARK {
+        Object *result = ObjectSystem::toObject(ObjectPack(map));
+        QCOMPARE((result != nullptr), true);
+        delete result;
+    }
+}
+
+void Benchmark_Process_Events_data() {
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("10k") << 10000;
+    QTest::newRow("100k") << 100000;
+    QTest::newRow("1M") << 1000000;
+}
+
+void Benchmark_Process_Events() {
+    QFETCH(int, count);
+
+    ObjectSystem objectSystem;
+    EventObject::registerClassFactory(&objectSystem);
+
+    vector<EventObject *> objects;
+    objects.reserve(count);
+    for(int i = 0; i < count; i++) {
+        objects.push_back(ObjectSystem::objectCreate<EventObject>());
+    }
+
+    QBENCHMARK {
+        for(int i = 0; i < count; i += 1000) {
+            objects[i]->post();
+        }
+        objectSystem.processEvents();
+    }
+
+    for(auto it : objects) {
+        delete it;
+    }
+}
+
 } REGISTER(ObjectSystemTest)
 
 #include "tst_objectsystem.moc"
@@ -47,6 +47,31 @@ void Json_Serialize_Desirialize() {
     QCOMPARE(Variant(var1), Json::load(Json::save(var1, 0)));
 }
 
+void Json_Writer_Streams_Chunks() {
+    VariantList objects;
+    for(int i = 0; i < 2000; i++) {
+        objects.push_back(var1);
+    }
+    string text;
+    uint32_t chunks  = 0;
+    Json::save(objects, [&text, &chunks](const char *data, uint32_t size) {
+        text.append(data, size);
+        chunks++;
+    }, 0);
+
+    QCOMPARE((chunks > 1), true);
+    QCOMPARE(text, Json::save(objects, 0));
+    QCOMPARE(Variant(objects), Json::load(text.c_str(), text.size()));
+}
+
+void Json_Malformed_Data() {
+    string text = Json::save(var1, 0);
+    QCOMPARE(Json::load(text.substr(0, text.size() / 2)).isValid(), false);
+    QCOMPARE(Json::load("{\"key\" 1}").isValid(), false);
+    QCOMPARE(Json::load("[1, 2.5, -3, true, \"str\"]").toList().size(), static_cast<size_t>(5));
+    QCOMPARE(Json::load("{}").toMap().empty(), true);
+}
+
 void Bson_Serialize_Desirialize() {
     ByteArray bin   = {'\x00','\x01','\x02','\x03','\x04','\xFF'};
     var1["bin"]     = bin;
@@ -54,6 +79,126 @@ void Bson_Serialize_Desirialize() {
     QCOMPARE(Variant(var1), Bson::load(Bson::save(var1), MetaType::VARIANTMAP));
 }
 
+void Bson_Binary_Shares_Buffer() {
+    ByteArray bin(1024, '\x05');
+    VariantMap map;
+    map["bin"]      = bin;
+
+    ByteBuffer source(Bson::save(map));
+    VariantMap result = Bson::load(source, MetaType::VARIANTMAP).toMap();
+
+    ByteBuffer value = result["bin"].toByteBuffer();
+    QCOMPARE(value.size(), static_cast<uint32_t>(bin.size()));
+    QCOMPARE((value.begin() >= source.begin() && value.end() <= source.end()), true);
+    QCOMPARE(result["bin"].toByteArray(), bin);
+}
+
+void Bson_Reader_Iteration() {
+    ByteBuffer source(Bson::save(var1));
+
+    BsonReader reader(source, MetaType::VARIANTMAP);
+    QCOMPARE(reader.isValid(), true);
+
+    uint32_t count  = 0;
+    while(reader.next()) {
+        if(strcmp(reader.name(), "map") == 0) {
+            QCOMPARE(reader.type(), static_cast<uint32_t>(MetaType::VARIANTMAP));
+            QCOMPARE(reader.enter(), true);
+            QCOMPARE(reader.depth(), static_cast<uint32_t>(2));
+            QCOMPARE(reader.next(), true);
+            QCOMPARE(reader.name(), "bool");
+            QCOMPARE(reader.toBool(), true);
+            QCOMPARE(reader.leave(), true);
+        } else if(strcmp(reader.name(), "int") == 0) {
+            QCOMPARE(reader.toInt(), 2);
+        } else if(strcmp(reader.name(), "vec3") == 0) {
+            QCOMPARE(reader.toVariant().toVector3(), Vector3(2));
+        }
+        count++;
+    }
+    QCOMPARE(reader.isValid(), true);
+    QCOMPARE(count, static_cast<uint32_t>(var1.size()));
+
+    ByteArray broken = Bson::save(var1);
+    broken.resize(broken.size() / 2);
+    QCOMPARE(Bson::load(broken).isValid(), false);
+}
+
+void Bson_Oversized_Length() {
+    // The length of element is located after the size of document, the tag and the name
+    const uint32_t offset = sizeof(uint32_t) + 1 + 4;
+
+    VariantMap map;
+    map["bin"] = ByteArray(8, '\x05');
+    ByteArray binary = Bson::save(map);
+
+    map.clear();
+    map["str"] = string("text");
+    ByteArray text = Bson::save(map);
+
+    QCOMPARE(Bson::load(binary).isValid(), true);
+    QCOMPARE(Bson::load(text).isValid(), true);
+    // The lengths which wrap around with the header and which exceed the document by one byte
+    for(uint32_t length : {0xFFFFFFFBU, 0xFFFFFFFFU, 9U}) {
+        ByteArray broken = binary;
+        memcpy(&broken[offset], &length, sizeof(uint32_t));
+        QCOMPARE(Bson::load(broken).isValid(), false);
+
+        BsonReader reader(ByteBuffer(broken), MetaType::VARIANTMAP);
+        QCOMPARE(reader.next(), false);
+        QCOMPARE(reader.isValid(), false);
+    }
+    for(uint32_t length : {0xFFFFFFFCU, 0xFFFFFFFFU, 7U}) {
+        ByteArray broken = text;
+        memcpy(&broken[offset], &length, sizeof(uint32_t));
+        QCOMPARE(Bson::load(broken).isValid(), false);
+    }
+}
+
+void Benchmark_Bson_Load() {
+    VariantList objects;
+    for(int i = 0; i < 10000; i++) {
+        VariantList object;
+        object.push_back(Vector3(i));
+        object.push_back(Quaternion());
+        object.push_back(Matrix4());
+        object.push_back(i);
+        objects.push_back(object);
+    }
+    ByteArray bin   = Bson::save(objects);
+
+    QBENCHMARK {
+        QCOMPARE(Bson::load(bin).toList().size(), objects.size());
+    }
+}
+
+void Benchmark_Json_Load() {
+    VariantList objects;
+    for(int i = 0; i < 10000; i++) {
+        objects.push_back(var1);
+    }
+    string text = Json::save(objects, 0);
+
+    QBENCHMARK {
+        QCOMPARE(Json::load(text).toList().size(), objects.size());
+    }
+}
+
+void Benchmark_Json_Save() {
+    VariantList objects;
+    for(int i = 0; i < 10000; i++) {
+        objects.push_back(var1);
+    }
+    uint32_t size   = 0;
+
+    QBENCHMARK {
+        Json::save(objects, [&size](const char *, uint32_t length) {
+            size += length;
+        }, 0);
+    }
+    QCOMPARE((size > 0), true);
+}
+
 } REGISTER(SerializationTest)
 
 #include "tst_serialization.moc"
@@ -2,6 +2,8 @@
 
 #include "threadpool.h"
 
+#include <atomic>
+
 class ThreadObject : public Object {
 public:
     explicit ThreadObject     () :
@@ -30,6 +32,28 @@ public:
     uint32_t        m_Counter;
 };
 
+class CounterObject : public Object {
+public:
+    explicit CounterObject    (atomic<uint32_t> *counter) :
+            Object(),
+            m_pCounter(counter) {
+    }
+
+    void            post            () {
+        postEvent(new Event(Event::UserType));
+    }
+
+    bool            event           (Event *e) {
+        if(e->type() == Event::UserType) {
+            m_pCounter->fetch_add(1);
+            return true;
+        }
+        return false;
+    }
+
+    atomic<uint32_t> *m_pCounter;
+};
+
 class TreadPoolTest : public QObject {
     Q_OBJECT
 
@@ -63,6 +87,97 @@ void Multi_Task() {
     }
 }
 
+void Job_dependencies() {
+    atomic<uint32_t> step(0);
+    bool order = true;
+
+    Job first = m_pPool->createJob([&]() { step = 1; });
+    Job second = m_pPool->createJob([&]() { order &= (step == 1); step = 2; });
+    m_pPool->addDependency(second, first);
+    Job third = m_pPool->continueWith(second, [&]() { order &= (step == 2); step = 3; });
+
+    m_pPool->run(second);
+    m_pPool->run(first);
+    m_pPool->wait(third);
+
+    QCOMPARE(order, true);
+    QCOMPARE(step.load(), uint32_t(3));
+    QCOMPARE(second.isFinished(), true);
+}
+
+void Job_children() {
+    atomic<uint32_t> counter(0);
+
+    Job root = m_pPool->createJob([]() {});
+    for(int i = 0; i < 1000; i++) {
+        m_pPool->run(m_pPool->createJob([&]() { counter++; }, root));
+    }
+    m_pPool->run(root);
+    m_pPool->wait(root);
+
+    QCOMPARE(counter.load(), uint32_t(1000));
+}
+
+void Parallel_for() {
+    vector<uint32_t> data(100000, 1);
+    atomic<uint32_t> sum(0);
+
+    Job job = m_pPool->parallelFor(data.size(), 256, [&](uint32_t begin, uint32_t end) {
+        uint32_t local = 0;
+        for(uint32_t i = begin; i < end; i++) {
+            local += data[i];
+        }
+        sum += local;
+    });
+    m_pPool->wait(job);
+
+    QCOMPARE(sum.load(), uint32_t(data.size()));
+}
+
+void Benchmark_start() {
+    atomic<uint32_t> counter(0);
+    list<CounterObject *> objects;
+    for(int i = 0; i < 1000; i++) {
+        objects.push_back(new CounterObject(&counter));
+    }
+
+    QBENCHMARK {
+        for(auto it : objects) {
+            it->post();
+            m_pPool->start(*it);
+        }
+        m_pPool->waitForDone();
+    }
+
+    for(auto it : objects) {
+        delete it;
+    }
+}
+
+void Benchmark_jobs() {
+    atomic<uint32_t> counter(0);
+
+    QBENCHMARK {
+        Job root = m_pPool->createJob([]() {});
+        for(int i = 0; i < 1000; i++) {
+            m_pPool->run(m_pPool->createJob([&]() { counter++; }, root));
+        }
+        m_pPool->run(root);
+        m_pPool->wait(root);
+    }
+}
+
+void Benchmark_parallel_for() {
+    atomic<uint32_t> counter(0);
+
+    QBENCHMARK {
+        Job job = m_pPool->parallelFor(1000, 1, [&](uint32_t begin, uint32_t end) {
+            counter += end - begin;
+        });
+        m_pPool->wait(job);
+    }
+}
+
 } REGISTER(ThreadPool)
 
 #include "tst_threadpool.moc"
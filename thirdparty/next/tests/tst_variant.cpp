@@ -185,6 +185,63 @@ void Compare_Variants_Advanced() {
     }
 }
 
+void Copy_Move_Math_Variants() {
+    {
+        Variant value1  = Vector3(1.0f, 2.0f, 3.0f);
+        Variant value2  = value1;
+        reinterpret_cast<Vector3 *>(value2.data())->x = 4.0f;
+
+        QCOMPARE(value1.toVector3(), Vector3(1.0f, 2.0f, 3.0f));
+        QCOMPARE(value2.toVector3(), Vector3(4.0f, 2.0f, 3.0f));
+    }
+    {
+        Matrix4 matrix;
+        matrix.translate(Vector3(1.0f, 2.0f, 3.0f));
+
+        Variant value1  = matrix;
+        Variant value2  = std::move(value1);
+
+        QCOMPARE(value1.isValid(),  false);
+        QCOMPARE(value2.toMatrix4(), matrix);
+    }
+    {
+        VariantList list;
+        list.push_back("Test");
+        Variant value1  = list;
+        Variant value2  = value1;
+
+        value1 = Vector2(1.0f, 2.0f);
+        QCOMPARE(value1.toVector2(), Vector2(1.0f, 2.0f));
+        QCOMPARE(value2.toList().front().toString().c_str(), "Test");
+    }
+}
+
+void Benchmark_Math_Variants() {
+    Matrix4 matrix;
+    QBENCHMARK {
+        for(int i = 0; i < 100000; i++) {
+            Variant value   = Vector3(i, 0.0f, 0.0f);
+            Variant rotation= Quaternion(Vector3(0.0f, 1.0f, 0.0f), i);
+            Variant copy    = Variant(matrix);
+            matrix[12]      = value.toVector3().x + rotation.toQuaternion().w + copy.toMatrix4()[0];
+        }
+    }
+}
+
+void Benchmark_VariantList_Iteration() {
+    VariantList list;
+    for(int i = 0; i < 100000; i++) {
+        list.push_back(Vector3(i));
+    }
+    float result    = 0.0f;
+    QBENCHMARK {
+        for(auto &it : list) {
+            result += it.toVector3().x;
+        }
+    }
+    QCOMPARE((result > 0.0f), true);
+}
+
 } REGISTER(VariantTest)
 
 #include "tst_variant.moc"